@@ -1,28 +1,120 @@
 #include "GeoConstruction.h"
 
+// FCCSW
+#include "SimG4Interface/StartupProfiler.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
 #include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <unistd.h>
 
 // DD4hep
 #include "DD4hep/Detector.h"
 #include "DD4hep/Plugins.h"
+#include "DD4hep/Printout.h"
+#include "DD4hep/Volumes.h"
 #include "DDG4/Geant4Converter.h"
+#include "DDG4/Geant4UserLimits.h"
 #include "TGeoManager.h"
 
 // Geant4
+#include "G4GDMLParser.hh"
+#include "G4LogicalVolumeStore.hh"
 #include "G4PVPlacement.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4RegionStore.hh"
 #include "G4SDManager.hh"
+#include "G4SolidStore.hh"
+#include "G4UserLimits.hh"
 #include "G4VSensitiveDetector.hh"
 
+namespace {
+/// Header of the mapping file, to be changed with its layout
+const std::string cacheFormat = "GeoConstruction-cache 3";
+/// Names of the files of the cache, in the cache directory
+const std::string cacheGdmlFile = "geometry.gdml";
+const std::string cacheMapFile = "geometry.map";
+/// Type of the GDML auxiliary information tagging the logical volumes with their index in the mapping file
+const std::string cacheIndexAux = "GeoConstructionCacheIndex";
+/// Placement as the index of its mother volume (-1 for the world) and its index among the daughters
+using PlacementIndex = std::pair<int, int>;
+
+/// Index of all the volumes of the TGeo geometry
+std::unordered_map<const TGeoVolume*, int> indexTGeoVolumes(TGeoManager& manager) {
+  std::unordered_map<const TGeoVolume*, int> index;
+  const TObjArray* volumes = manager.GetListOfVolumes();
+  for (int iVolume = 0; iVolume <= volumes->GetLast(); ++iVolume) {
+    index[static_cast<const TGeoVolume*>(volumes->At(iVolume))] = iVolume;
+  }
+  return index;
+}
+
+/// Numbers of distinct solids and materials of the logical volumes
+template <typename Volumes>
+std::pair<size_t, size_t> countSolidsAndMaterials(const Volumes& aVolumes) {
+  std::unordered_set<const G4VSolid*> solids;
+  std::unordered_set<const G4Material*> materials;
+  for (const G4LogicalVolume* volume : aVolumes) {
+    solids.insert(volume->GetSolid());
+    materials.insert(volume->GetMaterial());
+  }
+  return {solids.size(), materials.size()};
+}
+
+/// Number of logical volumes with user limits
+template <typename Volumes>
+size_t countUserLimits(const Volumes& aVolumes) {
+  return std::count_if(aVolumes.begin(), aVolumes.end(),
+                       [](const G4LogicalVolume* aVolume) { return aVolume->GetUserLimits() != nullptr; });
+}
+
+/// Limit set of the DD4hep volume (invalid if none)
+dd4hep::LimitSet limitSet(const TGeoVolume* aVolume) {
+  return dd4hep::Volume(const_cast<TGeoVolume*>(aVolume)).limitSet();
+}
+
+/// Delete the objects added to a Geant4 store after its first aSize entries
+template <typename Store>
+void deleteAddedObjects(Store& aStore, size_t aSize) {
+  std::vector<typename Store::value_type> added(aStore.begin() + std::min(aSize, aStore.size()), aStore.end());
+  for (auto* object : added) {
+    delete object;
+  }
+}
+
+/// Check that the GDML file is complete, i.e. that it ends with the closing tag
+bool isCompleteGdml(const std::string& aFileName) {
+  std::ifstream in(aFileName, std::ios::binary | std::ios::ate);
+  const std::string closingTag = "</gdml>";
+  const std::streamoff size = in ? static_cast<std::streamoff>(in.tellg()) : 0;
+  const std::streamoff tailSize = std::min<std::streamoff>(size, 64);
+  if (tailSize < static_cast<std::streamoff>(closingTag.size())) {
+    return false;
+  }
+  std::string tail(tailSize, '\0');
+  in.seekg(size - tailSize);
+  in.read(&tail[0], tailSize);
+  return in && tail.find(closingTag) != std::string::npos;
+}
+} // namespace
+
 namespace det {
 
-GeoConstruction::GeoConstruction(dd4hep::Detector& detector, std::map<std::string, std::string> sensitive_types)
-    : m_detector(detector), m_sensitive_types(sensitive_types) {}
+GeoConstruction::GeoConstruction(dd4hep::Detector& detector, std::map<std::string, std::string> sensitive_types,
+                                 const std::string& cacheName)
+    : m_detector(detector), m_sensitive_types(sensitive_types), m_cacheName(cacheName) {}
 
 GeoConstruction::~GeoConstruction() {}
 
 // method borrowed from dd4hep::sim::Geant4DetectorSensitivesConstruction
 //                             ::constructSensitives(Geant4DetectorConstructionContext* ctxt)
 void GeoConstruction::ConstructSDandField() {
+  sim::StartupProfiler::Phase phase("GeoConstruction", "constructSensitiveDetectors");
   typedef std::set<const TGeoVolume*> VolSet;
   typedef std::map<dd4hep::SensitiveDetector, VolSet> _SV;
   dd4hep::sim::Geant4GeometryInfo* p = dd4hep::sim::Geant4Mapping::instance().ptr();
@@ -71,17 +163,327 @@ void GeoConstruction::ConstructSDandField() {
 // method borrowed from dd4hep::sim::Geant4DetectorConstruction::Construct()
 G4VPhysicalVolume* GeoConstruction::Construct() {
   dd4hep::sim::Geant4Mapping& g4map = dd4hep::sim::Geant4Mapping::instance();
-  dd4hep::DetElement world = m_detector.world();
-  dd4hep::sim::Geant4Converter conv(m_detector, dd4hep::DEBUG);
-  dd4hep::sim::Geant4GeometryInfo* geo_info = conv.create(world).detach();
+  dd4hep::sim::Geant4GeometryInfo* geo_info = nullptr;
+  if (!m_cacheName.empty()) {
+    sim::StartupProfiler::Phase phase("GeoConstruction", "readGeometryCache");
+    geo_info = readCache();
+  }
+  bool fromCache = (geo_info != nullptr);
+  if (!fromCache) {
+    sim::StartupProfiler::Phase conversionPhase("GeoConstruction", "convertGeometry");
+    dd4hep::DetElement world = m_detector.world();
+    dd4hep::sim::Geant4Converter conv(m_detector, dd4hep::DEBUG);
+    geo_info = conv.create(world).detach();
+  }
   g4map.attach(geo_info);
+  dd4hep::printout(dd4hep::INFO, "GeoConstruction", "Geant4 geometry has %zu logical volumes with user limits",
+                   countUserLimits(*G4LogicalVolumeStore::GetInstance()));
   // All volumes are deleted in ~G4PhysicalVolumeStore()
   G4VPhysicalVolume* m_world = geo_info->world();
   if (not m_detector.volumeManager().isValid()) {
     m_detector.apply("DD4hepVolumeManager", 0, 0);
   }
   // Create Geant4 volume manager
-  g4map.volumeManager();
+  {
+    sim::StartupProfiler::Phase phase("GeoConstruction", "volumeManager");
+    g4map.volumeManager();
+  }
+  if (!fromCache && !m_cacheName.empty()) {
+    sim::StartupProfiler::Phase phase("GeoConstruction", "writeGeometryCache");
+    if (writeCache(*geo_info)) {
+      dd4hep::printout(dd4hep::INFO, "GeoConstruction", "Geant4 geometry written to the cache %s",
+                       m_cacheName.c_str());
+    } else {
+      dd4hep::printout(dd4hep::WARNING, "GeoConstruction", "Geant4 geometry could not be written to the cache %s",
+                       m_cacheName.c_str());
+    }
+  }
   return m_world;
 }
+
+bool GeoConstruction::writeCache(const dd4hep::sim::Geant4GeometryInfo& info) const {
+  // index all the volumes and placements of both geometries
+  TGeoManager& manager = m_detector.manager();
+  auto tgeoVolumes = indexTGeoVolumes(manager);
+  std::unordered_map<const TGeoNode*, PlacementIndex> tgeoPlacements;
+  tgeoPlacements[manager.GetTopNode()] = {-1, 0};
+  for (const auto& [volume, iVolume] : tgeoVolumes) {
+    for (int iNode = 0; iNode < volume->GetNdaughters(); ++iNode) {
+      tgeoPlacements[volume->GetNode(iNode)] = {iVolume, iNode};
+    }
+  }
+  G4GDMLParser parser;
+  const G4LogicalVolumeStore* g4Volumes = G4LogicalVolumeStore::GetInstance();
+  std::unordered_map<const G4LogicalVolume*, int> g4VolumeIndex;
+  std::unordered_map<const G4VPhysicalVolume*, PlacementIndex> g4Placements;
+  g4Placements[info.world()] = {-1, 0};
+  for (size_t iVolume = 0; iVolume < g4Volumes->size(); ++iVolume) {
+    G4LogicalVolume* volume = (*g4Volumes)[iVolume];
+    g4VolumeIndex[volume] = iVolume;
+    // the tag is read back with the volume, whatever its name becomes
+    G4GDMLAuxStructType aux{cacheIndexAux, std::to_string(iVolume), "", nullptr};
+    parser.AddVolumeAuxiliary(aux, volume);
+    for (size_t iDaughter = 0; iDaughter < volume->GetNoDaughters(); ++iDaughter) {
+      g4Placements[volume->GetDaughter(iDaughter)] = {static_cast<int>(iVolume), static_cast<int>(iDaughter)};
+    }
+  }
+
+  // the files are written in a temporary directory renamed at the end, so that concurrent jobs never read a partial
+  // cache, nor the files of two different jobs
+  namespace fs = std::filesystem;
+  const fs::path tmpDir = m_cacheName + ".tmp" + std::to_string(::getpid());
+  std::error_code fsError;
+  try {
+    const auto [numSolids, numMaterials] = countSolidsAndMaterials(*g4Volumes);
+    // GDML does not store the user limits of the volumes, they are restored from the DD4hep limit sets
+    const size_t numLimits = countUserLimits(*g4Volumes);
+    std::unordered_set<const G4LogicalVolume*> limitSetVolumes;
+    for (const auto& [volume, g4Volume] : info.g4Volumes) {
+      if (limitSet(volume).isValid()) {
+        limitSetVolumes.insert(g4Volume);
+      }
+    }
+    if (limitSetVolumes.size() != numLimits) {
+      throw std::runtime_error(std::to_string(numLimits - std::min(numLimits, limitSetVolumes.size())) +
+                               " volumes have user limits which are not set from DD4hep limit sets");
+    }
+    size_t numSensitives = 0;
+    for (const auto& [sd, volumes] : info.sensitives) {
+      numSensitives += volumes.size();
+    }
+    std::ostringstream map;
+    map << cacheFormat << "\n";
+    map << "volumes " << tgeoVolumes.size() << " solids " << numSolids << " materials " << numMaterials
+        << " sensitives " << numSensitives << " limits " << numLimits << "\n";
+    for (const auto& [volume, g4Volume] : info.g4Volumes) {
+      map << "volume " << tgeoVolumes.at(volume) << " " << g4VolumeIndex.at(g4Volume) << "\n";
+    }
+    for (const auto& [node, g4Placement] : info.g4Placements) {
+      const auto& tgeoIndex = tgeoPlacements.at(node);
+      const auto& g4Index = g4Placements.at(g4Placement);
+      map << "placement " << tgeoIndex.first << " " << tgeoIndex.second << " " << g4Index.first << " "
+          << g4Index.second << "\n";
+    }
+    for (const auto& [sd, volumes] : info.sensitives) {
+      for (const auto* volume : volumes) {
+        map << "sensitive " << tgeoVolumes.at(volume) << " " << sd.name() << "\n";
+      }
+    }
+    for (const auto& [path, volumeID] : info.g4Paths) {
+      map << "path " << volumeID << " " << path.size();
+      for (const auto* placement : path) {
+        const auto& g4Index = g4Placements.at(placement);
+        map << " " << g4Index.first << " " << g4Index.second;
+      }
+      map << "\n";
+    }
+    fs::remove_all(tmpDir, fsError);
+    fs::create_directories(tmpDir);
+    // regions and their cuts and limits are written as auxiliary information
+    parser.SetRegionExport(true);
+    parser.Write((tmpDir / cacheGdmlFile).string(), info.world(), true);
+    std::ofstream out(tmpDir / cacheMapFile);
+    out << map.str();
+    out.close();
+    if (!out) {
+      throw std::runtime_error("Cannot write " + (tmpDir / cacheMapFile).string());
+    }
+  } catch (const std::exception& e) {
+    dd4hep::printout(dd4hep::WARNING, "GeoConstruction", "Cache not written: %s", e.what());
+    fs::remove_all(tmpDir, fsError);
+    return false;
+  }
+  // an invalid cache found by readCache is replaced
+  if (m_invalidCache) {
+    fs::remove_all(m_cacheName, fsError);
+  }
+  fs::rename(tmpDir, m_cacheName, fsError);
+  if (fsError) {
+    fs::remove_all(tmpDir, fsError);
+    // another job may have written the same cache in the meantime
+    return fs::exists(fs::path(m_cacheName) / cacheMapFile, fsError);
+  }
+  return true;
+}
+
+dd4hep::sim::Geant4GeometryInfo* GeoConstruction::readCache() const {
+  namespace fs = std::filesystem;
+  const std::string gdmlFile = (fs::path(m_cacheName) / cacheGdmlFile).string();
+  std::ifstream in(fs::path(m_cacheName) / cacheMapFile);
+  if (!in) {
+    dd4hep::printout(dd4hep::INFO, "GeoConstruction", "No cached Geant4 geometry %s, converting the geometry",
+                     m_cacheName.c_str());
+    return nullptr;
+  }
+  // an unusable cache is replaced by the converted geometry
+  auto invalidCache = [this](const std::string& aReason) -> dd4hep::sim::Geant4GeometryInfo* {
+    dd4hep::printout(dd4hep::WARNING, "GeoConstruction", "Cached Geant4 geometry %s %s, converting the geometry",
+                     m_cacheName.c_str(), aReason.c_str());
+    m_invalidCache = true;
+    return nullptr;
+  };
+  TGeoManager& manager = m_detector.manager();
+  const TObjArray* tgeoVolumes = manager.GetListOfVolumes();
+  std::string line;
+  std::getline(in, line);
+  std::string volumesKey, solidsKey, materialsKey, sensitivesKey, limitsKey;
+  size_t numTGeoVolumes = 0, numSolids = 0, numMaterials = 0, numSensitives = 0, numLimits = 0;
+  in >> volumesKey >> numTGeoVolumes >> solidsKey >> numSolids >> materialsKey >> numMaterials >> sensitivesKey >>
+      numSensitives >> limitsKey >> numLimits;
+  if (line != cacheFormat || !in || volumesKey != "volumes" || solidsKey != "solids" ||
+      materialsKey != "materials" || sensitivesKey != "sensitives" || limitsKey != "limits" ||
+      numTGeoVolumes != static_cast<size_t>(tgeoVolumes->GetLast() + 1)) {
+    return invalidCache("does not match the geometry");
+  }
+  // all the records are read before the geometry, a corrupted cache is then detected before creating volumes
+  struct Record {
+    std::string type;
+    std::vector<long long> indices;
+    std::string name;
+    dd4hep::VolumeID volumeID = 0;
+  };
+  std::vector<Record> records;
+  size_t numSensitiveRecords = 0;
+  while (std::getline(in, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    std::istringstream fields(line);
+    Record record;
+    fields >> record.type;
+    size_t numIndices = (record.type == "volume") ? 2 : (record.type == "placement") ? 4 : 1;
+    if (record.type == "path") {
+      size_t depth = 0;
+      fields >> record.volumeID >> depth;
+      numIndices = 2 * depth;
+    }
+    for (size_t iIndex = 0; iIndex < numIndices; ++iIndex) {
+      long long index = 0;
+      fields >> index;
+      record.indices.push_back(index);
+    }
+    if (record.type == "sensitive") {
+      fields >> record.name;
+      if (!fields.fail() && !m_detector.sensitiveDetector(record.name).isValid()) {
+        return invalidCache("refers to the unknown sensitive detector " + record.name);
+      }
+      ++numSensitiveRecords;
+    }
+    if (fields.fail() || (record.type != "volume" && record.type != "placement" && record.type != "sensitive" &&
+                          record.type != "path")) {
+      return invalidCache("is corrupted");
+    }
+    records.push_back(std::move(record));
+  }
+  if (numSensitiveRecords != numSensitives) {
+    return invalidCache("has " + std::to_string(numSensitiveRecords) + " sensitive volumes instead of " +
+                        std::to_string(numSensitives));
+  }
+  if (!isCompleteGdml(gdmlFile)) {
+    return invalidCache("has an incomplete GDML file");
+  }
+
+  // the objects created from an unusable GDML file are deleted before the geometry is converted
+  auto& regionStore = *G4RegionStore::GetInstance();
+  auto& physicalStore = *G4PhysicalVolumeStore::GetInstance();
+  auto& logicalStore = *G4LogicalVolumeStore::GetInstance();
+  auto& solidStore = *G4SolidStore::GetInstance();
+  const size_t numRegions = regionStore.size(), numPhysical = physicalStore.size(),
+               numLogical = logicalStore.size(), numStoredSolids = solidStore.size();
+  try {
+    G4GDMLParser parser;
+    parser.Read(gdmlFile, false);
+    G4VPhysicalVolume* world = parser.GetWorldVolume();
+    if (world == nullptr) {
+      throw std::runtime_error("no world volume");
+    }
+    std::unordered_map<long long, G4LogicalVolume*> g4Volumes;
+    for (const auto& [volume, auxList] : *parser.GetAuxMap()) {
+      for (const auto& aux : auxList) {
+        if (aux.type == cacheIndexAux) {
+          g4Volumes[std::stoll(aux.value)] = volume;
+        }
+      }
+    }
+    std::vector<const G4LogicalVolume*> readVolumes;
+    for (const auto& [index, volume] : g4Volumes) {
+      readVolumes.push_back(volume);
+    }
+    const auto [numReadSolids, numReadMaterials] = countSolidsAndMaterials(readVolumes);
+    if (numReadSolids != numSolids || numReadMaterials != numMaterials) {
+      throw std::runtime_error(std::to_string(numReadSolids) + " solids and " + std::to_string(numReadMaterials) +
+                               " materials instead of " + std::to_string(numSolids) + " and " +
+                               std::to_string(numMaterials));
+    }
+    auto g4Volume = [&](long long aIndex) {
+      auto volume = g4Volumes.find(aIndex);
+      if (volume == g4Volumes.end()) {
+        throw std::runtime_error("volume #" + std::to_string(aIndex) + " missing");
+      }
+      return volume->second;
+    };
+    auto g4Placement = [&](long long aMother, long long aDaughter) -> G4VPhysicalVolume* {
+      if (aMother < 0) {
+        return world;
+      }
+      G4LogicalVolume* mother = g4Volume(aMother);
+      if (aDaughter < 0 || aDaughter >= static_cast<long long>(mother->GetNoDaughters())) {
+        throw std::runtime_error("placement missing");
+      }
+      return mother->GetDaughter(aDaughter);
+    };
+    auto tgeoVolume = [&](long long aIndex) {
+      if (aIndex < 0 || aIndex > tgeoVolumes->GetLast()) {
+        throw std::runtime_error("TGeo volume #" + std::to_string(aIndex) + " missing");
+      }
+      return static_cast<const TGeoVolume*>(tgeoVolumes->At(aIndex));
+    };
+
+    auto info = std::make_unique<dd4hep::sim::Geant4GeometryInfo>();
+    for (const auto& record : records) {
+      const auto& idx = record.indices;
+      if (record.type == "volume") {
+        info->g4Volumes[tgeoVolume(idx[0])] = g4Volume(idx[1]);
+      } else if (record.type == "placement") {
+        const TGeoNode* node = (idx[0] < 0) ? manager.GetTopNode() : tgeoVolume(idx[0])->GetNode(idx[1]);
+        info->g4Placements[node] = g4Placement(idx[2], idx[3]);
+      } else if (record.type == "sensitive") {
+        info->sensitives[m_detector.sensitiveDetector(record.name)].insert(tgeoVolume(idx[0]));
+      } else if (record.type == "path") {
+        dd4hep::sim::Geant4PlacementPath path;
+        for (size_t iIndex = 0; iIndex + 1 < idx.size(); iIndex += 2) {
+          path.push_back(g4Placement(idx[iIndex], idx[iIndex + 1]));
+        }
+        info->g4Paths[path] = record.volumeID;
+      }
+    }
+    // the user limits of the volumes are not stored in GDML, they are created from the DD4hep limit sets
+    for (const auto& [volume, g4Volume] : info->g4Volumes) {
+      dd4hep::LimitSet limits = limitSet(volume);
+      if (limits.isValid()) {
+        G4UserLimits*& g4Limits = info->g4Limits[limits];
+        if (g4Limits == nullptr) {
+          g4Limits = new dd4hep::sim::Geant4UserLimits(limits);
+        }
+        g4Volume->SetUserLimits(g4Limits);
+      }
+    }
+    if (countUserLimits(readVolumes) != numLimits) {
+      throw std::runtime_error(std::to_string(countUserLimits(readVolumes)) + " volumes with user limits instead of " +
+                               std::to_string(numLimits));
+    }
+    info->m_world = world;
+    // the placement paths are already known, the volume manager does not need to scan the geometry
+    info->has_volmgr = true;
+    info->valid = true;
+    dd4hep::printout(dd4hep::INFO, "GeoConstruction", "Geant4 geometry read from the cache %s", m_cacheName.c_str());
+    return info.release();
+  } catch (const std::exception& e) {
+    deleteAddedObjects(regionStore, numRegions);
+    deleteAddedObjects(physicalStore, numPhysical);
+    deleteAddedObjects(logicalStore, numLogical);
+    deleteAddedObjects(solidStore, numStoredSolids);
+    return invalidCache(std::string("cannot be read: ") + e.what());
+  }
+}
 } // namespace det
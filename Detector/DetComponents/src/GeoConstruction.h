@@ -15,6 +15,16 @@ class Detector;
  *  Class to create Geant4 detector geometry from TGeo representation
  *  On demand (ie. when calling "Construct") the DD4hep geometry is converted
  *  to Geant4 with all volumes, assemblies, shapes, materials etc.
+ *  If a cache name is given, the converted geometry is written to the directory '<cache name>': the geometry to
+ *  'geometry.gdml', and the mapping between the DD4hep and Geant4 volumes, placements and placement paths
+ *  (volume IDs), together with the sensitive detectors of the volumes, to 'geometry.map'. The directory is written
+ *  under a temporary name and renamed once complete. If it exists, it is read instead of converting the geometry.
+ *  The cache name must identify the geometry (e.g. a hash of the compact files and of the plugin libraries). The
+ *  cache is only checked against the numbers of volumes, solids, materials, sensitive volumes and volumes with user
+ *  limits, and the names of the sensitive detectors. A cache failing these checks, or whose files cannot be read, is
+ *  replaced by the converted geometry.
+ *  GDML does not store the user limits of the volumes: they are created again from the DD4hep limit sets of the
+ *  volumes when the cache is read, and the cache is not written if a volume has user limits from another source.
  *
  *  @author Markus Frank
  *  @author Anna Zaborowska
@@ -24,19 +34,31 @@ namespace det {
 class GeoConstruction : public G4VUserDetectorConstruction {
 public:
   /// Constructor
-  GeoConstruction(dd4hep::Detector& detector, std::map<std::string, std::string> sensitive_types);
+  GeoConstruction(dd4hep::Detector& detector, std::map<std::string, std::string> sensitive_types,
+                  const std::string& cacheName = "");
   /// Default destructor
   virtual ~GeoConstruction();
-  /// Geometry construction callback: Invoke the conversion to Geant4
+  /// Geometry construction callback: Invoke the conversion to Geant4 or read it from the cache
   /// All volumes (including world) are deleted in ~G4PhysicalVolumeStore()
   virtual G4VPhysicalVolume* Construct() final;
   /// Construct SD
   virtual void ConstructSDandField() final;
 
 private:
+  /// Read the converted geometry and its mapping from the cache
+  /// @return the geometry information, nullptr if the cache does not exist, does not match the geometry or cannot
+  ///         be read
+  dd4hep::sim::Geant4GeometryInfo* readCache() const;
+  /// Write the converted geometry and its mapping to the cache, the placement paths need to be filled
+  /// @return false if the cache could not be written
+  bool writeCache(const dd4hep::sim::Geant4GeometryInfo& info) const;
   /// Reference to geometry object
   dd4hep::Detector& m_detector;
   std::map<std::string, std::string> m_sensitive_types;
+  /// Path of the cache directory (empty if the cache is not used)
+  std::string m_cacheName;
+  /// Flag set if the cache exists but cannot be used, it is then replaced
+  mutable bool m_invalidCache = false;
 };
 } // namespace det
 #endif /* DETDESSERVICES_GEOCONSTRUCTION_H */
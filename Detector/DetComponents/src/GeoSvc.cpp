@@ -1,6 +1,8 @@
 #include "GeoSvc.h"
 #include "GeoConstruction.h"
 
+#include "SimG4Interface/StartupProfiler.h"
+
 #include <GaudiKernel/IMessageSvc.h>
 #include <GaudiKernel/Service.h>
 
@@ -8,6 +10,42 @@
 
 #include <DD4hep/Detector.h>
 #include <DD4hep/Printout.h>
+#include <DD4hep/Version.h>
+
+#include <G4Version.hh>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <link.h>
+#include <regex>
+#include <set>
+#include <sstream>
+
+namespace {
+/// Add the bytes to the 64-bit FNV-1a hash
+void hashBytes(uint64_t& hash, const std::string& bytes) {
+  for (unsigned char byte : bytes) {
+    hash ^= byte;
+    hash *= 1099511628211ULL;
+  }
+}
+
+/// Replace the ${VARIABLE} references by the values of the environment variables
+std::string expandEnvironment(std::string text) {
+  static const std::regex variable(R"(\$\{([^}]+)\})");
+  std::smatch match;
+  while (std::regex_search(text, match, variable)) {
+    const char* value = std::getenv(match[1].str().c_str());
+    text.replace(match.position(0), match.length(0), value ? value : "");
+  }
+  return text;
+}
+} // namespace
 
 GeoSvc::GeoSvc(const std::string& name, ISvcLocator* svc) : base_class(name, svc) {}
 
@@ -28,6 +66,7 @@ StatusCode GeoSvc::initialize() {
 
   // Build DD4hep Geometry
   {
+    sim::StartupProfiler::Phase phase("GeoSvc", "buildDD4HepGeo");
     StatusCode sc = buildDD4HepGeo();
     if (sc.isFailure()) {
       error() << "Could not build DD4hep geometry!" << endmsg;
@@ -39,6 +78,8 @@ StatusCode GeoSvc::initialize() {
 
   // Build Geant4 Geometry
   if (m_buildGeant4Geo) {
+    // the conversion itself is done when Geant4 constructs the geometry (GeoConstruction::Construct)
+    sim::StartupProfiler::Phase phase("GeoSvc", "buildGeant4Geo");
     StatusCode sc = buildGeant4Geo();
     if (sc.isFailure()) {
       error() << "Could not build Geant4 geometry!" << endmsg;
@@ -48,6 +89,7 @@ StatusCode GeoSvc::initialize() {
   } else {
     debug() << "Conversion to Geant4 Geometry is disabled" << endmsg;
   }
+  debug() << "Startup profile: " << sim::StartupProfiler::instance().json("GeoSvc") << endmsg;
 
   return StatusCode::SUCCESS;
 }
@@ -83,7 +125,19 @@ StatusCode GeoSvc::buildGeant4Geo() {
   if (!m_buildGeant4Geo) {
     return StatusCode::SUCCESS;
   }
-  m_geant4geo = std::make_shared<det::GeoConstruction>(*m_dd4hepgeo, m_sensitive_types);
+  std::string cacheName;
+  if (!m_geometryCacheDir.value().empty()) {
+    std::error_code dirError;
+    std::filesystem::create_directories(m_geometryCacheDir.value(), dirError);
+    if (dirError) {
+      warning() << "Cannot create the geometry cache directory " << m_geometryCacheDir << ": " << dirError.message()
+                << ", the geometry is not cached" << endmsg;
+    } else {
+      cacheName = m_geometryCacheDir.value() + "/geant4geo_" + geometryCacheKey();
+      info() << "Geant4 geometry cache: " << cacheName << endmsg;
+    }
+  }
+  m_geant4geo = std::make_shared<det::GeoConstruction>(*m_dd4hepgeo, m_sensitive_types, cacheName);
   if (m_geant4geo) {
     return StatusCode::SUCCESS;
   }
@@ -91,6 +145,76 @@ StatusCode GeoSvc::buildGeant4Geo() {
   return StatusCode::FAILURE;
 }
 
+std::string GeoSvc::geometryCacheKey() {
+  uint64_t hash = 14695981039346656037ULL;
+  hashBytes(hash, "G4VERSION " + std::to_string(G4VERSION_NUMBER) + ";");
+  hashBytes(hash, "DD4HEP " + std::to_string(DD4HEP_MAJOR_VERSION) + "." + std::to_string(DD4HEP_MINOR_VERSION) + "." +
+                      std::to_string(DD4HEP_PATCH_VERSION) + ";");
+  // the detector constructors and the converter are identified by the loaded libraries they come from
+  std::vector<std::string> libraries;
+  dl_iterate_phdr(
+      [](dl_phdr_info* aInfo, size_t, void* aLibraries) {
+        if (aInfo->dlpi_name != nullptr && aInfo->dlpi_name[0] != '\0') {
+          static_cast<std::vector<std::string>*>(aLibraries)->emplace_back(aInfo->dlpi_name);
+        }
+        return 0;
+      },
+      &libraries);
+  std::sort(libraries.begin(), libraries.end());
+  for (const auto& library : libraries) {
+    const std::string name = std::filesystem::path(library).filename().string();
+    if (std::none_of(m_geometryCacheLibraries.value().begin(), m_geometryCacheLibraries.value().end(),
+                     [&name](const std::string& aPattern) { return name.find(aPattern) != std::string::npos; })) {
+      continue;
+    }
+    std::error_code fileError;
+    const auto size = std::filesystem::file_size(library, fileError);
+    const auto time = std::filesystem::last_write_time(library, fileError);
+    if (fileError) {
+      debug() << "Geometry cache key: library " << library << " cannot be read, only its name is hashed" << endmsg;
+      hashBytes(hash, "LIBRARY " + library + ";");
+      continue;
+    }
+    hashBytes(hash, "LIBRARY " + library + " " + std::to_string(size) + " " +
+                        std::to_string(time.time_since_epoch().count()) + ";");
+  }
+  for (const auto& [type, sdType] : m_sensitive_types.value()) {
+    hashBytes(hash, "SD " + type + "=" + sdType + ";");
+  }
+  // the files included by the compact files (detectors, materials, ...) are hashed as well
+  static const std::regex include(R"re(<\s*(?:include|gdmlFile|file)\s[^>]*ref\s*=\s*"([^"]+)")re");
+  std::set<std::filesystem::path> hashedFiles;
+  std::function<void(const std::filesystem::path&)> hashFile = [&](const std::filesystem::path& file) {
+    std::error_code pathError;
+    auto canonical = std::filesystem::weakly_canonical(file, pathError);
+    if (!hashedFiles.insert(pathError ? file : canonical).second) {
+      return;
+    }
+    std::ifstream in(file, std::ios::binary);
+    if (!in) {
+      debug() << "Geometry cache key: file " << file << " cannot be read, only its name is hashed" << endmsg;
+      hashBytes(hash, "MISSING " + file.string() + ";");
+      return;
+    }
+    std::ostringstream content;
+    content << in.rdbuf();
+    const std::string text = content.str();
+    hashBytes(hash, "FILE " + file.string() + ";");
+    hashBytes(hash, text);
+    for (std::sregex_iterator it(text.begin(), text.end(), include), end; it != end; ++it) {
+      std::filesystem::path ref = expandEnvironment((*it)[1].str());
+      hashFile(ref.is_absolute() ? ref : file.parent_path() / ref);
+    }
+  };
+  for (const auto& filename : m_xmlFileNames) {
+    // compact files may be given with the file: prefix
+    hashFile(expandEnvironment(filename.compare(0, 5, "file:") == 0 ? filename.substr(5) : filename));
+  }
+  std::ostringstream key;
+  key << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return key.str();
+}
+
 G4VUserDetectorConstruction* GeoSvc::getGeant4Geo() { return m_geant4geo.get(); }
 
 std::string GeoSvc::constantAsString(const std::string& name) { return m_dd4hepgeo->constantAsString(name); }
@@ -31,6 +31,9 @@ public:
   virtual G4VUserDetectorConstruction* getGeant4Geo() override;
 
 private:
+  // Key of the geometry cache: hash of the compact files (with the files they include), of the SD types, of the
+  // Geant4 and DD4hep versions and of the paths, sizes and modification times of the geometry libraries
+  std::string geometryCacheKey();
   // Pointer to the interface to the DD4hep geometry
   dd4hep::Detector* m_dd4hepgeo{nullptr};
   // Pointer to the detector construction of DDG4
@@ -41,6 +44,14 @@ private:
       this, "sensitiveTypes", {{"tracker", "SimpleTrackerSD"}, {"calorimeter", "SimpleCalorimeterSD"}}};
   Gaudi::Property<bool> m_buildGeant4Geo{this, "EnableGeant4Geo", true,
                                          "If True the DD4hep geometry is converted for Geant4 Simulations"};
+  Gaudi::Property<std::string> m_geometryCacheDir{
+      this, "geometryCacheDir", "",
+      "Directory where the converted Geant4 geometry is cached between jobs (no cache if empty)"};
+  Gaudi::Property<std::vector<std::string>> m_geometryCacheLibraries{
+      this,
+      "geometryCacheLibraries",
+      {"DDCore", "DDG4", "DDDetectors", "k4geo"},
+      "Loaded libraries whose file name contains one of these strings are part of the geometry cache key"};
 };
 
 #endif // K4SIMGEANT4_GEOSVC_H
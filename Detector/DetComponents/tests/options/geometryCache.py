@@ -0,0 +1,36 @@
+# Initialisation of the Geant4 geometry of ALLEGRO with the geometry cache.
+# The first job converts the geometry and writes the cache, the second one reads it. The calorimeter sensitive
+# detector type can be changed with the environment variable GEOCACHE_SD, which changes the cache key.
+
+import os
+from Gaudi.Configuration import INFO
+
+from Configurables import ApplicationMgr
+ApplicationMgr().EvtSel = 'NONE'
+ApplicationMgr().EvtMax = 0
+ApplicationMgr().OutputLevel = INFO
+ApplicationMgr().ExtSvc += ['RndmGenSvc']
+
+# Detector geometry
+from Configurables import GeoSvc
+geoservice = GeoSvc("GeoSvc")
+path_to_detectors = os.environ.get("K4GEO", "")
+detectors_to_use = [
+    'FCCee/ALLEGRO/compact/ALLEGRO_o1_v03/ALLEGRO_o1_v03.xml',
+]
+geoservice.detectors = [os.path.join(path_to_detectors, det)
+                        for det in detectors_to_use]
+geoservice.sensitiveTypes = {"tracker": "SimpleTrackerSD",
+                             "calorimeter": os.environ.get("GEOCACHE_SD", "SimpleCalorimeterSD")}
+geoservice.geometryCacheDir = "geometryCache"
+geoservice.OutputLevel = INFO
+ApplicationMgr().ExtSvc += [geoservice]
+
+# Geant4 service, the geometry is constructed at its initialisation
+from Configurables import SimG4Svc
+geantservice = SimG4Svc("SimG4Svc")
+geantservice.detector = "SimG4DD4hepDetector"
+geantservice.physicslist = "SimG4FtfpBert"
+geantservice.actions = "SimG4FullSimActions"
+geantservice.OutputLevel = INFO
+ApplicationMgr().ExtSvc += [geantservice]
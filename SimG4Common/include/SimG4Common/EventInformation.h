@@ -3,8 +3,9 @@
 
 #include "G4VUserEventInformation.hh"
 
+#include <cstdint>
 #include <iostream>
-#include <map>
+#include <vector>
 
 class G4Track;
 namespace edm4hep {
@@ -15,7 +16,15 @@ class MCParticleCollection;
  *
  * Additional event information.
  *
- * Currently holds the particle history in form of edm particles and vertices
+ * Currently holds the particle history in form of edm particles and vertices.
+ * A compact record of every track of the event is stored at the end of its tracking, in a dense vector indexed by the
+ * Geant4 track ID, together with the decision to keep it or not.
+ * The EDM particles are created when the collection is handed over: if requested, the ancestors of the kept tracks
+ * are kept as well, so that the history stays connected. Otherwise each particle is linked to its closest kept
+ * ancestor. Parent and daughter relations are filled in one pass.
+ * Once the particles are handed over, the particle of any track (or of its closest kept ancestor, for the tracks which
+ * were not kept) can be found from its Geant4 track ID, e.g. to link the hits to the particles.
+ * The weights of the tracks differing from 1 (e.g. set by a Russian roulette) are kept as well, indexed by track ID.
  *
  * @author J. Lingemann
  */
@@ -23,25 +32,94 @@ class MCParticleCollection;
 namespace sim {
 class EventInformation : public G4VUserEventInformation {
 public:
-  /// Default constructor
-  EventInformation();
-  /// Destructor
-  virtual ~EventInformation() = default;
+  /** Constructor.
+   * @param[in] aKeepAncestors flag to keep all the ancestors of the kept tracks
+   */
+  explicit EventInformation(bool aKeepAncestors = true);
+  /// Destructor, deletes the particles if they were not handed over
+  virtual ~EventInformation();
   /** Set external pointers to point at the particle and vertex collections.
+   * The particles of the kept tracks are created, with their parent and daughter relations, before the ownership is
+   * transferred.
    * @param[in] aGenVertexCollection  pointer to a collection that should take ownership of the particles saved here
    * @param[in] aMCParticleCollection  pointer to a collection that should take ownership of the particles saved here
    */
   void setCollections(edm4hep::MCParticleCollection*& aMcParticleCollection);
-  /// Add a particle to be tracked in the EDM collections
-  void addParticle(const G4Track* aSecondary);
+  /** Move the particles to an existing collection, e.g. to merge the sub-events of one event.
+   * The particles are created if needed, and appended to the collection with their relations.
+   * @param[in] aCollection collection where the particles are appended
+   * @param[in] aTrackIdOffset offset added to the track IDs (simulator status) of the particles
+   */
+  void moveParticlesTo(edm4hep::MCParticleCollection& aCollection, int aTrackIdOffset);
+  /// Collection holding the particles once handed over (nullptr before)
+  const edm4hep::MCParticleCollection* savedParticles() const { return m_particlesSaved ? m_mcParticles : nullptr; }
+  /** Find the particle of a track in the handed over collection.
+   * @param[in] aTrackId Geant4 track ID
+   * @return index of the particle of the track or of its closest kept ancestor (-1: none or not handed over)
+   */
+  int32_t particleIndex(size_t aTrackId) const;
+  /** Set the weight of a track.
+   * @param[in] aTrackId Geant4 track ID
+   * @param[in] aWeight weight of the track
+   */
+  void setTrackWeight(size_t aTrackId, float aWeight);
+  /** Get the weight of a track.
+   * @param[in] aTrackId Geant4 track ID
+   * @return weight of the track (1 if not set)
+   */
+  float trackWeight(size_t aTrackId) const {
+    return (aTrackId < m_trackWeights.size()) ? m_trackWeights[aTrackId] : 1.f;
+  }
+  /** Record a track at the end of its tracking.
+   * @param[in] aTrack track which tracking ends
+   * @param[in] aKeep flag to keep the particle in the history
+   */
+  void addTrack(const G4Track* aTrack, bool aKeep);
 
   void Print() const {};
 
 private:
+  /// Record of a Geant4 track, with the quantities at its production vertex
+  struct TrackRecord {
+    /// Geant4 ID of the parent track (0 for primaries)
+    int32_t parentId = 0;
+    /// PDG code
+    int32_t pdg = 0;
+    /// Momentum at the production vertex
+    float momentum[3] = {0, 0, 0};
+    /// Mass
+    float mass = 0;
+    /// Charge
+    float charge = 0;
+    /// Production vertex
+    double vertex[3] = {0, 0, 0};
+    /// End point
+    double endpoint[3] = {0, 0, 0};
+    /// Time at the production vertex
+    double time = 0;
+    /// Flag set once the track is recorded
+    bool recorded = false;
+    /// Flag set if the track is kept in the history
+    bool keep = false;
+  };
+  /// Create the particles of the kept tracks and link them, if not done yet
+  void createParticles();
   /// Pointer to the particle collection, ownership is intended to be transfered to SaveTool
   edm4hep::MCParticleCollection* m_mcParticles;
-  /// Map to get the edm end vertex id from a Geant4 unique particle ID
-  std::map<size_t, size_t> m_g4IdToEndVertexMap;
+  /// Flag set once the particles are handed over (the collection is not owned anymore)
+  bool m_particlesSaved = false;
+  /// Flag set once the particles are created
+  bool m_particlesCreated = false;
+  /// Records of the tracks, indexed by Geant4 track ID
+  std::vector<TrackRecord> m_tracks;
+  /// Index of the particle of each track or of its closest kept ancestor (-1: none), indexed by Geant4 track ID
+  std::vector<int32_t> m_particleIndex;
+  /// Weights of the tracks, indexed by Geant4 track ID
+  std::vector<float> m_trackWeights;
+  /// Index of the first particle of this event in the collection holding the particles
+  int32_t m_firstParticle = 0;
+  /// Flag to keep all the ancestors of the kept tracks
+  bool m_keepAncestors;
 };
 } // namespace sim
 #endif /* define SIMG4COMMON_EVENTINFORMATION_H */
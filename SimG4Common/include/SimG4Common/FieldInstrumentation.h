@@ -0,0 +1,62 @@
+#ifndef SIMG4COMMON_FIELDINSTRUMENTATION_H
+#define SIMG4COMMON_FIELDINSTRUMENTATION_H
+
+// STL
+#include <memory>
+
+// Gaudi
+#include "Gaudi/Property.h"
+class AlgTool;
+class MsgStream;
+
+// Geant 4
+class G4MagneticField;
+
+namespace sim {
+class InstrumentedField;
+
+/** @class sim::FieldInstrumentation SimG4Common/SimG4Common/FieldInstrumentation.h FieldInstrumentation.h
+ *
+ *  Optional instrumentation of the field installed by a magnetic field tool.
+ *  Declares the Instrument* properties on the owning tool, wraps the field with sim::InstrumentedField
+ *  if InstrumentField is set and prints the summary of the field evaluations at finalize.
+ */
+class FieldInstrumentation {
+public:
+  /** Constructor, declares the properties on the owning tool.
+   *  @param[in] aOwner the magnetic field tool
+   */
+  explicit FieldInstrumentation(AlgTool* aOwner);
+  ~FieldInstrumentation();
+
+  /** Wrap the field if the instrumentation is switched on.
+   *  @param[in] aField the field of the tool (not owned)
+   *  @param[in] aLog message stream of the tool
+   *  @return the field to be installed in the field manager: the wrapper or aField itself
+   */
+  G4MagneticField* wrap(G4MagneticField* aField, MsgStream& aLog);
+
+  /** Print the summary of the field evaluations, normalised to the events of the current run.
+   *  Does nothing if the field was not instrumented.
+   *  @param[in] aLog message stream of the tool
+   */
+  void printSummary(MsgStream& aLog) const;
+
+private:
+  /// Switch to wrap the field with sim::InstrumentedField counting and timing the field evaluations
+  Gaudi::Property<bool> m_instrumentField;
+  /// Every n-th field evaluation is timed by the instrumentation (0 disables the timing)
+  Gaudi::Property<unsigned int> m_samplingPeriod;
+  /// Radial extent of the histogram of field evaluation positions
+  Gaudi::Property<double> m_rMax;
+  /// Longitudinal extent of the histogram of field evaluation positions
+  Gaudi::Property<double> m_zMax;
+  /// Number of radial bins of the histogram of field evaluation positions
+  Gaudi::Property<unsigned int> m_binsR;
+  /// Number of longitudinal bins of the histogram of field evaluation positions
+  Gaudi::Property<unsigned int> m_binsZ;
+  /// Instrumented wrapper of the field, installed instead of the field if m_instrumentField is set
+  std::unique_ptr<InstrumentedField> m_instrumentedField;
+};
+} // namespace sim
+#endif /* SIMG4COMMON_FIELDINSTRUMENTATION_H */
@@ -0,0 +1,96 @@
+#ifndef SIMG4COMMON_INSTRUMENTEDFIELD_H
+#define SIMG4COMMON_INSTRUMENTEDFIELD_H
+
+// STL
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Geant 4
+#include "G4MagneticField.hh"
+
+// Gaudi
+class MsgStream;
+
+/** @class sim::InstrumentedField SimG4Common/SimG4Common/InstrumentedField.h InstrumentedField.h
+ *
+ *  Wrapper around any Geant4 magnetic field that counts the field evaluations.
+ *  The calls are counted per thread and histogrammed in bins of radius and |z| of the queried position.
+ *  Every n-th call (sampling period) is timed to estimate the latency of the field lookup.
+ *  The wrapped field is not owned.
+ */
+
+namespace sim {
+class InstrumentedField : public G4MagneticField {
+public:
+  /** Constructor.
+   *  @param[in] aField the field to be instrumented (not owned)
+   *  @param[in] aRMax radial extent of the position histogram, larger radii go to the last bin
+   *  @param[in] aZMax longitudinal extent of the position histogram, larger |z| go to the last bin
+   *  @param[in] aBinsR number of radial bins
+   *  @param[in] aBinsZ number of longitudinal bins
+   *  @param[in] aSamplingPeriod every aSamplingPeriod-th call is timed (0 disables the timing)
+   */
+  InstrumentedField(const G4MagneticField* aField, double aRMax, double aZMax, unsigned int aBinsR,
+                    unsigned int aBinsZ, unsigned int aSamplingPeriod);
+  // Destructor
+  virtual ~InstrumentedField() {}
+
+  /// Get the value of the magnetic field value at position, forwarded to the wrapped field
+  /// @param[in] point the position where the field is to be returned
+  /// @param[out] bField the return value
+  virtual void GetFieldValue(const G4double point[4], double* bField) const final;
+
+  /// Does field change energy ? Forwarded to the wrapped field
+  virtual G4bool DoesFieldChangeEnergy() const final;
+
+  /// Total number of field evaluations summed over all threads
+  uint64_t totalCalls() const;
+
+  /** Print the summary of the field evaluations.
+   *  @param[in] aLog message stream to print to
+   *  @param[in] aNumEvents number of processed events, used to normalise the counts (ignored if 0)
+   */
+  void printSummary(MsgStream& aLog, int aNumEvents = 0) const;
+
+private:
+  /// Counters filled by one thread
+  struct ThreadCounters {
+    /// Number of field evaluations
+    uint64_t calls = 0;
+    /// Number of timed field evaluations
+    uint64_t timedCalls = 0;
+    /// Sum of the timed field evaluations (ns)
+    double timeSum = 0;
+    /// Fastest timed field evaluation (ns)
+    double timeMin = 0;
+    /// Slowest timed field evaluation (ns)
+    double timeMax = 0;
+    /// Number of field evaluations in bins of (r, |z|)
+    std::vector<uint64_t> positions;
+  };
+  /// Get the counters of the calling thread, registering them on first use
+  ThreadCounters& counters() const;
+
+  /// Wrapped field
+  const G4MagneticField* m_field;
+  /// Radial extent of the position histogram
+  double m_rMax;
+  /// Longitudinal extent of the position histogram
+  double m_zMax;
+  /// Number of radial bins
+  unsigned int m_binsR;
+  /// Number of longitudinal bins
+  unsigned int m_binsZ;
+  /// Period of the timed field evaluations
+  unsigned int m_samplingPeriod;
+  /// Identifier of this instance, used to find the thread-local counters
+  uint64_t m_id;
+  /// Guards the registration of the per-thread counters
+  mutable std::mutex m_mutex;
+  /// Counters of all the threads which evaluated the field
+  mutable std::vector<std::unique_ptr<ThreadCounters>> m_counters;
+};
+} // namespace sim
+#endif /* SIMG4COMMON_INSTRUMENTEDFIELD_H */
@@ -5,6 +5,7 @@
 #include "edm4hep/MCParticle.h"
 
 // Geant4
+#include "G4Allocator.hh"
 #include "G4VUserPrimaryParticleInformation.hh"
 
 // CLHEP
@@ -18,6 +19,7 @@
  *  MCParticle information is filled when EDM event is translated to G4Event.
  *  Momentum, status and vertex info is filled at the end of Geant's track processing
  *  (SaveParticlesTrackingAction::PostUserTrackingAction).
+ *  Objects are allocated from a per-thread pool (G4Allocator), as one is created for each primary particle.
  *
  *  @author Anna Zaborowska
  */
@@ -31,6 +33,10 @@ public:
   explicit ParticleInformation(const edm4hep::MCParticle& aMCpart);
   /// A destructor
   virtual ~ParticleInformation();
+  /// new operator needed for g4 memory allocation
+  inline void* operator new(size_t);
+  /// delete operator needed for g4 memory allocation
+  inline void operator delete(void*);
   /// A printing method
   virtual void Print() const final;
   /** Getter of the MCParticle.
@@ -82,6 +88,20 @@ private:
   /// Flag indicating if particle was smeared in the tracker (filled for fast-sim)
   bool m_smeared;
 };
+
+// types and functions for G4 memory allocation, inspired by the G4VHit classes in Geant4 examples
+
+extern G4ThreadLocal G4Allocator<ParticleInformation>* ParticleInformationAllocator;
+
+inline void* ParticleInformation::operator new(size_t) {
+  if (!ParticleInformationAllocator)
+    ParticleInformationAllocator = new G4Allocator<ParticleInformation>;
+  return (void*)ParticleInformationAllocator->MallocSingle();
+}
+
+inline void ParticleInformation::operator delete(void* info) {
+  ParticleInformationAllocator->FreeSingle((ParticleInformation*)info);
+}
 } // namespace sim
 
 #endif /* SIMG4COMMON_PARTICLEINFORMATION_H */
@@ -0,0 +1,58 @@
+#ifndef SIMG4COMMON_VOLUMESELECTOR_H
+#define SIMG4COMMON_VOLUMESELECTOR_H
+
+// STL
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Geant4
+class G4LogicalVolume;
+
+/** @class sim::VolumeSelector SimG4Common/SimG4Common/VolumeSelector.h VolumeSelector.h
+ *
+ *  Selection of the logical volumes for the region tools.
+ *  A selection is either:
+ *  - a plain name: the daughters of the world volume whose (physical) name contains it, as done historically;
+ *  - "glob:<pattern>": the logical volumes, at any depth, whose name matches the pattern with wildcards '*' and '?';
+ *  - "regex:<expression>": the logical volumes, at any depth, whose name fully matches the regular expression.
+ *  The names of all the logical volumes are indexed once, in a single traversal of G4LogicalVolumeStore, and sorted,
+ *  so that the glob patterns starting with a literal prefix only scan the names sharing that prefix.
+ *  The index is shared by all the region tools and rebuilt if the content of the volume store has changed.
+ */
+
+namespace sim {
+class VolumeSelector {
+public:
+  /** Get the selector of the current geometry, building its index on first use.
+   *  @return the shared selector
+   */
+  static const VolumeSelector& geometry();
+  /** Select the logical volumes.
+   *  @param[in] aSelection Plain name, "glob:" pattern or "regex:" expression.
+   *  @param[out] aVolumes Selected volumes, without duplicates, appended to the vector.
+   *  @param[out] aError Description of the error if the selection is invalid.
+   *  @return false if the selection is invalid
+   */
+  bool select(const std::string& aSelection, std::vector<G4LogicalVolume*>& aVolumes, std::string& aError) const;
+  /// Number of indexed logical volumes
+  size_t size() const { return m_names.size(); }
+
+private:
+  /// Build the index from the logical volume store
+  VolumeSelector();
+  /** Match the name against a glob pattern.
+   *  @param[in] aPattern Pattern with wildcards '*' (any sequence) and '?' (any character).
+   *  @param[in] aName Name to be matched.
+   *  @return true if the whole name matches
+   */
+  static bool globMatch(const std::string& aPattern, const std::string& aName);
+  /// Names of the logical volumes with the volumes, sorted by name
+  std::vector<std::pair<std::string, G4LogicalVolume*>> m_names;
+  /// Content of the logical volume store when the index was built, in the order of the store
+  std::vector<const G4LogicalVolume*> m_storeVolumes;
+};
+} // namespace sim
+
+#endif /* SIMG4COMMON_VOLUMESELECTOR_H */
@@ -6,51 +6,144 @@
 
 #include "edm4hep/MCParticleCollection.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace sim {
-EventInformation::EventInformation() { m_mcParticles = new edm4hep::MCParticleCollection(); }
+EventInformation::EventInformation(bool aKeepAncestors) : m_keepAncestors(aKeepAncestors) {
+  m_mcParticles = new edm4hep::MCParticleCollection();
+}
+
+EventInformation::~EventInformation() {
+  if (!m_particlesSaved) {
+    delete m_mcParticles;
+  }
+}
 
 void EventInformation::setCollections(edm4hep::MCParticleCollection*& aMCParticleCollection) {
+  createParticles();
   // ownership is transferred here - to SaveTool which is supposed to put it in the event store
   aMCParticleCollection = m_mcParticles;
+  m_particlesSaved = true;
+}
+
+void EventInformation::moveParticlesTo(edm4hep::MCParticleCollection& aCollection, int aTrackIdOffset) {
+  createParticles();
+  const size_t offset = aCollection.size();
+  for (const auto& particle : *m_mcParticles) {
+    auto edmParticle = particle.clone(false);
+    edmParticle.setSimulatorStatus(particle.getSimulatorStatus() + aTrackIdOffset);
+    aCollection.push_back(edmParticle);
+  }
+  // relations point to the collection of this event, they are recreated between the moved particles
+  for (size_t iParticle = 0; iParticle < m_mcParticles->size(); ++iParticle) {
+    auto edmParticle = aCollection[offset + iParticle];
+    for (const auto& daughter : (*m_mcParticles)[iParticle].getDaughters()) {
+      auto movedDaughter = aCollection[offset + daughter.getObjectID().index];
+      edmParticle.addToDaughters(movedDaughter);
+      movedDaughter.addToParents(edmParticle);
+    }
+  }
+  if (!m_particlesSaved) {
+    delete m_mcParticles;
+  }
+  m_mcParticles = &aCollection;
+  m_particlesSaved = true;
+  m_firstParticle = static_cast<int32_t>(offset);
+}
+
+int32_t EventInformation::particleIndex(size_t aTrackId) const {
+  if (!m_particlesSaved || aTrackId >= m_particleIndex.size() || m_particleIndex[aTrackId] < 0) {
+    return -1;
+  }
+  return m_firstParticle + m_particleIndex[aTrackId];
+}
+
+void EventInformation::addTrack(const G4Track* aTrack, bool aKeep) {
+  size_t g4ID = aTrack->GetTrackID();
+  if (g4ID >= m_tracks.size()) {
+    m_tracks.resize(std::max(g4ID + 1, 2 * m_tracks.size()));
+  }
+  TrackRecord& record = m_tracks[g4ID];
+  record.recorded = true;
+  record.keep = aKeep;
+  record.parentId = aTrack->GetParentID();
+  const auto* definition = aTrack->GetDefinition();
+  record.pdg = definition->GetPDGEncoding();
+  record.charge = definition->GetPDGCharge();
+  record.mass = definition->GetPDGMass() * sim::g42edm::energy;
+
+  // the track is recorded at the end of its tracking, momentum is taken at the production vertex
+  double kineticEnergy = aTrack->GetVertexKineticEnergy();
+  double momentum = std::sqrt(kineticEnergy * (kineticEnergy + 2 * definition->GetPDGMass()));
+  auto g4mom = aTrack->GetVertexMomentumDirection() * momentum;
+  record.momentum[0] = g4mom.x() * sim::g42edm::energy;
+  record.momentum[1] = g4mom.y() * sim::g42edm::energy;
+  record.momentum[2] = g4mom.z() * sim::g42edm::energy;
+
+  auto g4StartPos = aTrack->GetVertexPosition();
+  auto g4EndPos = aTrack->GetPosition();
+  for (int i = 0; i < 3; ++i) {
+    record.vertex[i] = g4StartPos[i] * sim::g42edm::length;
+    record.endpoint[i] = g4EndPos[i] * sim::g42edm::length;
+  }
+  record.time = (aTrack->GetGlobalTime() - aTrack->GetLocalTime()) * sim::g42edm::length;
+}
+
+void EventInformation::setTrackWeight(size_t aTrackId, float aWeight) {
+  if (aTrackId >= m_trackWeights.size()) {
+    m_trackWeights.resize(std::max(aTrackId + 1, 2 * m_trackWeights.size()), 1.f);
+  }
+  m_trackWeights[aTrackId] = aWeight;
 }
 
-void EventInformation::addParticle(const G4Track* aSecondary) {
-  auto edmParticle = m_mcParticles->create();
-  auto g4mom = aSecondary->GetMomentum();
-  auto g4energy = aSecondary->GetTotalEnergy();
-  float mass = g4energy * g4energy - g4mom.mag2();
-  mass = sqrt(fabs(mass));
-  size_t g4ID = aSecondary->GetTrackID();
-
-  edmParticle.setMomentum({
-      (float)g4mom.x() * (float)sim::g42edm::energy,
-      (float)g4mom.y() * (float)sim::g42edm::energy,
-      (float)g4mom.z() * (float)sim::g42edm::energy,
-  });
-  edmParticle.setMass(mass * sim::g42edm::energy);
-  edmParticle.setSimulatorStatus(g4ID);
-  edmParticle.setPDG(aSecondary->GetDynamicParticle()->GetDefinition()->GetPDGEncoding());
-
-  auto g4EndPos = aSecondary->GetPosition();
-  edmParticle.setEndpoint({
-      g4EndPos.x() * sim::g42edm::length,
-      g4EndPos.y() * sim::g42edm::length,
-      g4EndPos.z() * sim::g42edm::length,
-  });
-  edmParticle.setTime(aSecondary->GetGlobalTime() * sim::g42edm::length);
-
-  auto g4StartPos = aSecondary->GetVertexPosition();
-  edmParticle.setVertex({
-      g4StartPos.x() * sim::g42edm::length,
-      g4StartPos.y() * sim::g42edm::length,
-      g4StartPos.z() * sim::g42edm::length,
-  });
-
-  // todo: no time at endpoint
-  //       parents relations
-  //       daughter relations
-
-  // size_t motherID = aSecondary->GetParentID();
+void EventInformation::createParticles() {
+  if (m_particlesCreated) {
+    return;
+  }
+  m_particlesCreated = true;
+  // parents always have smaller track IDs than their daughters: one backward pass marks all the ancestors
+  if (m_keepAncestors) {
+    for (size_t g4ID = m_tracks.size(); g4ID-- > 1;) {
+      const TrackRecord& record = m_tracks[g4ID];
+      if (record.keep && record.parentId > 0 && static_cast<size_t>(record.parentId) < m_tracks.size() &&
+          m_tracks[record.parentId].recorded) {
+        m_tracks[record.parentId].keep = true;
+      }
+    }
+  }
+  // particle index of each track, or of its closest kept ancestor
+  m_particleIndex.assign(m_tracks.size(), -1);
+  for (size_t g4ID = 1; g4ID < m_tracks.size(); ++g4ID) {
+    const TrackRecord& record = m_tracks[g4ID];
+    if (!record.recorded) {
+      continue;
+    }
+    int32_t parent = -1;
+    if (record.parentId > 0 && static_cast<size_t>(record.parentId) < m_tracks.size()) {
+      parent = m_particleIndex[record.parentId];
+    }
+    if (!record.keep) {
+      m_particleIndex[g4ID] = parent;
+      continue;
+    }
+    m_particleIndex[g4ID] = m_mcParticles->size();
+    auto edmParticle = m_mcParticles->create();
+    edmParticle.setMomentum({record.momentum[0], record.momentum[1], record.momentum[2]});
+    edmParticle.setMass(record.mass);
+    edmParticle.setCharge(record.charge);
+    edmParticle.setSimulatorStatus(g4ID);
+    edmParticle.setPDG(record.pdg);
+    edmParticle.setVertex({record.vertex[0], record.vertex[1], record.vertex[2]});
+    edmParticle.setEndpoint({record.endpoint[0], record.endpoint[1], record.endpoint[2]});
+    edmParticle.setTime(record.time);
+    if (parent >= 0) {
+      auto parentParticle = (*m_mcParticles)[parent];
+      edmParticle.addToParents(parentParticle);
+      parentParticle.addToDaughters(edmParticle);
+    }
+  }
+  m_tracks.clear();
 }
 
 } // namespace sim
@@ -0,0 +1,46 @@
+#include "SimG4Common/FieldInstrumentation.h"
+
+// FCCSW
+#include "SimG4Common/InstrumentedField.h"
+
+// Gaudi
+#include "GaudiKernel/AlgTool.h"
+#include "GaudiKernel/MsgStream.h"
+
+// Geant 4
+#include "G4MagneticField.hh"
+#include "G4Run.hh"
+#include "G4RunManager.hh"
+#include "G4SystemOfUnits.hh"
+
+namespace sim {
+FieldInstrumentation::FieldInstrumentation(AlgTool* aOwner)
+    : m_instrumentField{aOwner, "InstrumentField", false,
+                        "Count and time the field evaluations, summary is printed at finalize"},
+      m_samplingPeriod{aOwner, "InstrumentationSamplingPeriod", 1000, "Every n-th field evaluation is timed"},
+      m_rMax{aOwner, "InstrumentationRMax", 6. * m, "Radial extent of the histogram of field evaluation positions"},
+      m_zMax{aOwner, "InstrumentationZMax", 10. * m,
+             "Longitudinal extent of the histogram of field evaluation positions"},
+      m_binsR{aOwner, "InstrumentationBinsR", 6, "Number of radial bins of the field evaluation positions"},
+      m_binsZ{aOwner, "InstrumentationBinsZ", 5, "Number of longitudinal bins of the field evaluation positions"} {}
+
+FieldInstrumentation::~FieldInstrumentation() {}
+
+G4MagneticField* FieldInstrumentation::wrap(G4MagneticField* aField, MsgStream& aLog) {
+  if (!m_instrumentField) {
+    return aField;
+  }
+  m_instrumentedField = std::make_unique<InstrumentedField>(aField, m_rMax, m_zMax, m_binsR, m_binsZ, m_samplingPeriod);
+  aLog << MSG::INFO << "Magnetic field evaluations will be counted and timed" << endmsg;
+  return m_instrumentedField.get();
+}
+
+void FieldInstrumentation::printSummary(MsgStream& aLog) const {
+  if (!m_instrumentedField) {
+    return;
+  }
+  const G4RunManager* runManager = G4RunManager::GetRunManager();
+  const G4Run* run = (runManager != nullptr) ? runManager->GetCurrentRun() : nullptr;
+  m_instrumentedField->printSummary(aLog, (run != nullptr) ? run->GetNumberOfEvent() : 0);
+}
+} // namespace sim
@@ -0,0 +1,130 @@
+#include "SimG4Common/InstrumentedField.h"
+
+// STL
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <utility>
+
+// Gaudi
+#include "GaudiKernel/MsgStream.h"
+
+// Geant 4
+#include "G4SystemOfUnits.hh"
+
+namespace {
+/// Source of the unique identifiers of the instrumented fields
+std::atomic<uint64_t> instrumentedFieldCounter{0};
+} // namespace
+
+namespace sim {
+InstrumentedField::InstrumentedField(const G4MagneticField* aField, double aRMax, double aZMax, unsigned int aBinsR,
+                                     unsigned int aBinsZ, unsigned int aSamplingPeriod)
+    : m_field(aField), m_rMax(aRMax), m_zMax(aZMax), m_binsR(std::max(aBinsR, 1u)), m_binsZ(std::max(aBinsZ, 1u)),
+      m_samplingPeriod(aSamplingPeriod), m_id(++instrumentedFieldCounter) {}
+
+InstrumentedField::ThreadCounters& InstrumentedField::counters() const {
+  // Each thread keeps the counters of the fields it has seen, usually there is only one
+  thread_local std::vector<std::pair<uint64_t, ThreadCounters*>> threadCounters;
+  for (auto& entry : threadCounters) {
+    if (entry.first == m_id) {
+      return *entry.second;
+    }
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_counters.emplace_back(new ThreadCounters());
+  m_counters.back()->positions.resize(m_binsR * m_binsZ, 0);
+  threadCounters.emplace_back(m_id, m_counters.back().get());
+  return *m_counters.back();
+}
+
+void InstrumentedField::GetFieldValue(const G4double point[4], double* bField) const {
+  ThreadCounters& cnt = counters();
+  ++cnt.calls;
+
+  double r = std::sqrt(point[0] * point[0] + point[1] * point[1]);
+  unsigned int binR = std::min(static_cast<unsigned int>(r / m_rMax * m_binsR), m_binsR - 1);
+  unsigned int binZ = std::min(static_cast<unsigned int>(std::abs(point[2]) / m_zMax * m_binsZ), m_binsZ - 1);
+  ++cnt.positions[binR * m_binsZ + binZ];
+
+  if (m_samplingPeriod == 0 || cnt.calls % m_samplingPeriod != 0) {
+    m_field->GetFieldValue(point, bField);
+    return;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  m_field->GetFieldValue(point, bField);
+  auto end = std::chrono::steady_clock::now();
+  double time = std::chrono::duration<double, std::nano>(end - start).count();
+  if (cnt.timedCalls == 0 || time < cnt.timeMin) {
+    cnt.timeMin = time;
+  }
+  if (cnt.timedCalls == 0 || time > cnt.timeMax) {
+    cnt.timeMax = time;
+  }
+  cnt.timeSum += time;
+  ++cnt.timedCalls;
+}
+
+G4bool InstrumentedField::DoesFieldChangeEnergy() const { return m_field->DoesFieldChangeEnergy(); }
+
+uint64_t InstrumentedField::totalCalls() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  uint64_t calls = 0;
+  for (const auto& cnt : m_counters) {
+    calls += cnt->calls;
+  }
+  return calls;
+}
+
+void InstrumentedField::printSummary(MsgStream& aLog, int aNumEvents) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  uint64_t calls = 0;
+  uint64_t timedCalls = 0;
+  double timeSum = 0;
+  double timeMin = 0;
+  double timeMax = 0;
+  std::vector<uint64_t> positions(m_binsR * m_binsZ, 0);
+  for (const auto& cnt : m_counters) {
+    calls += cnt->calls;
+    if (cnt->timedCalls > 0) {
+      timeMin = (timedCalls == 0) ? cnt->timeMin : std::min(timeMin, cnt->timeMin);
+      timeMax = (timedCalls == 0) ? cnt->timeMax : std::max(timeMax, cnt->timeMax);
+      timedCalls += cnt->timedCalls;
+      timeSum += cnt->timeSum;
+    }
+    for (size_t iBin = 0; iBin < positions.size(); ++iBin) {
+      positions[iBin] += cnt->positions[iBin];
+    }
+  }
+
+  aLog << MSG::INFO << "Magnetic field evaluation summary:" << endmsg;
+  aLog << MSG::INFO << "  Total number of calls: " << calls << endmsg;
+  if (aNumEvents > 0) {
+    aLog << MSG::INFO << "  Mean number of calls per event: " << static_cast<double>(calls) / aNumEvents << endmsg;
+  }
+  for (size_t iThread = 0; iThread < m_counters.size(); ++iThread) {
+    aLog << MSG::INFO << "  Calls in thread #" << iThread << ": " << m_counters[iThread]->calls << endmsg;
+  }
+  if (timedCalls > 0) {
+    aLog << MSG::INFO << "  Lookup latency from " << timedCalls << " sampled calls: mean " << timeSum / timedCalls
+         << " ns, min " << timeMin << " ns, max " << timeMax << " ns" << endmsg;
+  }
+  if (calls == 0) {
+    return;
+  }
+  aLog << MSG::INFO << "  Calls in bins of r and |z| (last bins include overflow):" << endmsg;
+  for (unsigned int iR = 0; iR < m_binsR; ++iR) {
+    for (unsigned int iZ = 0; iZ < m_binsZ; ++iZ) {
+      uint64_t binCalls = positions[iR * m_binsZ + iZ];
+      if (binCalls == 0) {
+        continue;
+      }
+      aLog << MSG::INFO << "    r: [" << iR * m_rMax / m_binsR / mm << ", " << (iR + 1) * m_rMax / m_binsR / mm
+           << ") mm, |z|: [" << iZ * m_zMax / m_binsZ / mm << ", " << (iZ + 1) * m_zMax / m_binsZ / mm
+           << ") mm -> " << binCalls << " (" << 100. * binCalls / calls << " %)" << endmsg;
+    }
+  }
+}
+} // namespace sim
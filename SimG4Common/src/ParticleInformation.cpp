@@ -1,6 +1,9 @@
 #include "SimG4Common/ParticleInformation.h"
 
 namespace sim {
+// G4 allocation method
+G4ThreadLocal G4Allocator<ParticleInformation>* ParticleInformationAllocator = 0;
+
 ParticleInformation::ParticleInformation(const edm4hep::MCParticle& aMCpart)
     : m_mcParticle(aMCpart), m_smeared(false) {}
 
@@ -0,0 +1,118 @@
+#include "SimG4Common/VolumeSelector.h"
+
+// Geant4
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4TransportationManager.hh"
+#include "G4VPhysicalVolume.hh"
+
+// STL
+#include <algorithm>
+#include <memory>
+#include <regex>
+#include <unordered_set>
+
+namespace {
+const std::string globPrefix = "glob:";
+const std::string regexPrefix = "regex:";
+
+bool startsWith(const std::string& aString, const std::string& aPrefix) {
+  return aString.compare(0, aPrefix.size(), aPrefix) == 0;
+}
+} // namespace
+
+namespace sim {
+const VolumeSelector& VolumeSelector::geometry() {
+  static std::unique_ptr<VolumeSelector> selector;
+  // the index is rebuilt if any volume was added to or removed from the store, not only if its size changed
+  const auto* store = G4LogicalVolumeStore::GetInstance();
+  if (selector == nullptr || !std::equal(store->begin(), store->end(), selector->m_storeVolumes.begin(),
+                                         selector->m_storeVolumes.end())) {
+    selector.reset(new VolumeSelector());
+  }
+  return *selector;
+}
+
+VolumeSelector::VolumeSelector() {
+  const auto* store = G4LogicalVolumeStore::GetInstance();
+  m_storeVolumes.assign(store->begin(), store->end());
+  m_names.reserve(store->size());
+  for (auto* volume : *store) {
+    m_names.emplace_back(volume->GetName(), volume);
+  }
+  std::sort(m_names.begin(), m_names.end());
+}
+
+bool VolumeSelector::select(const std::string& aSelection, std::vector<G4LogicalVolume*>& aVolumes,
+                            std::string& aError) const {
+  // the set of the selected volumes avoids a linear search of the vector for each new volume
+  std::unordered_set<const G4LogicalVolume*> selected(aVolumes.begin(), aVolumes.end());
+  auto add = [&aVolumes, &selected](G4LogicalVolume* aVolume) {
+    if (selected.insert(aVolume).second) {
+      aVolumes.push_back(aVolume);
+    }
+  };
+  if (startsWith(aSelection, globPrefix)) {
+    const std::string pattern = aSelection.substr(globPrefix.size());
+    // only the names starting with the literal prefix of the pattern can match
+    const std::string prefix = pattern.substr(0, pattern.find_first_of("*?"));
+    auto it = std::lower_bound(m_names.begin(), m_names.end(), prefix,
+                               [](const std::pair<std::string, G4LogicalVolume*>& aEntry,
+                                  const std::string& aPrefix) { return aEntry.first < aPrefix; });
+    for (; it != m_names.end() && startsWith(it->first, prefix); ++it) {
+      if (globMatch(pattern, it->first)) {
+        add(it->second);
+      }
+    }
+    return true;
+  }
+  if (startsWith(aSelection, regexPrefix)) {
+    std::regex expression;
+    try {
+      expression.assign(aSelection.substr(regexPrefix.size()), std::regex::ECMAScript | std::regex::optimize);
+    } catch (const std::regex_error& e) {
+      aError = "Invalid regular expression '" + aSelection.substr(regexPrefix.size()) + "': " + e.what();
+      return false;
+    }
+    for (const auto& entry : m_names) {
+      if (std::regex_match(entry.first, expression)) {
+        add(entry.second);
+      }
+    }
+    return true;
+  }
+  // plain name: substring of the daughters of the world volume
+  G4LogicalVolume* world =
+      (*G4TransportationManager::GetTransportationManager()->GetWorldsIterator())->GetLogicalVolume();
+  for (size_t iDaughter = 0; iDaughter < world->GetNoDaughters(); ++iDaughter) {
+    if (world->GetDaughter(iDaughter)->GetName().find(aSelection) != std::string::npos) {
+      add(world->GetDaughter(iDaughter)->GetLogicalVolume());
+    }
+  }
+  return true;
+}
+
+bool VolumeSelector::globMatch(const std::string& aPattern, const std::string& aName) {
+  // iterative matching, backtracking to the last '*'
+  size_t iPattern = 0, iName = 0;
+  size_t starPattern = std::string::npos, starName = 0;
+  while (iName < aName.size()) {
+    if (iPattern < aPattern.size() && (aPattern[iPattern] == '?' || aPattern[iPattern] == aName[iName])) {
+      ++iPattern;
+      ++iName;
+    } else if (iPattern < aPattern.size() && aPattern[iPattern] == '*') {
+      starPattern = iPattern++;
+      starName = iName;
+    } else if (starPattern != std::string::npos) {
+      iPattern = starPattern + 1;
+      iName = ++starName;
+    } else {
+      return false;
+    }
+  }
+  while (iPattern < aPattern.size() && aPattern[iPattern] == '*') {
+    ++iPattern;
+  }
+  return iPattern == aPattern.size();
+}
+} // namespace sim
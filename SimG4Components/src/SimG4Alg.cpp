@@ -6,6 +6,10 @@
 // Geant
 #include "G4Event.hh"
 
+// STL
+#include <algorithm>
+#include <limits>
+
 DECLARE_COMPONENT(SimG4Alg)
 
 SimG4Alg::SimG4Alg(const std::string& aName, ISvcLocator* aSvcLoc)
@@ -31,10 +35,33 @@ StatusCode SimG4Alg::initialize() {
     error() << "Unable to retrieve the G4Event provider " << m_eventTool << endmsg;
     return StatusCode::FAILURE;
   }
+  if (m_numSubEvents > 1) {
+    if (m_trackIdOffsetStep <= 0) {
+      error() << "Offset of the track IDs between sub-events must be positive" << endmsg;
+      return StatusCode::FAILURE;
+    }
+    // the track IDs of the last sub-event, up to its offset + trackIdOffsetStep - 1, must fit in an int
+    const size_t maxSubEvents =
+        (std::numeric_limits<int>::max() - (m_trackIdOffsetStep - 1)) / m_trackIdOffsetStep + 1;
+    if (m_numSubEvents > maxSubEvents) {
+      error() << "The track IDs of " << m_numSubEvents << " sub-events offset by " << m_trackIdOffsetStep
+              << " overflow, at most " << maxSubEvents << " sub-events are allowed" << endmsg;
+      return StatusCode::FAILURE;
+    }
+    for (auto& saveTool : m_saveTools) {
+      if (!saveTool->mergesSubEvents()) {
+        error() << "The output saving tool " << saveTool << " cannot merge sub-events" << endmsg;
+        return StatusCode::FAILURE;
+      }
+    }
+  }
   return StatusCode::SUCCESS;
 }
 
 StatusCode SimG4Alg::execute(const EventContext&) const {
+  if (m_numSubEvents > 1) {
+    return executeSubEvents();
+  }
   // first translate the event
   G4Event* event = m_eventTool->g4Event();
 
@@ -52,4 +79,48 @@ StatusCode SimG4Alg::execute(const EventContext&) const {
   return StatusCode::SUCCESS;
 }
 
+StatusCode SimG4Alg::executeSubEvents() const {
+  std::vector<G4Event*> subEvents = m_eventTool->g4SubEvents(m_numSubEvents);
+  if (subEvents.empty() || std::find(subEvents.begin(), subEvents.end(), nullptr) != subEvents.end()) {
+    error() << "Unable to retrieve G4Events from " << m_eventTool << endmsg;
+    for (auto* subEvent : subEvents) {
+      delete subEvent;
+    }
+    return StatusCode::FAILURE;
+  }
+  // the sub-events are deleted by Geant when they are terminated, the ones not processed yet have to be deleted here
+  auto deleteFrom = [&subEvents](size_t aFirst) {
+    for (size_t iSubEvent = aFirst; iSubEvent < subEvents.size(); ++iSubEvent) {
+      delete subEvents[iSubEvent];
+    }
+  };
+  for (size_t iSubEvent = 0; iSubEvent < subEvents.size(); ++iSubEvent) {
+    if (m_geantSvc->processEvent(*subEvents[iSubEvent]).isFailure()) {
+      error() << "Unable to simulate the sub-event " << iSubEvent << endmsg;
+      deleteFrom(iSubEvent);
+      return StatusCode::FAILURE;
+    }
+    G4Event* constevent;
+    StatusCode status = m_geantSvc->retrieveEvent(constevent);
+    if (status.isFailure()) {
+      error() << "Unable to retrieve the simulated sub-event " << iSubEvent << endmsg;
+    }
+    int trackIdOffset = iSubEvent * m_trackIdOffsetStep;
+    for (auto tool = m_saveTools.begin(); status.isSuccess() && tool != m_saveTools.end(); ++tool) {
+      status = (*tool)->saveSubEventOutput(*constevent, iSubEvent, trackIdOffset);
+      if (status.isFailure()) {
+        error() << "Unable to save the output of the sub-event " << iSubEvent << " with " << *tool << endmsg;
+      }
+    }
+    // the sub-event is terminated even if its output could not be saved, so that Geant can process the next event
+    m_geantSvc->terminateEvent().ignore();
+    if (status.isFailure()) {
+      deleteFrom(iSubEvent + 1);
+      return StatusCode::FAILURE;
+    }
+  }
+  debug() << "Event simulated in " << subEvents.size() << " sub-events" << endmsg;
+  return StatusCode::SUCCESS;
+}
+
 StatusCode SimG4Alg::finalize() { return Gaudi::Algorithm::finalize(); }
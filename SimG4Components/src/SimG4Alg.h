@@ -23,6 +23,9 @@ class G4Event;
  *  retrieves it after the finished simulation, and stores the output as specified in tools.
  *  It takes MCParticleCollection (\b'genParticles') as the input
  *  as well as a list of names of tools that define the EDM output (\b'outputs').
+ *  Very high multiplicity events can be split by the event provider into up to '\b numSubEvents' sub-events,
+ *  simulated one after the other. The output tools merge the sub-events back into one event, with the track IDs of
+ *  the sub-event i offset by i * '\b trackIdOffsetStep'.
  *  [For more information please see](@ref md_sim_doc_geant4fullsim).
  *
  *  @author Anna Zaborowska
@@ -50,11 +53,22 @@ public:
   virtual StatusCode finalize() final;
 
 private:
+  /**  Execute the simulation of an event split into sub-events.
+   *   Each sub-event is simulated, saved (merged into the output of the previous sub-events) and terminated in turn.
+   *   @return status code
+   */
+  StatusCode executeSubEvents() const;
   /// Pointer to the interface of Geant simulation service
   ServiceHandle<ISimG4Svc> m_geantSvc;
   /// Handle to the tools saving the output
   mutable PublicToolHandleArray<ISimG4SaveOutputTool> m_saveTools{this, "outputs", {}};
   /// Handle for the tool that creates the G4Event
   mutable ToolHandle<ISimG4EventProviderTool> m_eventTool{"SimG4PrimariesFromEdmTool", this};
+  /// Maximum number of sub-events into which an event is split (1: no splitting)
+  Gaudi::Property<size_t> m_numSubEvents{this, "numSubEvents", 1,
+                                         "Maximum number of sub-events into which an event is split"};
+  /// Offset of the track IDs between consecutive sub-events
+  Gaudi::Property<int> m_trackIdOffsetStep{this, "trackIdOffsetStep", 10000000,
+                                           "Offset of the track IDs between consecutive sub-events"};
 };
 #endif /* SIMG4COMPONENTS_G4SIMALG_H */
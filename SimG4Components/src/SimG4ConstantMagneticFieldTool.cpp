@@ -3,6 +3,7 @@
 
 // FCCSW
 #include "SimG4Common/ConstantField.h"
+#include "SimG4Common/FieldInstrumentation.h"
 
 // Geant 4
 #include "G4ChordFinder.hh"
@@ -49,9 +50,11 @@ StatusCode SimG4ConstantMagneticFieldTool::initialize() {
     // The field manager keeps an observing pointer to the field, ownership stays with this tool. (Cleaned up in dtor)
     m_field =
         new sim::ConstantField(m_fieldComponentX, m_fieldComponentY, m_fieldComponentZ, m_fieldRadMax, m_fieldZMax);
-    fieldManager->SetDetectorField(m_field);
+    G4MagneticField* installedField = m_fieldInstrumentation.wrap(m_field, info());
+    fieldManager->SetDetectorField(installedField);
 
-    G4ChordFinder* chordFinder = new G4ChordFinder(m_field, m_minStep, stepper(m_integratorStepper, m_field));
+    G4ChordFinder* chordFinder =
+        new G4ChordFinder(installedField, m_minStep, stepper(m_integratorStepper, installedField));
     fieldManager->SetChordFinder(chordFinder);
 
     propagator->SetLargestAcceptableStep(m_maxStep);
@@ -69,6 +72,7 @@ StatusCode SimG4ConstantMagneticFieldTool::initialize() {
 }
 
 StatusCode SimG4ConstantMagneticFieldTool::finalize() {
+  m_fieldInstrumentation.printSummary(info());
   StatusCode sc = AlgTool::finalize();
   return sc;
 }
@@ -5,6 +5,7 @@
 #include "GaudiKernel/AlgTool.h"
 
 // FCCSW
+#include "SimG4Common/FieldInstrumentation.h"
 #include "SimG4Interface/ISimG4MagneticFieldTool.h"
 
 // Geant4
@@ -84,6 +85,8 @@ private:
   Gaudi::Property<double> m_fieldRadMax{this, "FieldRMax", 6 * m, "Field max radius"};
   /// Size of the field along the beam line. Set with property FieldZMax
   Gaudi::Property<double> m_fieldZMax{this, "FieldZMax", 20. * m, "Field max Z"};
+  /// Optional counting and timing of the field evaluations, declares the Instrument* properties
+  sim::FieldInstrumentation m_fieldInstrumentation{this};
 };
 
 #endif
@@ -6,6 +6,7 @@
 #include <string>
 
 // FCCSW
+#include "SimG4Common/FieldInstrumentation.h"
 #include "SimG4Common/MapField2DRegular.h"
 #include "SimG4Common/MapField3DRegular.h"
 
@@ -85,9 +86,11 @@ StatusCode SimG4MagneticFieldFromMapTool::initialize() {
   G4FieldManager* fieldManager = transpManager->GetFieldManager();
   G4PropagatorInField* propagator = transpManager->GetPropagatorInField();
 
-  fieldManager->SetDetectorField(m_field);
+  G4MagneticField* installedField = m_fieldInstrumentation.wrap(m_field, info());
+  fieldManager->SetDetectorField(installedField);
 
-  G4ChordFinder* chordFinder = new G4ChordFinder(m_field, m_minStep, stepper(m_integratorStepper, m_field));
+  G4ChordFinder* chordFinder =
+      new G4ChordFinder(installedField, m_minStep, stepper(m_integratorStepper, installedField));
   fieldManager->SetChordFinder(chordFinder);
 
   propagator->SetLargestAcceptableStep(m_maxStep);
@@ -122,6 +125,8 @@ StatusCode SimG4MagneticFieldFromMapTool::initialize() {
 }
 
 StatusCode SimG4MagneticFieldFromMapTool::finalize() {
+  m_fieldInstrumentation.printSummary(info());
+
   StatusCode sc = AlgTool::finalize();
 
   return sc;
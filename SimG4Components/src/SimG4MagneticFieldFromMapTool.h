@@ -5,6 +5,7 @@
 #include "GaudiKernel/AlgTool.h"
 
 // FCCSW
+#include "SimG4Common/FieldInstrumentation.h"
 #include "SimG4Interface/ISimG4MagneticFieldTool.h"
 
 // Geant4
@@ -90,6 +91,8 @@ private:
   Gaudi::Property<double> m_fieldMaxR{this, "FieldMaxR", -1., "Field maximum radius (default: no limit)"};
   /// Maximum field z coordinate (default: no limit)
   Gaudi::Property<double> m_fieldMaxZ{this, "FieldMaxZ", -1., "Field maximum z coordinate (default: no limit)"};
+  /// Optional counting and timing of the field evaluations, declares the Instrument* properties
+  sim::FieldInstrumentation m_fieldInstrumentation{this};
 
   /// Load map from the ROOT file
   StatusCode loadRootMap();
@@ -2,6 +2,7 @@
 
 // k4SimGeant4
 #include "SimG4Common/DD4hepField.h"
+#include "SimG4Common/FieldInstrumentation.h"
 
 // DD4hep
 #include "DD4hep/Detector.h"
@@ -65,10 +66,12 @@ StatusCode SimG4MagneticFieldTool::initialize() {
   G4PropagatorInField* propagator = transpManager->GetPropagatorInField();
 
   m_field = new k4simgeant4::DD4hepField(detDescription->field());
-  fieldManager->SetDetectorField(m_field);
+  G4MagneticField* installedField = m_fieldInstrumentation.wrap(m_field, info());
+  fieldManager->SetDetectorField(installedField);
   fieldManager->SetFieldChangesEnergy(detDescription->field().changesEnergy());
 
-  G4ChordFinder* chordFinder = new G4ChordFinder(m_field, m_minStep, stepper(m_integratorStepper, m_field));
+  G4ChordFinder* chordFinder =
+      new G4ChordFinder(installedField, m_minStep, stepper(m_integratorStepper, installedField));
   fieldManager->SetChordFinder(chordFinder);
 
   propagator->SetLargestAcceptableStep(m_maxStep);
@@ -86,6 +89,8 @@ StatusCode SimG4MagneticFieldTool::initialize() {
 }
 
 StatusCode SimG4MagneticFieldTool::finalize() {
+  m_fieldInstrumentation.printSummary(info());
+
   StatusCode sc = AlgTool::finalize();
 
   return sc;
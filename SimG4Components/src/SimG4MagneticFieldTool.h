@@ -6,6 +6,7 @@
 
 // k4FWCore
 #include "k4Interface/IGeoSvc.h"
+#include "SimG4Common/FieldInstrumentation.h"
 #include "SimG4Interface/ISimG4MagneticFieldTool.h"
 
 // Geant4
@@ -82,6 +83,9 @@ private:
 
   /// Name of the integration stepper, defaults to NystromRK4.
   Gaudi::Property<std::string> m_integratorStepper{this, "IntegratorStepper", "NystromRK4", "Integrator stepper name"};
+
+  /// Optional counting and timing of the field evaluations, declares the Instrument* properties
+  sim::FieldInstrumentation m_fieldInstrumentation{this};
 };
 
 #endif /* SIMG4COMPONENTS_G4MAGNETICFIELDTOOL_H */
@@ -0,0 +1,212 @@
+#include "SimG4OverlayPileupHits.h"
+
+// Gaudi
+#include "GaudiKernel/IRndmGenSvc.h"
+
+// datamodel
+#include "edm4hep/CaloHitContributionCollection.h"
+#include "edm4hep/SimCalorimeterHitCollection.h"
+#include "edm4hep/SimTrackerHitCollection.h"
+
+// podio
+#include "podio/Frame.h"
+#include "podio/FrameCategories.h"
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+DECLARE_COMPONENT(SimG4OverlayPileupHits)
+
+SimG4OverlayPileupHits::SimG4OverlayPileupHits(const std::string& aName, ISvcLocator* aSvcLoc)
+    : Gaudi::Algorithm(aName, aSvcLoc) {
+  declareProperty("SignalCaloHits", m_signalCaloHits, "Handle for the signal calorimeter hits");
+  declareProperty("MergedCaloHits", m_mergedCaloHits, "Handle for the calorimeter hits with the pile-up overlaid");
+  declareProperty("MergedCaloHitContributions", m_mergedCaloContributions,
+                  "Handle for the contributions to the calorimeter hits with the pile-up overlaid");
+  declareProperty("SignalTrackerHits", m_signalTrackerHits, "Handle for the signal tracker hits");
+  declareProperty("MergedTrackerHits", m_mergedTrackerHits, "Handle for the tracker hits with the pile-up overlaid");
+}
+
+StatusCode SimG4OverlayPileupHits::initialize() {
+  if (Gaudi::Algorithm::initialize().isFailure()) {
+    return StatusCode::FAILURE;
+  }
+  if (m_pileupCaloCollection.value().empty() && m_pileupTrackerCollection.value().empty()) {
+    error() << "No pile-up collection to overlay" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  if (m_minBunchCrossing > m_maxBunchCrossing || m_numPileupEvents < 0 || m_minCaloTime > m_maxCaloTime) {
+    error() << "Pile-up is not defined properly" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  // only the overlaid collections are read from the pile-up file
+  if (!m_pileupCaloCollection.value().empty()) {
+    m_pileupCollections.push_back(m_pileupCaloCollection);
+    if (!m_pileupCaloContributionCollection.value().empty()) {
+      m_pileupCollections.push_back(m_pileupCaloContributionCollection);
+    }
+  }
+  if (!m_pileupTrackerCollection.value().empty()) {
+    m_pileupCollections.push_back(m_pileupTrackerCollection);
+  }
+  try {
+    m_reader.openFile(m_pileupFile);
+  } catch (const std::exception& e) {
+    error() << "Unable to open the pile-up file " << m_pileupFile << ": " << e.what() << endmsg;
+    return StatusCode::FAILURE;
+  }
+  m_numEntries = m_reader.getEntries(podio::Category::Event);
+  if (m_numEntries == 0) {
+    error() << "No minimum-bias events in the pile-up file " << m_pileupFile << endmsg;
+    return StatusCode::FAILURE;
+  }
+  // the overlaid collections must be in the pile-up file, with their expected types
+  auto firstFrame = podio::Frame(m_reader.readEntry(podio::Category::Event, 0));
+  auto checkCollection = [&](const std::string& aName, std::string_view aTypeName) {
+    const podio::CollectionBase* collection = firstFrame.get(aName);
+    if (collection == nullptr) {
+      error() << "Collection " << aName << " not found in the pile-up file " << m_pileupFile.value()
+              << ", available collections:";
+      for (const auto& name : firstFrame.getAvailableCollections()) {
+        error() << " " << name;
+      }
+      error() << endmsg;
+      return false;
+    }
+    if (collection->getTypeName() != aTypeName) {
+      error() << "Collection " << aName << " of the pile-up file " << m_pileupFile.value() << " is a "
+              << collection->getTypeName() << ", expected a " << aTypeName << endmsg;
+      return false;
+    }
+    return true;
+  };
+  if (!m_pileupCaloCollection.value().empty() &&
+      (!checkCollection(m_pileupCaloCollection, edm4hep::SimCalorimeterHitCollection::typeName) ||
+       (!m_pileupCaloContributionCollection.value().empty() &&
+        !checkCollection(m_pileupCaloContributionCollection, edm4hep::CaloHitContributionCollection::typeName)))) {
+    return StatusCode::FAILURE;
+  }
+  if (!m_pileupTrackerCollection.value().empty() &&
+      !checkCollection(m_pileupTrackerCollection, edm4hep::SimTrackerHitCollection::typeName)) {
+    return StatusCode::FAILURE;
+  }
+  auto randSvc = service<IRndmGenSvc>("RndmGenSvc");
+  if (!randSvc) {
+    error() << "Unable to locate RndmGen Service" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  if (m_flat.initialize(randSvc, Rndm::Flat(0, 1)).isFailure() ||
+      (m_poissonPileup && m_poisson.initialize(randSvc, Rndm::Poisson(m_numPileupEvents)).isFailure())) {
+    error() << "Unable to create the random number generators" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  info() << "Overlaying " << m_numPileupEvents.value() << " pile-up events from " << m_numEntries
+         << " minimum-bias events of " << m_pileupFile.value() << endmsg;
+  return StatusCode::SUCCESS;
+}
+
+StatusCode SimG4OverlayPileupHits::execute(const EventContext&) const {
+  const bool overlayCalo = !m_pileupCaloCollection.value().empty();
+  const bool overlayTracker = !m_pileupTrackerCollection.value().empty();
+  const bool overlayContributions = !m_pileupCaloContributionCollection.value().empty();
+  edm4hep::SimCalorimeterHitCollection* mergedCaloHits = nullptr;
+  edm4hep::CaloHitContributionCollection* mergedContributions = nullptr;
+  edm4hep::SimTrackerHitCollection* mergedTrackerHits = nullptr;
+  // calorimeter hits are indexed by cellID, so the pile-up energy is added to the existing cells
+  std::unordered_map<uint64_t, size_t> cellHitIndex;
+  auto cellHit = [&](const edm4hep::SimCalorimeterHit& aHit) {
+    auto index = cellHitIndex.find(aHit.getCellID());
+    if (index != cellHitIndex.end()) {
+      return (*mergedCaloHits)[index->second];
+    }
+    auto mergedHit = mergedCaloHits->create();
+    mergedHit.setCellID(aHit.getCellID());
+    mergedHit.setPosition(aHit.getPosition());
+    cellHitIndex.emplace(aHit.getCellID(), mergedCaloHits->size() - 1);
+    return mergedHit;
+  };
+  auto inCaloTimeWindow = [this](double aTime) { return aTime >= m_minCaloTime && aTime <= m_maxCaloTime; };
+  if (overlayCalo) {
+    mergedCaloHits = m_mergedCaloHits.createAndPut();
+    mergedContributions = m_mergedCaloContributions.createAndPut();
+    for (const auto& hit : *m_signalCaloHits.get()) {
+      auto mergedHit = cellHit(hit);
+      mergedHit.setEnergy(mergedHit.getEnergy() + hit.getEnergy());
+      // the contributions of the signal keep their links to the signal particles
+      for (const auto& contribution : hit.getContributions()) {
+        auto mergedContribution = contribution.clone();
+        mergedContributions->push_back(mergedContribution);
+        mergedHit.addToContributions(mergedContribution);
+      }
+    }
+  }
+  if (overlayTracker) {
+    mergedTrackerHits = m_mergedTrackerHits.createAndPut();
+    for (const auto& hit : *m_signalTrackerHits.get()) {
+      mergedTrackerHits->push_back(hit.clone());
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  unsigned int numPileup = m_poissonPileup ? static_cast<unsigned int>(m_poisson())
+                                           : static_cast<unsigned int>(std::lround(m_numPileupEvents.value()));
+  int numBunchCrossings = m_maxBunchCrossing - m_minBunchCrossing + 1;
+  for (unsigned int iPileup = 0; iPileup < numPileup; ++iPileup) {
+    unsigned int entry = std::min(static_cast<unsigned int>(m_flat() * m_numEntries), m_numEntries - 1);
+    int bunchCrossing = m_minBunchCrossing + std::min(static_cast<int>(m_flat() * numBunchCrossings),
+                                                      numBunchCrossings - 1);
+    double timeShift = bunchCrossing * m_bunchSpacing;
+    auto frame = podio::Frame(m_reader.readEntry(podio::Category::Event, entry, m_pileupCollections));
+    if (overlayCalo) {
+      for (const auto& hit : frame.get<edm4hep::SimCalorimeterHitCollection>(m_pileupCaloCollection)) {
+        if (!overlayContributions) {
+          // without the contributions, the whole deposit is assigned to the time of its bunch crossing
+          if (inCaloTimeWindow(timeShift)) {
+            auto mergedHit = cellHit(hit);
+            mergedHit.setEnergy(mergedHit.getEnergy() + hit.getEnergy());
+          }
+          continue;
+        }
+        float energy = 0;
+        bool inTimeWindow = false;
+        for (const auto& contribution : hit.getContributions()) {
+          if (inCaloTimeWindow(contribution.getTime() + timeShift)) {
+            energy += contribution.getEnergy();
+            inTimeWindow = true;
+          }
+        }
+        if (!inTimeWindow) {
+          continue;
+        }
+        auto mergedHit = cellHit(hit);
+        mergedHit.setEnergy(mergedHit.getEnergy() + energy);
+        for (const auto& contribution : hit.getContributions()) {
+          if (inCaloTimeWindow(contribution.getTime() + timeShift)) {
+            // the minimum-bias particles are not overlaid, so the contributions do not keep the relations to them
+            auto mergedContribution = contribution.clone(false);
+            mergedContribution.setTime(contribution.getTime() + timeShift);
+            mergedContributions->push_back(mergedContribution);
+            mergedHit.addToContributions(mergedContribution);
+          }
+        }
+      }
+    }
+    if (overlayTracker) {
+      for (const auto& hit : frame.get<edm4hep::SimTrackerHitCollection>(m_pileupTrackerCollection)) {
+        // the minimum-bias particles are not overlaid, so the hits do not keep the relations to them
+        auto mergedHit = hit.clone(false);
+        mergedHit.setTime(hit.getTime() + timeShift);
+        mergedHit.setOverlay(true);
+        mergedTrackerHits->push_back(mergedHit);
+      }
+    }
+  }
+  debug() << "Overlaid " << numPileup << " pile-up events" << endmsg;
+  return StatusCode::SUCCESS;
+}
+
+StatusCode SimG4OverlayPileupHits::finalize() { return Gaudi::Algorithm::finalize(); }
@@ -0,0 +1,125 @@
+#ifndef SIMG4COMPONENTS_SIMG4OVERLAYPILEUPHITS_H
+#define SIMG4COMPONENTS_SIMG4OVERLAYPILEUPHITS_H
+
+// Gaudi
+#include "Gaudi/Algorithm.h"
+#include "GaudiKernel/RndmGenerators.h"
+
+// FCCSW
+#include "k4FWCore/DataHandle.h"
+
+// podio
+#include "podio/ROOTReader.h"
+
+// STL
+#include <limits>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// datamodel
+namespace edm4hep {
+class CaloHitContributionCollection;
+class SimCalorimeterHitCollection;
+class SimTrackerHitCollection;
+} // namespace edm4hep
+
+/** @class SimG4OverlayPileupHits SimG4Components/src/SimG4OverlayPileupHits.h SimG4OverlayPileupHits.h
+ *
+ *  Overlay of pre-simulated minimum-bias hits on the hits of the signal event.
+ *  The minimum-bias events are read from the file '\b pileupFile' (EDM4hep, as written by SimG4SaveCalHits and
+ *  SimG4SaveTrackerHits), with random access to its entries.
+ *  For each signal event, '\b numPileupEvents' minimum-bias events (Poisson-distributed if '\b poissonPileup') are
+ *  drawn at random, each assigned to a bunch crossing between '\b minBunchCrossing' and '\b maxBunchCrossing'.
+ *  Calorimeter hits of the collection '\b pileupCaloCollection' are merged into the signal calorimeter hits,
+ *  summing the energies of hits with the same cellID. Only the pile-up deposits within the time window
+ *  ['\b minCaloTime', '\b maxCaloTime'] of the signal bunch crossing are added: the contributions of the collection
+ *  '\b pileupCaloContributionCollection' are shifted by their bunch crossing time and added if in the window, or if
+ *  that collection is not given, the whole hit is added if its bunch crossing time is in the window.
+ *  The contributions of the signal hits and of the added pile-up deposits are stored with the merged hits.
+ *  Tracker hits of the collection '\b pileupTrackerCollection' are appended to the signal tracker hits, flagged as
+ *  overlay, with their time shifted by the bunch crossing times '\b bunchSpacing'.
+ *  An empty collection name disables the overlay of that type, and its handles are not used.
+ *  Only the overlaid collections are read from the pile-up file; the initialization fails if one of them is not in
+ *  its first event or has another type.
+ *
+ *  [For more information please see](@ref md_sim_doc_geant4fullsim).
+ */
+
+class SimG4OverlayPileupHits : public Gaudi::Algorithm {
+public:
+  SimG4OverlayPileupHits(const std::string& aName, ISvcLocator* svcLoc);
+  /**  Initialize, opening the pile-up file and checking its collections.
+   *   @return status code
+   */
+  StatusCode initialize();
+  /**  Finalize.
+   *   @return status code
+   */
+  StatusCode finalize();
+  /**  Overlay the pile-up hits on the signal hits.
+   *   @return status code
+   */
+  StatusCode execute(const EventContext&) const;
+
+private:
+  /// Handle for the signal calorimeter hits
+  mutable k4FWCore::DataHandle<edm4hep::SimCalorimeterHitCollection> m_signalCaloHits{
+      "SignalCaloHits", Gaudi::DataHandle::Reader, this};
+  /// Handle for the calorimeter hits with the pile-up overlaid
+  mutable k4FWCore::DataHandle<edm4hep::SimCalorimeterHitCollection> m_mergedCaloHits{
+      "MergedCaloHits", Gaudi::DataHandle::Writer, this};
+  /// Handle for the contributions to the calorimeter hits with the pile-up overlaid
+  mutable k4FWCore::DataHandle<edm4hep::CaloHitContributionCollection> m_mergedCaloContributions{
+      "MergedCaloHitContributions", Gaudi::DataHandle::Writer, this};
+  /// Handle for the signal tracker hits
+  mutable k4FWCore::DataHandle<edm4hep::SimTrackerHitCollection> m_signalTrackerHits{
+      "SignalTrackerHits", Gaudi::DataHandle::Reader, this};
+  /// Handle for the tracker hits with the pile-up overlaid
+  mutable k4FWCore::DataHandle<edm4hep::SimTrackerHitCollection> m_mergedTrackerHits{
+      "MergedTrackerHits", Gaudi::DataHandle::Writer, this};
+  /// Reader of the pile-up file
+  mutable podio::ROOTReader m_reader;
+  /// Guards the reader and the random number generators
+  mutable std::mutex m_mutex;
+  /// Names of the collections read from the pile-up file
+  std::vector<std::string> m_pileupCollections;
+  /// Number of minimum-bias events in the pile-up file
+  unsigned int m_numEntries = 0;
+  /// Generator of the minimum-bias events
+  mutable Rndm::Numbers m_flat;
+  /// Generator of the number of pile-up events
+  mutable Rndm::Numbers m_poisson;
+  /// File with the minimum-bias events
+  Gaudi::Property<std::string> m_pileupFile{this, "pileupFile", "", "File with the minimum-bias events"};
+  /// Name of the calorimeter hits collection in the pile-up file (empty: no calorimeter overlay)
+  Gaudi::Property<std::string> m_pileupCaloCollection{this, "pileupCaloCollection", "",
+                                                      "Name of the calorimeter hits collection in the pile-up file"};
+  /// Name of the contributions to the calorimeter hits in the pile-up file (empty: deposits at the bunch crossing time)
+  Gaudi::Property<std::string> m_pileupCaloContributionCollection{
+      this, "pileupCaloContributionCollection", "",
+      "Name of the contributions to the calorimeter hits in the pile-up file"};
+  /// Name of the tracker hits collection in the pile-up file (empty: no tracker overlay)
+  Gaudi::Property<std::string> m_pileupTrackerCollection{this, "pileupTrackerCollection", "",
+                                                         "Name of the tracker hits collection in the pile-up file"};
+  /// Number of pile-up events per signal event (mean if Poisson-distributed)
+  Gaudi::Property<double> m_numPileupEvents{this, "numPileupEvents", 0,
+                                            "Number of pile-up events per signal event (mean if Poisson-distributed)"};
+  /// Flag to draw the number of pile-up events from a Poisson distribution
+  Gaudi::Property<bool> m_poissonPileup{this, "poissonPileup", false,
+                                        "Draw the number of pile-up events from a Poisson distribution"};
+  /// First bunch crossing of the pile-up events (relative to the signal one)
+  Gaudi::Property<int> m_minBunchCrossing{this, "minBunchCrossing", 0, "First bunch crossing of the pile-up events"};
+  /// Last bunch crossing of the pile-up events (relative to the signal one)
+  Gaudi::Property<int> m_maxBunchCrossing{this, "maxBunchCrossing", 0, "Last bunch crossing of the pile-up events"};
+  /// Start of the time window of the calorimeter pile-up deposits, relative to the signal bunch crossing (ns)
+  Gaudi::Property<double> m_minCaloTime{this, "minCaloTime", std::numeric_limits<double>::lowest(),
+                                        "Start of the time window of the calorimeter pile-up deposits (ns)"};
+  /// End of the time window of the calorimeter pile-up deposits, relative to the signal bunch crossing (ns)
+  Gaudi::Property<double> m_maxCaloTime{this, "maxCaloTime", std::numeric_limits<double>::max(),
+                                        "End of the time window of the calorimeter pile-up deposits (ns)"};
+  /// Time between the bunch crossings (ns)
+  Gaudi::Property<double> m_bunchSpacing{this, "bunchSpacing", 25, "Time between the bunch crossings (ns)"};
+};
+
+#endif /* SIMG4COMPONENTS_SIMG4OVERLAYPILEUPHITS_H */
@@ -12,7 +12,62 @@
 #include "edm4hep/MCParticleCollection.h"
 
 // Geant4
+#include "G4AffineTransform.hh"
 #include "G4Event.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Navigator.hh"
+#include "G4TransportationManager.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VSolid.hh"
+
+// STL
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+namespace {
+/// Position and time of a vertex, compared exactly
+using VertexKey = std::array<double, 4>;
+/// Hash of the bit patterns of the vertex coordinates
+struct VertexKeyHash {
+  size_t operator()(const VertexKey& aKey) const {
+    size_t hash = 0;
+    for (double coordinate : aKey) {
+      uint64_t bits;
+      std::memcpy(&bits, &coordinate, sizeof(bits));
+      hash ^= std::hash<uint64_t>()(bits) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+  }
+};
+
+/// Check if the half-line from the origin along the direction crosses the box {xmin, ymin, zmin, xmax, ymax, zmax}
+bool crossesBox(const std::array<double, 3>& aOrigin, const std::array<double, 3>& aDirection,
+                const std::array<double, 6>& aBox) {
+  double tMin = 0;
+  double tMax = std::numeric_limits<double>::max();
+  for (int iAxis = 0; iAxis < 3; ++iAxis) {
+    if (aDirection[iAxis] == 0) {
+      if (aOrigin[iAxis] < aBox[iAxis] || aOrigin[iAxis] > aBox[iAxis + 3]) {
+        return false;
+      }
+      continue;
+    }
+    double t1 = (aBox[iAxis] - aOrigin[iAxis]) / aDirection[iAxis];
+    double t2 = (aBox[iAxis + 3] - aOrigin[iAxis]) / aDirection[iAxis];
+    tMin = std::max(tMin, std::min(t1, t2));
+    tMax = std::min(tMax, std::max(t1, t2));
+    if (tMin > tMax) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
 
 // Declaration of the Tool
 DECLARE_COMPONENT(SimG4PrimariesFromEdmTool)
@@ -25,22 +80,225 @@ SimG4PrimariesFromEdmTool::SimG4PrimariesFromEdmTool(const std::string& type, co
 
 SimG4PrimariesFromEdmTool::~SimG4PrimariesFromEdmTool() {}
 
-StatusCode SimG4PrimariesFromEdmTool::initialize() { return AlgTool::initialize(); }
+StatusCode SimG4PrimariesFromEdmTool::initialize() {
+  if (m_minPt < 0 || m_maxAbsEta < 0) {
+    error() << "Transverse momentum and pseudorapidity cuts cannot be negative" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  return AlgTool::initialize();
+}
 
-G4Event* SimG4PrimariesFromEdmTool::g4Event() {
-  auto theEvent = new G4Event();
+StatusCode SimG4PrimariesFromEdmTool::finalize() {
+  uint64_t numRejected = 0;
+  for (auto num : m_numRejected) {
+    numRejected += num;
+  }
+  if (numRejected > 0) {
+    static const std::array<const char*, kNumSelections> names = {
+        "generator status", "vetoed PDG", "transverse momentum", "pseudorapidity", "no sensitive volume on path"};
+    info() << "Particles not passed to Geant4: " << numRejected << " out of " << m_numRead << endmsg;
+    for (int iSelection = 0; iSelection < kNumSelections; ++iSelection) {
+      info() << "  rejected by " << names[iSelection] << ": " << m_numRejected[iSelection] << endmsg;
+    }
+  }
+  return AlgTool::finalize();
+}
+
+bool SimG4PrimariesFromEdmTool::containsSensitive(const G4LogicalVolume* aVolume,
+                                                  std::unordered_map<const G4LogicalVolume*, bool>& aCache) {
+  auto cached = aCache.find(aVolume);
+  if (cached != aCache.end()) {
+    return cached->second;
+  }
+  bool sensitive = aVolume->GetSensitiveDetector() != nullptr;
+  for (size_t iDaughter = 0; !sensitive && iDaughter < aVolume->GetNoDaughters(); ++iDaughter) {
+    sensitive = containsSensitive(aVolume->GetDaughter(iDaughter)->GetLogicalVolume(), aCache);
+  }
+  aCache[aVolume] = sensitive;
+  return sensitive;
+}
+
+void SimG4PrimariesFromEdmTool::findSensitiveBoxes() {
+  m_sensitiveBoxesFound = true;
+  const G4VPhysicalVolume* world =
+      G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume();
+  if (world == nullptr) {
+    warning() << "World volume not found, particles are not checked against the sensitive volumes" << endmsg;
+    return;
+  }
+  const G4LogicalVolume* worldVolume = world->GetLogicalVolume();
+  std::unordered_map<const G4LogicalVolume*, bool> cache;
+  bool sensitiveWorld = worldVolume->GetSensitiveDetector() != nullptr;
+  for (size_t iDaughter = 0; !sensitiveWorld && iDaughter < worldVolume->GetNoDaughters(); ++iDaughter) {
+    const G4VPhysicalVolume* daughter = worldVolume->GetDaughter(iDaughter);
+    if (!containsSensitive(daughter->GetLogicalVolume(), cache)) {
+      continue;
+    }
+    if (daughter->IsReplicated()) {
+      // replicas fill their mother volume
+      sensitiveWorld = true;
+      break;
+    }
+    G4ThreeVector localMin, localMax;
+    daughter->GetLogicalVolume()->GetSolid()->BoundingLimits(localMin, localMax);
+    G4AffineTransform transform(daughter->GetObjectRotationValue(), daughter->GetObjectTranslation());
+    Box box = {std::numeric_limits<double>::max(),    std::numeric_limits<double>::max(),
+               std::numeric_limits<double>::max(),    std::numeric_limits<double>::lowest(),
+               std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
+    for (int iCorner = 0; iCorner < 8; ++iCorner) {
+      G4ThreeVector corner = transform.TransformPoint(G4ThreeVector(
+          (iCorner & 1) ? localMax.x() : localMin.x(), (iCorner & 2) ? localMax.y() : localMin.y(),
+          (iCorner & 4) ? localMax.z() : localMin.z()));
+      for (int iAxis = 0; iAxis < 3; ++iAxis) {
+        box[iAxis] = std::min(box[iAxis], corner[iAxis]);
+        box[iAxis + 3] = std::max(box[iAxis + 3], corner[iAxis]);
+      }
+    }
+    m_sensitiveBoxes.push_back(box);
+  }
+  if (sensitiveWorld || m_sensitiveBoxes.empty()) {
+    warning() << "Sensitive volumes are not contained in the world daughters, particles are not checked against them"
+              << endmsg;
+    m_sensitiveBoxes.clear();
+    return;
+  }
+  debug() << "Found " << m_sensitiveBoxes.size() << " world daughters with sensitive volumes" << endmsg;
+}
+
+void SimG4PrimariesFromEdmTool::selectParticles(const edm4hep::MCParticleCollection& aParticles,
+                                                std::vector<uint8_t>& aRejected) {
+  const size_t numParticles = aParticles.size();
+  const std::vector<int>& statuses = m_generatorStatuses;
+  const std::vector<int>& vetoPdgs = m_vetoPdgs;
+  aRejected.assign(numParticles, 0);
+  m_px.resize(numParticles);
+  m_py.resize(numParticles);
+  m_pz.resize(numParticles);
+  m_charge.resize(numParticles);
+  // gather the kinematics and evaluate the selections on the discrete quantities
+  for (size_t i = 0; i < numParticles; ++i) {
+    const auto mcparticle = aParticles[i];
+    const auto& mom = mcparticle.getMomentum();
+    m_px[i] = mom.x;
+    m_py[i] = mom.y;
+    m_pz[i] = mom.z;
+    m_charge[i] = mcparticle.getCharge();
+    if (!statuses.empty() &&
+        std::find(statuses.begin(), statuses.end(), mcparticle.getGeneratorStatus()) == statuses.end()) {
+      aRejected[i] = kStatus + 1;
+    } else if (!vetoPdgs.empty() &&
+               std::find(vetoPdgs.begin(), vetoPdgs.end(), mcparticle.getPDG()) != vetoPdgs.end()) {
+      aRejected[i] = kPdg + 1;
+    }
+  }
+  // kinematic selections, without branches
+  const double minPt2 = m_minPt * m_minPt;
+  const double sinhMaxEta = (m_maxAbsEta > 0) ? std::sinh(m_maxAbsEta.value()) : 0;
+  const double* px = m_px.data();
+  const double* py = m_py.data();
+  const double* pz = m_pz.data();
+  uint8_t* rejected = aRejected.data();
+  for (size_t i = 0; i < numParticles; ++i) {
+    const double pt2 = px[i] * px[i] + py[i] * py[i];
+    const uint8_t failPt = pt2 < minPt2;
+    // |eta| > etaMax <=> |pz| > pT sinh(etaMax)
+    const uint8_t failEta = (sinhMaxEta > 0) & (pz[i] * pz[i] > pt2 * sinhMaxEta * sinhMaxEta);
+    rejected[i] = (rejected[i] == 0) ? (failPt ? kPt + 1 : (failEta ? kEta + 1 : 0)) : rejected[i];
+  }
+  if (m_dropMissingSensitive) {
+    if (!m_sensitiveBoxesFound) {
+      findSensitiveBoxes();
+    }
+    if (!m_sensitiveBoxes.empty()) {
+      for (size_t i = 0; i < numParticles; ++i) {
+        if (aRejected[i] != 0 || m_charge[i] != 0) {
+          continue;
+        }
+        const auto& v = aParticles[i].getVertex();
+        const std::array<double, 3> origin = {v.x * sim::edm2g4::length, v.y * sim::edm2g4::length,
+                                              v.z * sim::edm2g4::length};
+        const std::array<double, 3> direction = {px[i], py[i], pz[i]};
+        bool crosses = false;
+        for (const auto& box : m_sensitiveBoxes) {
+          if (crossesBox(origin, direction, box)) {
+            crosses = true;
+            break;
+          }
+        }
+        if (!crosses) {
+          aRejected[i] = kSensitive + 1;
+        }
+      }
+    }
+  }
+  m_numRead += numParticles;
+  for (size_t i = 0; i < numParticles; ++i) {
+    if (aRejected[i] != 0) {
+      ++m_numRejected[aRejected[i] - 1];
+    }
+  }
+}
+
+std::vector<G4PrimaryVertex*> SimG4PrimariesFromEdmTool::primaryVertices() {
   const edm4hep::MCParticleCollection* mcparticles = m_genParticles.get();
-  for (auto mcparticle : *mcparticles) {
+  std::vector<uint8_t> rejected;
+  selectParticles(*mcparticles, rejected);
+  std::vector<G4PrimaryVertex*> g4Vertices;
+  std::unordered_map<VertexKey, G4PrimaryVertex*, VertexKeyHash> vertices;
+  vertices.reserve(mcparticles->size());
+  for (size_t iParticle = 0; iParticle < mcparticles->size(); ++iParticle) {
+    if (rejected[iParticle] != 0) {
+      continue;
+    }
+    const auto mcparticle = (*mcparticles)[iParticle];
     const auto& v = mcparticle.getVertex();
-    auto* g4Vertex =
-        new G4PrimaryVertex(v.x * sim::edm2g4::length, v.y * sim::edm2g4::length, v.z * sim::edm2g4::length,
-                            mcparticle.getTime() / Gaudi::Units::c_light * sim::edm2g4::length);
+    VertexKey key{v.x * sim::edm2g4::length, v.y * sim::edm2g4::length, v.z * sim::edm2g4::length,
+                  mcparticle.getTime() / Gaudi::Units::c_light * sim::edm2g4::length};
+    auto& g4Vertex = vertices[key];
+    if (g4Vertex == nullptr) {
+      g4Vertex = new G4PrimaryVertex(key[0], key[1], key[2], key[3]);
+      g4Vertices.push_back(g4Vertex);
+    }
     const auto& mom = mcparticle.getMomentum();
     auto* g4Particle = new G4PrimaryParticle(mcparticle.getPDG(), mom.x * sim::edm2g4::energy,
                                              mom.y * sim::edm2g4::energy, mom.z * sim::edm2g4::energy);
     g4Particle->SetUserInformation(new sim::ParticleInformation(mcparticle));
     g4Vertex->SetPrimary(g4Particle);
+  }
+  return g4Vertices;
+}
+
+G4Event* SimG4PrimariesFromEdmTool::g4Event() {
+  auto theEvent = new G4Event();
+  for (auto* g4Vertex : primaryVertices()) {
     theEvent->AddPrimaryVertex(g4Vertex);
   }
   return theEvent;
 }
+
+std::vector<G4Event*> SimG4PrimariesFromEdmTool::g4SubEvents(size_t aMaxSubEvents) {
+  std::vector<G4PrimaryVertex*> g4Vertices = primaryVertices();
+  size_t numParticles = 0;
+  for (const auto* g4Vertex : g4Vertices) {
+    numParticles += g4Vertex->GetNumberOfParticle();
+  }
+  size_t numSubEvents = std::min({std::max<size_t>(aMaxSubEvents, 1), g4Vertices.size(),
+                                  std::max<size_t>(numParticles / std::max<size_t>(m_minParticlesPerSubEvent, 1), 1)});
+  std::vector<G4Event*> subEvents(std::max<size_t>(numSubEvents, 1));
+  for (auto& subEvent : subEvents) {
+    subEvent = new G4Event();
+  }
+  // vertices are kept whole; the largest ones are assigned first, each to the sub-event with the fewest particles
+  std::stable_sort(g4Vertices.begin(), g4Vertices.end(), [](const G4PrimaryVertex* a, const G4PrimaryVertex* b) {
+    return a->GetNumberOfParticle() > b->GetNumberOfParticle();
+  });
+  std::vector<size_t> subEventParticles(subEvents.size(), 0);
+  for (auto* g4Vertex : g4Vertices) {
+    size_t iSubEvent = std::min_element(subEventParticles.begin(), subEventParticles.end()) - subEventParticles.begin();
+    subEvents[iSubEvent]->AddPrimaryVertex(g4Vertex);
+    subEventParticles[iSubEvent] += g4Vertex->GetNumberOfParticle();
+  }
+  debug() << "Event with " << numParticles << " primary particles split into " << subEvents.size() << " sub-events"
+          << endmsg;
+  return subEvents;
+}
@@ -8,6 +8,14 @@
 #include "SimG4Interface/ISimG4EventProviderTool.h"
 
 #include "G4VUserPrimaryGeneratorAction.hh"
+class G4PrimaryVertex;
+class G4LogicalVolume;
+
+// STL
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
 
 // Forward declarations
 // datamodel
@@ -18,6 +26,18 @@ class MCParticleCollection;
 /** @class SimG4PrimariesFromEdmTool SimG4PrimariesFromEdmTool.h "SimG4PrimariesFromEdmTool.h"
  *
  *  Tool to translate an EDM MCParticleCollection into a G4Event
+ *  Particles produced at the same vertex (identical x, y, z and t) share one G4PrimaryVertex.
+ *  If generator statuses are given (\b'generatorStatuses'), only particles with one of these statuses (e.g. 1 for the
+ *  final state) are passed to Geant4, intermediate particles are skipped.
+ *  Particles that cannot leave a hit can be filtered out before the G4Event is built: PDG codes to be vetoed
+ *  (\b'vetoPDGs', e.g. neutrinos), minimum transverse momentum (\b'minPt') and maximum |eta| (\b'maxAbsEta').
+ *  These selections are evaluated in one pass over arrays holding the kinematics of all the particles.
+ *  Optionally (\b'dropMissingSensitive') neutral particles whose straight line from the production vertex misses the
+ *  bounding boxes of all the world daughters containing a sensitive volume are dropped as well. Charged particles are
+ *  bent by the magnetic field and are never dropped by this check.
+ *  The numbers of particles removed by each selection are printed at finalize.
+ *  The event can be split into sub-events (for very high multiplicity events), keeping the particles of one vertex
+ *  together and balancing the number of particles, with at least '\b minParticlesPerSubEvent' particles per sub-event.
  *
  *  @author A. Zaborowska, J. Lingemann, A. Dell'Acqua
  *  @date   2016-01-11
@@ -31,14 +51,68 @@ public:
 
   StatusCode initialize() final;
 
+  StatusCode finalize() final;
+
   /// Translates the input (edm4hep::MCParticleCollection) into a G4Event
   /// @returns G4Event with primaries generated from MCParticleCollection (ownership is transferred to the caller)
   virtual G4Event* g4Event() final;
 
+  /// Translates the input (edm4hep::MCParticleCollection) into several G4Events, splitting the primary vertices
+  /// @param[in] aMaxSubEvents Maximum number of sub-events.
+  /// @returns G4Events with primaries generated from MCParticleCollection (ownership is transferred to the caller)
+  virtual std::vector<G4Event*> g4SubEvents(size_t aMaxSubEvents) final;
+
 private:
+  /// Create the primary vertices with their particles, not attached to any event
+  /// @returns primary vertices (ownership is transferred to the caller)
+  std::vector<G4PrimaryVertex*> primaryVertices();
+  /// Selections applied to the particles, in the order in which the rejected particles are counted
+  enum Selection { kStatus = 0, kPdg, kPt, kEta, kSensitive, kNumSelections };
+  /// Axis-aligned box, in global coordinates (mm), stored as {xmin, ymin, zmin, xmax, ymax, zmax}
+  using Box = std::array<double, 6>;
+  /** Evaluate all the selections on the particles of the collection.
+   *  @param[in] aParticles Generated particles.
+   *  @param[out] aRejected For each particle of the collection 0 if passed to Geant4, otherwise 1 + the first failed
+   *  selection.
+   */
+  void selectParticles(const edm4hep::MCParticleCollection& aParticles, std::vector<uint8_t>& aRejected);
+  /// Find the bounding boxes of the world daughters containing a sensitive volume (geometry must be constructed)
+  void findSensitiveBoxes();
+  /** Check if the logical volume or any of its daughters has a sensitive detector.
+   *  @param[in] aVolume Logical volume.
+   *  @param aCache Results of the volumes already checked.
+   *  @return true if a sensitive volume is found in the volume tree.
+   */
+  bool containsSensitive(const G4LogicalVolume* aVolume, std::unordered_map<const G4LogicalVolume*, bool>& aCache);
   /// Handle for the EDM MC particles to be read
   mutable k4FWCore::DataHandle<edm4hep::MCParticleCollection> m_genParticles{"GenParticles", Gaudi::DataHandle::Reader,
                                                                              this};
+  /// Generator statuses of the particles passed to Geant4 (empty: all particles)
+  Gaudi::Property<std::vector<int>> m_generatorStatuses{
+      this, "generatorStatuses", {}, "Generator statuses of the particles passed to Geant4 (empty: all particles)"};
+  /// Minimum number of primary particles per sub-event, when the event is split
+  Gaudi::Property<size_t> m_minParticlesPerSubEvent{this, "minParticlesPerSubEvent", 1000,
+                                                    "Minimum number of primary particles per sub-event"};
+  /// PDG codes of the particles which are not passed to Geant4
+  Gaudi::Property<std::vector<int>> m_vetoPdgs{this, "vetoPDGs", {}, "PDG codes of the particles not passed to Geant4"};
+  /// Minimum transverse momentum of the particles passed to Geant4 (0: no cut)
+  Gaudi::Property<double> m_minPt{this, "minPt", 0, "Minimum transverse momentum [GeV] (0: no cut)"};
+  /// Maximum absolute pseudorapidity of the particles passed to Geant4 (0: no cut)
+  Gaudi::Property<double> m_maxAbsEta{this, "maxAbsEta", 0, "Maximum absolute pseudorapidity (0: no cut)"};
+  /// Flag to drop the neutral particles whose straight line misses all the world daughters with sensitive volumes
+  Gaudi::Property<bool> m_dropMissingSensitive{
+      this, "dropMissingSensitive", false,
+      "Drop neutral particles whose straight line misses all the world daughters with sensitive volumes"};
+  /// Bounding boxes of the world daughters containing a sensitive volume
+  std::vector<Box> m_sensitiveBoxes;
+  /// Flag set once the bounding boxes are computed
+  bool m_sensitiveBoxesFound = false;
+  /// Number of particles read from the input
+  uint64_t m_numRead = 0;
+  /// Number of particles rejected by each selection (each particle counted once, by the first failed selection)
+  std::array<uint64_t, kNumSelections> m_numRejected{};
+  /// Kinematics of the particles of the event, kept between events to avoid reallocation
+  std::vector<double> m_px, m_py, m_pz, m_charge;
 };
 
 #endif
@@ -1,6 +1,7 @@
 #include "SimG4SaveCalHits.h"
 
 // k4SimGeant4
+#include "SimG4Common/EventInformation.h"
 #include "SimG4Common/Geant4CaloHit.h"
 #include "SimG4Common/Units.h"
 
@@ -9,6 +10,7 @@
 
 // Geant4
 #include "G4Event.hh"
+#include "G4HCofThisEvent.hh"
 
 // DD4hep
 #include "DD4hep/Detector.h"
@@ -20,6 +22,8 @@ SimG4SaveCalHits::SimG4SaveCalHits(const std::string& aType, const std::string&
     : AlgTool(aType, aName, aParent), m_geoSvc("GeoSvc", aName) {
   declareInterface<ISimG4SaveOutputTool>(this);
   declareProperty("CaloHits", m_caloHits, "Handle for calo hits");
+  declareProperty("FirstTrackContributions", m_contributions,
+                  "Handle for the contributions to the calo hits, attributed to the first track of each Geant4 hit");
   declareProperty("GeoSvc", m_geoSvc);
 }
 
@@ -89,32 +93,90 @@ StatusCode SimG4SaveCalHits::finalize() { return AlgTool::finalize(); }
 
 StatusCode SimG4SaveCalHits::saveOutput(const G4Event& aEvent) {
   G4HCofThisEvent* collections = aEvent.GetHCofThisEvent();
-  G4VHitsCollection* collect;
-  k4::Geant4CaloHit* hit;
   if (collections != nullptr) {
     auto edmHits = m_caloHits.createAndPut();
-    for (int iter_coll = 0; iter_coll < collections->GetNumberOfCollections(); iter_coll++) {
-      collect = collections->GetHC(iter_coll);
-      if (m_readoutName == collect->GetName()) {
-        size_t n_hit = collect->GetSize();
-        debug() << "\t" << n_hit << " hits are stored in a collection #" << iter_coll << ": " << collect->GetName()
-                << endmsg;
-        for (size_t iter_hit = 0; iter_hit < n_hit; iter_hit++) {
-          hit = dynamic_cast<k4::Geant4CaloHit*>(collect->GetHit(iter_hit));
-          auto edmHit = edmHits->create();
-          edmHit.setCellID(hit->cellID);
-          // todo
-          // edmHitCore.bits = hit->trackId;
-          edmHit.setEnergy(hit->energyDeposit * sim::g42edm::energy);
-          edmHit.setPosition({
-              (float)hit->position.x() * (float)sim::g42edm::length,
-              (float)hit->position.y() * (float)sim::g42edm::length,
-              (float)hit->position.z() * (float)sim::g42edm::length,
-          });
+    auto contributions = m_saveContributions ? m_contributions.createAndPut() : nullptr;
+    saveHits(*collections, *edmHits, contributions,
+             dynamic_cast<const sim::EventInformation*>(aEvent.GetUserInformation()));
+  }
+
+  return StatusCode::SUCCESS;
+}
+
+StatusCode SimG4SaveCalHits::saveSubEventOutput(const G4Event& aEvent, size_t aSubEvent, int) {
+  if (aSubEvent == 0) {
+    m_subEventHits = m_caloHits.createAndPut();
+    m_subEventContributions = m_saveContributions ? m_contributions.createAndPut() : nullptr;
+  }
+  if (m_subEventHits == nullptr) {
+    error() << "Sub-event " << aSubEvent << " saved before the first sub-event of the event" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  G4HCofThisEvent* collections = aEvent.GetHCofThisEvent();
+  if (collections != nullptr) {
+    saveHits(*collections, *m_subEventHits, m_subEventContributions,
+             dynamic_cast<const sim::EventInformation*>(aEvent.GetUserInformation()));
+  }
+  return StatusCode::SUCCESS;
+}
+
+void SimG4SaveCalHits::saveHits(G4HCofThisEvent& aCollections, edm4hep::SimCalorimeterHitCollection& aEdmHits,
+                                edm4hep::CaloHitContributionCollection* aContributions,
+                                const sim::EventInformation* aHistory) {
+  G4VHitsCollection* collect;
+  k4::Geant4CaloHit* hit;
+  const edm4hep::MCParticleCollection* particles = (aHistory != nullptr) ? aHistory->savedParticles() : nullptr;
+  if (aContributions != nullptr && aHistory != nullptr && particles == nullptr && !m_warnedHistoryOrder) {
+    warning() << "Particle history is not saved before the hits, contributions are not linked to the particles. "
+              << "Place SimG4SaveParticleHistory before this tool in the outputs of SimG4Alg." << endmsg;
+    m_warnedHistoryOrder = true;
+  }
+  // one contribution per Geant4 hit, linked to the particle of the track which created the Geant4 hit
+  auto addContribution = [&](edm4hep::MutableSimCalorimeterHit& aEdmHit, const k4::Geant4CaloHit& aHit,
+                             double aEnergy) {
+    if (aContributions == nullptr) {
+      return;
+    }
+    auto contribution = aContributions->create();
+    contribution.setPDG(aHit.pdgId);
+    contribution.setEnergy(aEnergy);
+    contribution.setTime(aHit.time);
+    contribution.setStepPosition({
+        (float)aHit.position.x() * (float)sim::g42edm::length,
+        (float)aHit.position.y() * (float)sim::g42edm::length,
+        (float)aHit.position.z() * (float)sim::g42edm::length,
+    });
+    if (particles != nullptr) {
+      int32_t particle = aHistory->particleIndex(aHit.trackId);
+      if (particle >= 0) {
+        contribution.setParticle((*particles)[particle]);
+      }
+    }
+    aEdmHit.addToContributions(contribution);
+  };
+  for (int iter_coll = 0; iter_coll < aCollections.GetNumberOfCollections(); iter_coll++) {
+    collect = aCollections.GetHC(iter_coll);
+    if (m_readoutName == collect->GetName()) {
+      size_t n_hit = collect->GetSize();
+      debug() << "\t" << n_hit << " hits are stored in a collection #" << iter_coll << ": " << collect->GetName()
+              << endmsg;
+      for (size_t iter_hit = 0; iter_hit < n_hit; iter_hit++) {
+        hit = dynamic_cast<k4::Geant4CaloHit*>(collect->GetHit(iter_hit));
+        // tracks surviving a Russian roulette carry a weight
+        double energy = hit->energyDeposit * sim::g42edm::energy;
+        if (aHistory != nullptr) {
+          energy *= aHistory->trackWeight(hit->trackId);
         }
+        auto edmHit = aEdmHits.create();
+        edmHit.setCellID(hit->cellID);
+        edmHit.setEnergy(energy);
+        edmHit.setPosition({
+            (float)hit->position.x() * (float)sim::g42edm::length,
+            (float)hit->position.y() * (float)sim::g42edm::length,
+            (float)hit->position.z() * (float)sim::g42edm::length,
+        });
+        addContribution(edmHit, *hit, energy);
       }
     }
   }
-
-  return StatusCode::SUCCESS;
 }
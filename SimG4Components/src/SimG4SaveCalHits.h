@@ -14,9 +14,17 @@
 #include "SimG4Interface/ISimG4SaveOutputTool.h"
 
 // EDM4hep
+#include "edm4hep/CaloHitContributionCollection.h"
 #include "edm4hep/Constants.h"
 #include "edm4hep/SimCalorimeterHitCollection.h"
 
+// Geant
+class G4HCofThisEvent;
+
+namespace sim {
+class EventInformation;
+}
+
 /** @class SimG4SaveCalHits SimG4Components/src/SimG4SaveCalHits.h SimG4SaveCalHits.h
  *
  *  \brief Save calorimeter hits tool.
@@ -35,6 +43,24 @@
  *  If the more than one readout names is provided through the deprecated
  *  `readoutNames` parameter, the tool will fail at initialization.
  *
+ *  When the event is simulated in sub-events, the hits of all the sub-events
+ *  are saved in one collection, as for an event simulated at once.
+ *
+ *  If \b'saveFirstTrackContributions' is set, each Geant4 hit is also saved as a contribution
+ *  (`CaloHitContribution`) of the EDM hit of its cell, in the collection of \b'FirstTrackContributions'.
+ *  The Geant4 calorimeter hits only keep the track which created them, so the whole energy of a Geant4 hit is
+ *  attributed to that track: exactly per track with sensitive detectors creating one hit per step
+ *  (e.g. SimpleCalorimeterSD), but only to the first track entering the cell with the ones aggregating the steps
+ *  of a cell (e.g. AggregateCalorimeterSD).
+ *  If the particle history is saved (by `SimG4SaveParticleHistory`, which must
+ *  precede this tool in the list of outputs), each contribution is linked to the particle
+ *  of that track, or to its closest saved ancestor if that particle was not saved.
+ *
+ *  The deposited energy is multiplied by the weight of the track recorded in the event information (e.g. by the
+ *  Russian roulette of `SimG4FullSimActions`). The weight of a Geant4 hit is the one of its track, hence exact
+ *  weighting requires sensitive detectors creating one hit per step: `SimG4FullSimActions` rejects the roulette
+ *  with sensitive detectors aggregating the cells.
+ *
  *  [For more information please see](@ref md_sim_doc_geant4fullsim).
  *
  *  @author Anna Zaborowska
@@ -59,18 +85,50 @@ public:
    *   @return status code
    */
   virtual StatusCode saveOutput(const G4Event& aEvent) final;
+  /**  The tool merges the hits of the sub-events of a split event.
+   *   @return true
+   */
+  virtual bool mergesSubEvents() const final { return true; }
+  /**  Save the hits of a sub-event, appending them to the hits of the previous sub-events.
+   *   @param[in] aEvent Sub-event with data to save.
+   *   @param[in] aSubEvent Index of the sub-event.
+   *   @return status code
+   */
+  virtual StatusCode saveSubEventOutput(const G4Event& aEvent, size_t aSubEvent, int) final;
 
 private:
+  /**  Convert the hits of the readout to EDM hits.
+   *   @param[in] aCollections Hits collections of the event.
+   *   @param[out] aEdmHits EDM hits to be filled.
+   *   @param[out] aContributions Contributions to be filled (not saved if nullptr).
+   *   @param[in] aHistory Particle history of the event, used to link the contributions to the particles and to
+   *   weight the energy by the weights of the tracks (may be nullptr).
+   */
+  void saveHits(G4HCofThisEvent& aCollections, edm4hep::SimCalorimeterHitCollection& aEdmHits,
+                edm4hep::CaloHitContributionCollection* aContributions, const sim::EventInformation* aHistory);
   /// Pointer to the geometry service
   ServiceHandle<IGeoSvc> m_geoSvc;
   /// Output handle for calo hits
   mutable k4FWCore::DataHandle<edm4hep::SimCalorimeterHitCollection> m_caloHits{"CaloHits", Gaudi::DataHandle::Writer,
                                                                                 this};
+  /// Output handle for the contributions of the Geant4 hits to the calo hits, attributed to their first track
+  mutable k4FWCore::DataHandle<edm4hep::CaloHitContributionCollection> m_contributions{
+      "FirstTrackContributions", Gaudi::DataHandle::Writer, this};
+  /// Flag to save the contributions of the Geant4 hits to the calo hits
+  Gaudi::Property<bool> m_saveContributions{
+      this, "saveFirstTrackContributions", false,
+      "Save the contributions of the Geant4 hits to the calo hits, attributed to the first track of each Geant4 hit"};
   /// Name of the readouts (hits collections) to save, deprecated
   Gaudi::Property<std::vector<std::string>> m_readoutNames{
       this, "readoutNames", {}, "[Deprecated] Names of the readouts (hits collections) to save"};
   /// Name of the readout (hits collection) to save
   Gaudi::Property<std::string> m_readoutName{this, "readoutName", {}, "Name of the readout (hits collection) to save"};
+  /// Output collection of the event being simulated in sub-events (owned by the event store)
+  edm4hep::SimCalorimeterHitCollection* m_subEventHits = nullptr;
+  /// Contributions of the event being simulated in sub-events (owned by the event store)
+  edm4hep::CaloHitContributionCollection* m_subEventContributions = nullptr;
+  /// Flag set once the user is warned that the particle history is saved after the hits
+  bool m_warnedHistoryOrder = false;
 };
 
 #endif /* SIMG4COMPONENTS_G4SAVECALHITS_H */
@@ -31,3 +31,18 @@ StatusCode SimG4SaveParticleHistory::saveOutput(const G4Event& aEvent) {
 
   return StatusCode::SUCCESS;
 }
+
+StatusCode SimG4SaveParticleHistory::saveSubEventOutput(const G4Event& aEvent, size_t aSubEvent,
+                                                        int aTrackIdOffset) {
+  if (aSubEvent == 0) {
+    return saveOutput(aEvent);
+  }
+  auto evtinfo = dynamic_cast<sim::EventInformation*>(aEvent.GetUserInformation());
+  // move the particles of the sub-event to the collection of the event, where the hits can be linked to them
+  const size_t numSaved = m_mcParticleColl->size();
+  evtinfo->moveParticlesTo(*m_mcParticleColl, aTrackIdOffset);
+  const size_t numSubEventParticles = m_mcParticleColl->size() - numSaved;
+  debug() << "Saved " << numSubEventParticles << " particles from Geant4 history of sub-event " << aSubEvent << endmsg;
+
+  return StatusCode::SUCCESS;
+}
@@ -39,6 +39,18 @@ public:
    *   @return status code
    */
   StatusCode saveOutput(const G4Event& aEvent) override final;
+  /**  The tool merges the history of the sub-events of a split event.
+   *   @return true
+   */
+  bool mergesSubEvents() const override final { return true; }
+  /**  Save the history of a sub-event, appending its particles to the ones of the previous sub-events.
+   *   The Geant4 track IDs (simulator status) of the sub-event are offset.
+   *   @param[in] aEvent Sub-event with data to save.
+   *   @param[in] aSubEvent Index of the sub-event.
+   *   @param[in] aTrackIdOffset Offset added to the track IDs of the sub-event.
+   *   @return status code
+   */
+  StatusCode saveSubEventOutput(const G4Event& aEvent, size_t aSubEvent, int aTrackIdOffset) override final;
 
 private:
   /// Handle for collection of MC particles to create
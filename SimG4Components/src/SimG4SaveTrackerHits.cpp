@@ -1,6 +1,7 @@
 #include "SimG4SaveTrackerHits.h"
 
 // k4SimGeant4
+#include "SimG4Common/EventInformation.h"
 #include "SimG4Common/Geant4PreDigiTrackHit.h"
 #include "SimG4Common/Units.h"
 
@@ -9,6 +10,7 @@
 
 // Geant4
 #include "G4Event.hh"
+#include "G4HCofThisEvent.hh"
 
 // DD4hep
 #include "DD4hep/Detector.h"
@@ -95,40 +97,78 @@ StatusCode SimG4SaveTrackerHits::finalize() { return AlgTool::finalize(); }
 
 StatusCode SimG4SaveTrackerHits::saveOutput(const G4Event& aEvent) {
   G4HCofThisEvent* collections = aEvent.GetHCofThisEvent();
-  G4VHitsCollection* collect;
-  k4::Geant4PreDigiTrackHit* hit;
   if (collections != nullptr) {
     edm4hep::SimTrackerHitCollection* edmHits = m_trackHits.createAndPut();
-    for (int iter_coll = 0; iter_coll < collections->GetNumberOfCollections(); iter_coll++) {
-      collect = collections->GetHC(iter_coll);
-      if (m_readoutName == collect->GetName()) {
-        size_t n_hit = collect->GetSize();
-        verbose() << "\t" << n_hit << " hits are stored in a tracker collection #" << iter_coll << ": "
-                  << collect->GetName() << endmsg;
-        for (size_t iter_hit = 0; iter_hit < n_hit; iter_hit++) {
-          hit = dynamic_cast<k4::Geant4PreDigiTrackHit*>(collect->GetHit(iter_hit));
-          auto edmHit = edmHits->create();
-          edmHit.setCellID(hit->cellID);
-          edmHit.setEDep(hit->energyDeposit * sim::g42edm::energy);
-          /// workaround, store trackid in an unrelated field
-          edmHit.setQuality(hit->trackId);
-          edmHit.setTime(hit->time);
-          edmHit.setPosition({
-              hit->prePos.x() * sim::g42edm::length,
-              hit->prePos.y() * sim::g42edm::length,
-              hit->prePos.z() * sim::g42edm::length,
-          });
-          CLHEP::Hep3Vector diff = hit->postPos - hit->prePos;
-          edmHit.setMomentum({
-              (float)(diff.x() * sim::g42edm::length),
-              (float)(diff.y() * sim::g42edm::length),
-              (float)(diff.z() * sim::g42edm::length),
-          });
-          edmHit.setPathLength(diff.mag());
+    saveHits(*collections, *edmHits, 0, dynamic_cast<const sim::EventInformation*>(aEvent.GetUserInformation()));
+  }
+
+  return StatusCode::SUCCESS;
+}
+
+StatusCode SimG4SaveTrackerHits::saveSubEventOutput(const G4Event& aEvent, size_t aSubEvent, int aTrackIdOffset) {
+  if (aSubEvent == 0) {
+    m_subEventHits = m_trackHits.createAndPut();
+  }
+  if (m_subEventHits == nullptr) {
+    error() << "Sub-event " << aSubEvent << " saved before the first sub-event of the event" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  G4HCofThisEvent* collections = aEvent.GetHCofThisEvent();
+  if (collections != nullptr) {
+    saveHits(*collections, *m_subEventHits, aTrackIdOffset,
+             dynamic_cast<const sim::EventInformation*>(aEvent.GetUserInformation()));
+  }
+  return StatusCode::SUCCESS;
+}
+
+void SimG4SaveTrackerHits::saveHits(G4HCofThisEvent& aCollections, edm4hep::SimTrackerHitCollection& aEdmHits,
+                                    int aTrackIdOffset, const sim::EventInformation* aHistory) {
+  G4VHitsCollection* collect;
+  k4::Geant4PreDigiTrackHit* hit;
+  const edm4hep::MCParticleCollection* particles = (aHistory != nullptr) ? aHistory->savedParticles() : nullptr;
+  if (aHistory != nullptr && particles == nullptr && !m_warnedHistoryOrder) {
+    warning() << "Particle history is not saved before the hits, hits are not linked to the particles. "
+              << "Place SimG4SaveParticleHistory before this tool in the outputs of SimG4Alg." << endmsg;
+    m_warnedHistoryOrder = true;
+  }
+  for (int iter_coll = 0; iter_coll < aCollections.GetNumberOfCollections(); iter_coll++) {
+    collect = aCollections.GetHC(iter_coll);
+    if (m_readoutName == collect->GetName()) {
+      size_t n_hit = collect->GetSize();
+      verbose() << "\t" << n_hit << " hits are stored in a tracker collection #" << iter_coll << ": "
+                << collect->GetName() << endmsg;
+      for (size_t iter_hit = 0; iter_hit < n_hit; iter_hit++) {
+        hit = dynamic_cast<k4::Geant4PreDigiTrackHit*>(collect->GetHit(iter_hit));
+        auto edmHit = aEdmHits.create();
+        edmHit.setCellID(hit->cellID);
+        // tracks surviving a Russian roulette carry a weight
+        double energy = hit->energyDeposit * sim::g42edm::energy;
+        if (aHistory != nullptr) {
+          energy *= aHistory->trackWeight(hit->trackId);
+        }
+        edmHit.setEDep(energy);
+        /// workaround, store trackid in an unrelated field (kept for the readers not using the particle link)
+        edmHit.setQuality(hit->trackId + aTrackIdOffset);
+        if (particles != nullptr) {
+          int32_t particle = aHistory->particleIndex(hit->trackId);
+          if (particle >= 0) {
+            edmHit.setParticle((*particles)[particle]);
+          }
         }
+        edmHit.setTime(hit->time);
+        edmHit.setPosition({
+            hit->prePos.x() * sim::g42edm::length,
+            hit->prePos.y() * sim::g42edm::length,
+            hit->prePos.z() * sim::g42edm::length,
+        });
+        CLHEP::Hep3Vector diff = hit->postPos - hit->prePos;
+        edmHit.setMomentum({
+            (float)(diff.x() * sim::g42edm::length),
+            (float)(diff.y() * sim::g42edm::length),
+            (float)(diff.z() * sim::g42edm::length),
+        });
+        edmHit.setPathLength(diff.mag());
       }
     }
   }
-
-  return StatusCode::SUCCESS;
 }
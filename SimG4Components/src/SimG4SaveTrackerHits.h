@@ -17,6 +17,13 @@
 #include "edm4hep/Constants.h"
 #include "edm4hep/SimTrackerHitCollection.h"
 
+// Geant
+class G4HCofThisEvent;
+
+namespace sim {
+class EventInformation;
+}
+
 /** @class SimG4SaveTrackerHits SimG4Components/src/SimG4SaveTrackerHits.h SimG4SaveTrackerHits.h
  *
  *  \brief Save tracker hits tool.
@@ -35,6 +42,16 @@
  *  If the more than one readout names is provided through the deprecated
  *  `readoutNames` parameter, the tool will fail at initialization.
  *
+ *  When the event is simulated in sub-events, the hits of all the sub-events
+ *  are saved in one collection, with the track IDs offset per sub-event.
+ *
+ *  If the particle history is saved (by `SimG4SaveParticleHistory`, which must
+ *  precede this tool in the list of outputs), each hit is linked to the particle
+ *  which created it, or to its closest saved ancestor if that particle was not saved.
+ *
+ *  The deposited energy is multiplied by the weight of the track recorded in the event information (e.g. by the
+ *  Russian roulette of `SimG4FullSimActions`).
+ *
  *  [For more information please see](@ref md_sim_doc_geant4fullsim).
  *
  *  @author Anna Zaborowska
@@ -60,8 +77,27 @@ public:
    *   @return status code
    */
   virtual StatusCode saveOutput(const G4Event& aEvent) final;
+  /**  The tool merges the hits of the sub-events of a split event.
+   *   @return true
+   */
+  virtual bool mergesSubEvents() const final { return true; }
+  /**  Save the hits of a sub-event, appending them to the hits of the previous sub-events.
+   *   @param[in] aEvent Sub-event with data to save.
+   *   @param[in] aSubEvent Index of the sub-event.
+   *   @param[in] aTrackIdOffset Offset added to the track IDs of the sub-event.
+   *   @return status code
+   */
+  virtual StatusCode saveSubEventOutput(const G4Event& aEvent, size_t aSubEvent, int aTrackIdOffset) final;
 
 private:
+  /**  Convert the hits of the readout to EDM hits.
+   *   @param[in] aCollections Hits collections of the event.
+   *   @param[out] aEdmHits EDM hits to be filled.
+   *   @param[in] aTrackIdOffset Offset added to the track IDs.
+   *   @param[in] aHistory Particle history of the event, used to link the hits to the particles (may be nullptr).
+   */
+  void saveHits(G4HCofThisEvent& aCollections, edm4hep::SimTrackerHitCollection& aEdmHits, int aTrackIdOffset,
+                const sim::EventInformation* aHistory);
   /// Pointer to the geometry service
   ServiceHandle<IGeoSvc> m_geoSvc;
   /// Handle for output tracker hits
@@ -72,6 +108,10 @@ private:
       this, "readoutNames", {}, "[Deprecated] Name of the readouts (hits collections) to save"};
   /// Name of the readout (hits collection) to save
   Gaudi::Property<std::string> m_readoutName{this, "readoutName", {}, "Name of the readout (hit collection) to save"};
+  /// Output collection of the event being simulated in sub-events (owned by the event store)
+  edm4hep::SimTrackerHitCollection* m_subEventHits = nullptr;
+  /// Flag set once the user is warned that the particle history is saved after the hits
+  bool m_warnedHistoryOrder = false;
 };
 
 #endif /* SIMG4COMPONENTS_G4SAVETRACKERHITS_H */
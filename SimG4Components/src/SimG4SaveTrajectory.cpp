@@ -9,14 +9,34 @@
 // Geant4
 #include "G4Event.hh"
 #include "G4Trajectory.hh"
+#include "G4TrajectoryContainer.hh"
 #include "G4VTrajectory.hh"
+#include "G4VTrajectoryPoint.hh"
+
+// STL
+#include <algorithm>
+#include <utility>
+
+namespace {
+/// Distance of the point to the segment [aStart, aEnd]
+double distanceToSegment(const G4ThreeVector& aPoint, const G4ThreeVector& aStart, const G4ThreeVector& aEnd) {
+  G4ThreeVector segment = aEnd - aStart;
+  double length2 = segment.mag2();
+  if (length2 == 0) {
+    return (aPoint - aStart).mag();
+  }
+  double t = std::clamp((aPoint - aStart).dot(segment) / length2, 0., 1.);
+  return (aPoint - (aStart + t * segment)).mag();
+}
+} // namespace
 
 DECLARE_COMPONENT(SimG4SaveTrajectory)
 
 SimG4SaveTrajectory::SimG4SaveTrajectory(const std::string& aType, const std::string& aName, const IInterface* aParent)
     : AlgTool(aType, aName, aParent), m_geoSvc("GeoSvc", aName) {
   declareInterface<ISimG4SaveOutputTool>(this);
-  declareProperty("TrajectoryPoints", m_trackHits, "Handle for trajectory hits");
+  declareProperty("TrajectoryPoints", m_points, "Handle for the positions of the trajectory points");
+  declareProperty("Trajectories", m_trajectories, "Handle for the trajectories");
 }
 
 SimG4SaveTrajectory::~SimG4SaveTrajectory() {}
@@ -25,29 +45,111 @@ StatusCode SimG4SaveTrajectory::initialize() {
   if (AlgTool::initialize().isFailure()) {
     return StatusCode::FAILURE;
   }
+  if (m_minPointDistance < 0 || m_maxDeviation < 0) {
+    error() << "Decimation tolerances cannot be negative" << endmsg;
+    return StatusCode::FAILURE;
+  }
   return StatusCode::SUCCESS;
 }
 
 StatusCode SimG4SaveTrajectory::finalize() { return AlgTool::finalize(); }
 
+bool SimG4SaveTrajectory::selectTrajectory(const G4VTrajectory& aTrajectory) const {
+  if (m_primaryOnly && aTrajectory.GetParentID() != 0) {
+    return false;
+  }
+  const std::vector<int>& pdgs = m_pdgs;
+  if (!pdgs.empty() && std::find(pdgs.begin(), pdgs.end(), aTrajectory.GetPDGEncoding()) == pdgs.end()) {
+    return false;
+  }
+  return m_minMomentum <= 0 || aTrajectory.GetInitialMomentum().mag2() >= m_minMomentum * m_minMomentum;
+}
+
+void SimG4SaveTrajectory::decimate(const std::vector<G4ThreeVector>& aPoints, std::vector<size_t>& aSaved) const {
+  aSaved.clear();
+  if (aPoints.empty()) {
+    return;
+  }
+  aSaved.push_back(0);
+  for (size_t iPoint = 1; iPoint + 1 < aPoints.size(); ++iPoint) {
+    if ((aPoints[iPoint] - aPoints[aSaved.back()]).mag() >= m_minPointDistance) {
+      aSaved.push_back(iPoint);
+    }
+  }
+  if (aPoints.size() > 1) {
+    aSaved.push_back(aPoints.size() - 1);
+  }
+  if (m_maxDeviation <= 0 || aSaved.size() < 3) {
+    return;
+  }
+  // Douglas-Peucker: the point furthest from the segment joining the saved points around it is saved if it deviates
+  // by more than maxDeviation, and the two halves are decimated in turn. A straight trajectory is scanned once.
+  std::vector<char> keep(aSaved.size(), 0);
+  keep.front() = keep.back() = 1;
+  std::vector<std::pair<size_t, size_t>> ranges{{0, aSaved.size() - 1}};
+  while (!ranges.empty()) {
+    const auto [first, last] = ranges.back();
+    ranges.pop_back();
+    double maxDistance = m_maxDeviation;
+    size_t furthest = first;
+    for (size_t iPoint = first + 1; iPoint < last; ++iPoint) {
+      double distance = distanceToSegment(aPoints[aSaved[iPoint]], aPoints[aSaved[first]], aPoints[aSaved[last]]);
+      if (distance > maxDistance) {
+        maxDistance = distance;
+        furthest = iPoint;
+      }
+    }
+    if (furthest != first) {
+      keep[furthest] = 1;
+      ranges.emplace_back(first, furthest);
+      ranges.emplace_back(furthest, last);
+    }
+  }
+  size_t numSaved = 0;
+  for (size_t iPoint = 0; iPoint < aSaved.size(); ++iPoint) {
+    if (keep[iPoint]) {
+      aSaved[numSaved++] = aSaved[iPoint];
+    }
+  }
+  aSaved.resize(numSaved);
+}
+
 StatusCode SimG4SaveTrajectory::saveOutput(const G4Event& aEvent) {
-  auto edmPositions = m_trackHits.createAndPut();
+  auto& points = m_points.createAndPut()->vec();
+  auto& trajectories = m_trajectories.createAndPut()->vec();
   G4TrajectoryContainer* trajectoryContainer = aEvent.GetTrajectoryContainer();
+  if (trajectoryContainer == nullptr) {
+    if (!m_warnedNoTrajectories) {
+      warning() << "No trajectories in the event, run Geant4 with the command '/tracking/storeTrajectory 1'"
+                << endmsg;
+      m_warnedNoTrajectories = true;
+    }
+    return StatusCode::SUCCESS;
+  }
+  size_t numPoints = 0;
   for (size_t trajectoryIndex = 0; trajectoryIndex < trajectoryContainer->size(); ++trajectoryIndex) {
-    G4VTrajectory* theTrajectory = (*trajectoryContainer)[trajectoryIndex];
+    const G4VTrajectory* theTrajectory = (*trajectoryContainer)[trajectoryIndex];
+    if (!selectTrajectory(*theTrajectory)) {
+      continue;
+    }
+    m_trajectoryPoints.clear();
     for (int pointIndex = 0; pointIndex < theTrajectory->GetPointEntries(); ++pointIndex) {
-      auto trajectoryPoint = theTrajectory->GetPoint(pointIndex)->GetPosition();
-      auto edmHit = edmPositions->create();
-      edmHit.setCellID(0);
-      edmHit.setEDep(0);
-      edmHit.setTime(0);
-      edmHit.setPosition({
-          trajectoryPoint.x() * sim::g42edm::length,
-          trajectoryPoint.y() * sim::g42edm::length,
-          trajectoryPoint.z() * sim::g42edm::length,
-      });
+      m_trajectoryPoints.push_back(theTrajectory->GetPoint(pointIndex)->GetPosition());
+    }
+    numPoints += m_trajectoryPoints.size();
+    decimate(m_trajectoryPoints, m_savedPoints);
+    trajectories.insert(trajectories.end(),
+                        {theTrajectory->GetTrackID(), theTrajectory->GetParentID(), theTrajectory->GetPDGEncoding(),
+                         static_cast<int32_t>(points.size() / 3), static_cast<int32_t>(m_savedPoints.size())});
+    for (size_t iPoint : m_savedPoints) {
+      const G4ThreeVector& position = m_trajectoryPoints[iPoint];
+      points.insert(points.end(), {static_cast<float>(position.x() * sim::g42edm::length),
+                                   static_cast<float>(position.y() * sim::g42edm::length),
+                                   static_cast<float>(position.z() * sim::g42edm::length)});
     }
   }
+  debug() << "Saved " << trajectories.size() / 5 << " out of " << trajectoryContainer->size() << " trajectories, with "
+          << points.size() / 3 << " out of " << numPoints << " points" << endmsg;
 
   return StatusCode::SUCCESS;
 }
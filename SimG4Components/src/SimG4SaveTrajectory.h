@@ -9,13 +9,31 @@
 #include "k4FWCore/DataHandle.h"
 class IGeoSvc;
 
-#include "edm4hep/TrackerHit3DCollection.h"
+// podio
+#include "podio/UserDataCollection.h"
+
+// Geant4
+#include "G4ThreeVector.hh"
+class G4VTrajectory;
+
+// STL
+#include <cstdint>
+#include <vector>
 
 /** @class SimG4SaveTrajectory SimG4Components/src/SimG4SaveTrajectory.h SimG4SaveTrajectory.h
  *
  * Tool to save Geant4 Trajectory data. Requires Geant to be run with the command "/tracking/storeTrajectory 1".
  *  Note that access to trajectories is expensive, so this tool should only be used for debugging and visualisation.
  *
+ *  Trajectories can be selected by PDG code (\b'pdgs'), initial momentum (\b'minMomentum') and restricted to the
+ *  primary particles (\b'primaryOnly').
+ *  The points of each trajectory are decimated: points closer than \b'minPointDistance' to the previous saved point
+ *  are dropped, then the remaining points are simplified with the Douglas-Peucker algorithm: the points which lie
+ *  within \b'maxDeviation' of the straight segment joining the saved points around them are dropped. The first and
+ *  last points are always saved.
+ *  The output is made of two flat collections: \b'TrajectoryPoints' holds x, y, z (mm) of all the saved points and
+ *  \b'Trajectories' holds for each trajectory its track ID, parent ID, PDG code, index of its first point and number
+ *  of points.
  */
 
 class SimG4SaveTrajectory : public AlgTool, virtual public ISimG4SaveOutputTool {
@@ -37,11 +55,42 @@ public:
   virtual StatusCode saveOutput(const G4Event& aEvent) final;
 
 private:
+  /**  Check if the trajectory is saved.
+   *   @param[in] aTrajectory Trajectory.
+   *   @return true if the trajectory passes the selection
+   */
+  bool selectTrajectory(const G4VTrajectory& aTrajectory) const;
+  /**  Decimate the points of the trajectory.
+   *   @param[in] aPoints Points of the trajectory.
+   *   @param[out] aSaved Indices of the points to be saved.
+   */
+  void decimate(const std::vector<G4ThreeVector>& aPoints, std::vector<size_t>& aSaved) const;
   /// Pointer to the geometry service
   ServiceHandle<IGeoSvc> m_geoSvc;
-  /// Handle for trajectory hits including position information
-  mutable k4FWCore::DataHandle<edm4hep::TrackerHit3DCollection> m_trackHits{"Hits/Trajectory",
-                                                                            Gaudi::DataHandle::Writer, this};
+  /// Handle for the positions of the trajectory points (x, y, z for each point)
+  mutable k4FWCore::DataHandle<podio::UserDataCollection<float>> m_points{"TrajectoryPoints",
+                                                                          Gaudi::DataHandle::Writer, this};
+  /// Handle for the trajectories (track ID, parent ID, PDG, first point, number of points for each trajectory)
+  mutable k4FWCore::DataHandle<podio::UserDataCollection<int32_t>> m_trajectories{"Trajectories",
+                                                                                  Gaudi::DataHandle::Writer, this};
+  /// PDG codes of the saved trajectories (empty: all)
+  Gaudi::Property<std::vector<int>> m_pdgs{this, "pdgs", {}, "PDG codes of the saved trajectories (empty: all)"};
+  /// Minimum initial momentum of the saved trajectories
+  Gaudi::Property<double> m_minMomentum{this, "minMomentum", 0, "Minimum initial momentum of the saved trajectories"};
+  /// Flag to save only the trajectories of the primary particles
+  Gaudi::Property<bool> m_primaryOnly{this, "primaryOnly", false, "Save only the trajectories of primary particles"};
+  /// Minimum distance between two saved points of a trajectory (0: no cut)
+  Gaudi::Property<double> m_minPointDistance{this, "minPointDistance", 0,
+                                             "Minimum distance between two saved points of a trajectory"};
+  /// Maximum distance of a dropped point to the segment joining the saved points (0: no decimation)
+  Gaudi::Property<double> m_maxDeviation{this, "maxDeviation", 0,
+                                         "Maximum distance of a dropped point to the segment joining the saved points"};
+  /// Flag set once the user is warned that trajectories are not stored
+  bool m_warnedNoTrajectories = false;
+  /// Points of the current trajectory, kept between trajectories to avoid reallocation
+  std::vector<G4ThreeVector> m_trajectoryPoints;
+  /// Indices of the saved points of the current trajectory
+  std::vector<size_t> m_savedPoints;
 };
 
 #endif /* SIMG4COMPONENTS_G4SAVETRAJECTORY */
@@ -10,8 +10,11 @@
 // datamodel
 #include "edm4hep/MCParticleCollection.h"
 
-// DD4hep
-#include "DD4hep/Segmentations.h"
+// CLHEP
+#include "CLHEP/Vector/ThreeVector.h"
+
+// STL
+#include <vector>
 
 DECLARE_COMPONENT(SimG4SmearGenParticles)
 
@@ -37,48 +40,39 @@ StatusCode SimG4SmearGenParticles::execute(const EventContext&) const {
 
   auto particles = m_particles.createAndPut();
   const edm4hep::MCParticleCollection* coll = m_inParticles.get();
-  info() << "Input particle collection size: " << coll->size() << endmsg;
-
-  int n_part = 0;
-  for (auto j : *coll) {
+  debug() << "Input particle collection size: " << coll->size() << endmsg;
+
+  // clone the particles to be smeared, keeping their momenta and PDG codes for the batch smearing
+  // the parent-daughter relations are not cloned: they would point into the input collection,
+  // and adding the clones as daughters would modify the input particles
+  std::vector<CLHEP::Hep3Vector> momenta;
+  std::vector<int> pdgs;
+  momenta.reserve(coll->size());
+  pdgs.reserve(coll->size());
+  for (const auto& j : *coll) {
     // save only charged particles, visible in tracker
-    verbose() << "Charge of input particles: " << j.getCharge() << endmsg;
-
     if (j.getCharge() != 0 || j.getPDG() == -211 || !m_simTracker) {
-
-      // todo: replace with copy / ctor method when available in podio
-      // relations currently  not set!
-      auto particle = particles->create();
-      particle.setCharge(j.getCharge());
-      particle.setPDG(j.getPDG());
-      particle.setMass(j.getMass());
-      particle.setTime(j.getTime());
-      particle.setSimulatorStatus(j.getSimulatorStatus());
-      particle.setMomentumAtEndpoint(j.getMomentumAtEndpoint());
-#ifdef EDM4HEP_MCPARTICLE_HAS_HELICITY
-      particle.setHelicity(j.getHelicity());
-#else
-      particle.setSpin(j.getSpin());
-#endif
-      particle.setVertex(j.getVertex());
-
-      // smear momentum according to trackers resolution
+      particles->push_back(j.clone(false));
       auto edm_mom = j.getMomentum();
-      CLHEP::Hep3Vector mom = CLHEP::Hep3Vector(edm_mom.x, edm_mom.y, edm_mom.z);
-      //    m_smearTool->checkConditions(5000,10000000,6);
-      m_smearTool->smearMomentum(mom, j.getPDG()).ignore();
-      particle.setMomentum({
-          (float)mom.x(),
-          (float)mom.y(),
-          (float)mom.z(),
-      });
-
-      n_part++;
+      momenta.emplace_back(edm_mom.x, edm_mom.y, edm_mom.z);
+      pdgs.push_back(j.getPDG());
     }
   }
 
-  debug() << "\t" << n_part << " particles are stored in smeared particles collection" << endmsg;
-  debug() << "Output particle collection size: " << particles->size() << endmsg;
+  // smear momenta according to trackers resolution
+  if (m_smearTool->smearMomenta(momenta, pdgs).isFailure()) {
+    error() << "Couldn't smear the momenta of the particles" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  for (size_t i = 0; i < momenta.size(); ++i) {
+    (*particles)[i].setMomentum({
+        (float)momenta[i].x(),
+        (float)momenta[i].y(),
+        (float)momenta[i].z(),
+    });
+  }
+
+  debug() << "\t" << particles->size() << " particles are stored in smeared particles collection" << endmsg;
 
   return StatusCode::SUCCESS;
 }
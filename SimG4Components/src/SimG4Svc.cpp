@@ -1,5 +1,8 @@
 #include "SimG4Svc.h"
 
+// FCCSW
+#include "SimG4Interface/StartupProfiler.h"
+
 // Gaudi
 #include "GaudiKernel/IRndmEngine.h"
 #include "GaudiKernel/IToolSvc.h"
@@ -31,6 +34,7 @@ StatusCode SimG4Svc::initialize() {
     error() << "Unable to initialize Service()" << endmsg;
     return StatusCode::FAILURE;
   }
+  sim::StartupProfiler::Phase retrievalPhase("SimG4Svc", "retrieveTools");
   m_toolSvc = service("ToolSvc");
   if (!m_toolSvc) {
     error() << "Unable to locate Tool Service" << endmsg;
@@ -58,7 +62,11 @@ StatusCode SimG4Svc::initialize() {
     return StatusCode::FAILURE;
   }
 
+  retrievalPhase.stop();
+
   // Initialize Geant run manager
+  // construction of the geometry and of the physics list
+  sim::StartupProfiler::Phase initializePhase("SimG4Svc", "runManagerInitialize");
   // Load physics list, deleted in ~G4RunManager()
   m_runManager.SetUserInitialization(m_physicsListTool->physicsList());
   // Take geometry (from DD4Hep), deleted in ~G4RunManager()
@@ -70,6 +78,7 @@ StatusCode SimG4Svc::initialize() {
   }
 
   m_runManager.Initialize();
+  initializePhase.stop();
 
   if (m_interactiveMode) {
     m_visManager = std::make_unique<G4VisExecutive>();
@@ -80,7 +89,9 @@ StatusCode SimG4Svc::initialize() {
   }
 
   // Attach user actions
+  sim::StartupProfiler::Phase actionsPhase("SimG4Svc", "userActions");
   m_runManager.SetUserInitialization(m_actionsTool->userActionInitialization());
+  actionsPhase.stop();
   if (msgLevel() < MSG::INFO) {
     G4HadronicProcessStore::Instance()->SetVerbose(0);
     UImanager->ApplyCommand("/run/verbose 0");
@@ -88,6 +99,7 @@ StatusCode SimG4Svc::initialize() {
     UImanager->ApplyCommand("/process/had/verbose 0");
   }
   // Create regions
+  sim::StartupProfiler::Phase regionsPhase("SimG4Svc", "regions");
   for (auto& toolname : m_regionToolNames) {
     ISimG4RegionTool* tool = nullptr;
     if (m_toolSvc->retrieveTool(toolname, tool).isFailure()) {
@@ -102,6 +114,11 @@ StatusCode SimG4Svc::initialize() {
       return StatusCode::FAILURE;
     }
   }
+  regionsPhase.stop();
+  if (m_actionsTool->checkRegions().isFailure()) {
+    error() << "User actions refer to regions which do not exist" << endmsg;
+    return StatusCode::FAILURE;
+  }
   for (auto command : m_g4PostInitCommands) {
     UImanager->ApplyCommand(command);
   }
@@ -124,10 +141,20 @@ StatusCode SimG4Svc::initialize() {
     info() << "Random numbers seeds: " << seedsVec << endmsg;
   }
 
+  // building of the physics tables
+  sim::StartupProfiler::Phase runPhase("SimG4Svc", "runInitialization");
   if (!m_runManager.start()) {
     error() << "Unable to initialize GEANT correctly." << endmsg;
     return StatusCode::FAILURE;
   }
+  runPhase.stop();
+
+  // summary of all the phases, including those of the geometry service
+  const auto& profiler = sim::StartupProfiler::instance();
+  debug() << "Startup profile: " << profiler.json() << endmsg;
+  if (!m_startupProfileFile.value().empty() && !profiler.writeJson(m_startupProfileFile)) {
+    warning() << "Unable to write the startup profile to " << m_startupProfileFile << endmsg;
+  }
   return StatusCode::SUCCESS;
 }
 
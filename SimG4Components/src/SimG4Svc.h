@@ -24,6 +24,8 @@
  *
  *  Main Geant simulation service.
  *  It handles Geant initialization (via tools) and communication with the G4RunManager.
+ *  The time and memory of the initialization phases are printed at debug level at the end of the initialization
+ *  (see sim::StartupProfiler), together with those of the geometry service.
  *  [For more information please see](@ref md_sim_doc_geant4fullsim).
  *
  *  @author Anna Zaborowska
@@ -93,6 +95,9 @@ private:
       this, "seedValue", 1234567, "Seed to be used in RndmGenSvc engine (randomNumbersFromGaudi must be set to false)"};
 
   Gaudi::Property<bool> m_interactiveMode{this, "InteractiveMode", false, "Enter the interactive mode"};
+  /// File where the JSON summary of the initialization phases is written (not written if empty)
+  Gaudi::Property<std::string> m_startupProfileFile{
+      this, "startupProfileFile", "", "File where the JSON summary of the initialization phases is written"};
 
   /// Run Manager
   sim::RunManager m_runManager;
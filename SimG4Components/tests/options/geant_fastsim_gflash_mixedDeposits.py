@@ -0,0 +1,78 @@
+# Charged pions showering in the ALLEGRO electromagnetic calorimeter barrel.
+# The electromagnetic sub-showers are parametrised by GFlash and deposited directly into the hits of the readout,
+# the hadrons are simulated in full, so that the fast and full simulation deposit energy into the same cells.
+# The calorimeter steps are aggregated per cell by the sensitive detector: the output must hold one hit per cell.
+
+import os
+
+from Gaudi.Configuration import INFO
+from GaudiKernel.SystemOfUnits import GeV
+from GaudiKernel.PhysicalConstants import pi
+
+from Configurables import EventDataSvc, RndmGenSvc
+from k4FWCore import ApplicationMgr, IOSvc
+
+iosvc = IOSvc("IOSvc")
+iosvc.Output = "output_geant_fastsim_gflash_mixedDeposits.root"
+iosvc.outputCommands = ["keep *"]
+
+# Particle gun
+from Configurables import MomentumRangeParticleGun
+guntool = MomentumRangeParticleGun()
+guntool.ThetaMin = 80 * pi / 180.
+guntool.ThetaMax = 100 * pi / 180.
+guntool.PhiMin = 0.
+guntool.PhiMax = 2. * pi
+guntool.MomentumMin = 20. * GeV
+guntool.MomentumMax = 20. * GeV
+guntool.PdgCodes = [-211]
+
+from Configurables import GenAlg
+gen = GenAlg()
+gen.SignalProvider = guntool
+gen.hepmc.Path = "hepmc"
+
+from Configurables import HepMCToEDMConverter
+hepmc_converter = HepMCToEDMConverter()
+hepmc_converter.hepmc.Path = "hepmc"
+hepmc_converter.GenParticles.Path = "GenParticles"
+
+# Detector geometry, the calorimeter steps are aggregated per cell
+from Configurables import GeoSvc
+geoservice = GeoSvc("GeoSvc")
+path_to_detectors = os.environ.get("K4GEO", "")
+geoservice.detectors = [os.path.join(path_to_detectors, 'FCCee/ALLEGRO/compact/ALLEGRO_o1_v03/ALLEGRO_o1_v03.xml')]
+geoservice.sensitiveTypes = {"tracker": "SimpleTrackerSD", "calorimeter": "AggregateCalorimeterSD"}
+geoservice.OutputLevel = INFO
+
+# Fast simulation of the electromagnetic showers in the calorimeter barrel, deposited directly into the hits
+from Configurables import SimG4FastSimPhysicsList
+physicslisttool = SimG4FastSimPhysicsList("Physics", fullphysics="SimG4FtfpBert")
+
+from Configurables import SimG4GflashSamplingCalo, SimG4FastSimCalorimeterRegion
+gflash = SimG4GflashSamplingCalo("gflash", materialActive="G4_lAr", materialPassive="G4_Pb",
+                                 thicknessActive=4, thicknessPassive=2)
+regiontoolcalo = SimG4FastSimCalorimeterRegion("modelCalo", volumeNames=["ECalBarrel"], parametrisation=gflash,
+                                               batchDeposition=True, readoutName="ECalBarrelModuleThetaMerged")
+
+from Configurables import SimG4Svc
+geantservice = SimG4Svc("SimG4Svc", detector="SimG4DD4hepDetector", physicslist=physicslisttool,
+                        actions="SimG4FullSimActions", regions=["SimG4FastSimCalorimeterRegion/modelCalo"])
+geantservice.randomNumbersFromGaudi = False
+geantservice.seedValue = 4242
+
+from Configurables import SimG4Alg, SimG4PrimariesFromEdmTool, SimG4SaveCalHits
+saveecaltool = SimG4SaveCalHits("saveECalBarrelHits", readoutName="ECalBarrelModuleThetaMerged")
+saveecaltool.CaloHits.Path = "ECalBarrelHits"
+particle_converter = SimG4PrimariesFromEdmTool("EdmConverter")
+particle_converter.GenParticles.Path = "GenParticles"
+geantsim = SimG4Alg("SimG4Alg", outputs=["SimG4SaveCalHits/saveECalBarrelHits"], eventProvider=particle_converter)
+
+ApplicationMgr(
+    TopAlg=[gen, hepmc_converter, geantsim],
+    EvtSel='NONE',
+    EvtMax=5,
+    ExtSvc=[RndmGenSvc(), EventDataSvc("EventDataSvc"), geoservice, geantservice],
+    OutputLevel=INFO,
+    StopOnSignal=True,
+)
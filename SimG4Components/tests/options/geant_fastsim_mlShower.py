@@ -0,0 +1,90 @@
+# Photons showering in the ALLEGRO electromagnetic calorimeter barrel, with the showers generated by a tiny network
+# of known weights, written by this file: its outputs are 1/40 for any input, so each photon entering the calorimeter
+# deposits 0.25 GeV in each of the 40 voxels placed along its direction (in the sensitive volumes only).
+
+import os
+
+from Gaudi.Configuration import INFO
+from GaudiKernel.SystemOfUnits import GeV, mm
+from GaudiKernel.PhysicalConstants import pi
+
+from Configurables import EventDataSvc, RndmGenSvc
+from k4FWCore import ApplicationMgr, IOSvc
+
+# Network with the 6 particle conditions as inputs and one output per voxel:
+# relu(0 * x + (1, 2)) = (1, 2), then softmax of the 40 equal values 0.5 * 1 - 0.25 * 2 = 0
+numVoxels = 40
+networkFile = "denseNetwork_test.txt"
+with open(networkFile, "w") as network:
+    network.write("# number of layers\n2\n")
+    network.write("# inputs outputs activation, weights, biases\n6 2 relu\n")
+    network.write("0 0 0 0 0 0\n0 0 0 0 0 0\n1 2\n")
+    network.write(f"2 {numVoxels} softmax\n")
+    network.write("0.5 -0.25\n" * numVoxels)
+    network.write(" ".join(["0"] * numVoxels) + "\n")
+
+iosvc = IOSvc("IOSvc")
+iosvc.Output = "output_geant_fastsim_mlShower.root"
+iosvc.outputCommands = ["keep *"]
+
+# Particle gun
+from Configurables import MomentumRangeParticleGun
+guntool = MomentumRangeParticleGun()
+guntool.ThetaMin = 80 * pi / 180.
+guntool.ThetaMax = 100 * pi / 180.
+guntool.PhiMin = 0.
+guntool.PhiMax = 2. * pi
+guntool.MomentumMin = 10 * GeV
+guntool.MomentumMax = 10 * GeV
+guntool.PdgCodes = [22]
+
+from Configurables import GenAlg
+gen = GenAlg()
+gen.SignalProvider = guntool
+gen.hepmc.Path = "hepmc"
+
+from Configurables import HepMCToEDMConverter
+hepmc_converter = HepMCToEDMConverter()
+hepmc_converter.hepmc.Path = "hepmc"
+hepmc_converter.GenParticles.Path = "GenParticles"
+
+# Detector geometry, the calorimeter steps are aggregated per cell
+from Configurables import GeoSvc
+geoservice = GeoSvc("GeoSvc")
+path_to_detectors = os.environ.get("K4GEO", "")
+geoservice.detectors = [os.path.join(path_to_detectors, 'FCCee/ALLEGRO/compact/ALLEGRO_o1_v03/ALLEGRO_o1_v03.xml')]
+geoservice.sensitiveTypes = {"tracker": "SimpleTrackerSD", "calorimeter": "AggregateCalorimeterSD"}
+geoservice.OutputLevel = INFO
+
+# Network showers in the calorimeter barrel, on a grid of voxels along the photon direction, without latent variables
+from Configurables import SimG4FastSimPhysicsList
+physicslisttool = SimG4FastSimPhysicsList("Physics", fullphysics="SimG4FtfpBert")
+
+from Configurables import SimG4FastSimMLShowerRegion
+regiontoolcalo = SimG4FastSimMLShowerRegion("modelCalo", volumeNames=["ECalBarrel"], modelFile=networkFile,
+                                            latentSize=0, numVoxelsR=1, numVoxelsPhi=1, numVoxelsZ=numVoxels,
+                                            voxelSizeR=1 * mm, voxelSizeZ=10 * mm,
+                                            readoutName="ECalBarrelModuleThetaMerged", particles=[22],
+                                            minEnergy=1 * GeV, batchSize=4)
+
+from Configurables import SimG4Svc
+geantservice = SimG4Svc("SimG4Svc", detector="SimG4DD4hepDetector", physicslist=physicslisttool,
+                        actions="SimG4FullSimActions", regions=["SimG4FastSimMLShowerRegion/modelCalo"])
+geantservice.randomNumbersFromGaudi = False
+geantservice.seedValue = 4242
+
+from Configurables import SimG4Alg, SimG4PrimariesFromEdmTool, SimG4SaveCalHits
+saveecaltool = SimG4SaveCalHits("saveECalBarrelHits", readoutName="ECalBarrelModuleThetaMerged")
+saveecaltool.CaloHits.Path = "ECalBarrelHits"
+particle_converter = SimG4PrimariesFromEdmTool("EdmConverter")
+particle_converter.GenParticles.Path = "GenParticles"
+geantsim = SimG4Alg("SimG4Alg", outputs=["SimG4SaveCalHits/saveECalBarrelHits"], eventProvider=particle_converter)
+
+ApplicationMgr(
+    TopAlg=[gen, hepmc_converter, geantsim],
+    EvtSel='NONE',
+    EvtMax=10,
+    ExtSvc=[RndmGenSvc(), EventDataSvc("EventDataSvc"), geoservice, geantservice],
+    OutputLevel=INFO,
+    StopOnSignal=True,
+)
@@ -0,0 +1,81 @@
+# Photons showering in the ALLEGRO electromagnetic calorimeter barrel, with a shower library.
+# With the environment variable SHOWERLIB_HARVEST set, the showers are fully simulated and harvested into the
+# library, written at finalization. Otherwise the library is read and the photons entering the calorimeter are
+# replaced by its showers, deposited into the hits of the readout.
+
+import os
+
+from Gaudi.Configuration import INFO
+from GaudiKernel.SystemOfUnits import GeV
+from GaudiKernel.PhysicalConstants import pi
+
+from Configurables import EventDataSvc, RndmGenSvc
+from k4FWCore import ApplicationMgr, IOSvc
+
+harvest = bool(os.environ.get("SHOWERLIB_HARVEST", ""))
+
+iosvc = IOSvc("IOSvc")
+iosvc.Output = "output_geant_fastsim_showerLibrary.root"
+iosvc.outputCommands = ["keep *"]
+
+# Particle gun
+from Configurables import MomentumRangeParticleGun
+guntool = MomentumRangeParticleGun()
+guntool.ThetaMin = 80 * pi / 180.
+guntool.ThetaMax = 100 * pi / 180.
+guntool.PhiMin = 0.
+guntool.PhiMax = 2. * pi
+guntool.MomentumMin = 0.5 * GeV
+guntool.MomentumMax = 0.5 * GeV
+guntool.PdgCodes = [22]
+
+from Configurables import GenAlg
+gen = GenAlg()
+gen.SignalProvider = guntool
+gen.hepmc.Path = "hepmc"
+
+from Configurables import HepMCToEDMConverter
+hepmc_converter = HepMCToEDMConverter()
+hepmc_converter.hepmc.Path = "hepmc"
+hepmc_converter.GenParticles.Path = "GenParticles"
+
+# Detector geometry, the calorimeter steps are aggregated per cell
+from Configurables import GeoSvc
+geoservice = GeoSvc("GeoSvc")
+path_to_detectors = os.environ.get("K4GEO", "")
+geoservice.detectors = [os.path.join(path_to_detectors, 'FCCee/ALLEGRO/compact/ALLEGRO_o1_v03/ALLEGRO_o1_v03.xml')]
+geoservice.sensitiveTypes = {"tracker": "SimpleTrackerSD", "calorimeter": "AggregateCalorimeterSD"}
+geoservice.OutputLevel = INFO
+
+# Shower library in the calorimeter barrel: one bin of photons up to 1 GeV, all entry angles
+from Configurables import SimG4FastSimPhysicsList
+physicslisttool = SimG4FastSimPhysicsList("Physics", fullphysics="SimG4FtfpBert")
+
+from Configurables import SimG4FastSimShowerLibraryRegion
+regiontoolcalo = SimG4FastSimShowerLibraryRegion("modelCalo", volumeNames=["ECalBarrel"],
+                                                 libraryFile="showerLibrary_test.bin",
+                                                 readoutName="ECalBarrelModuleThetaMerged",
+                                                 minEnergy=0.1 * GeV, maxEnergy=1 * GeV, harvest=harvest,
+                                                 particles=[22], energyBins=[0, 1 * GeV], angleBins=[0, pi])
+
+from Configurables import SimG4Svc
+geantservice = SimG4Svc("SimG4Svc", detector="SimG4DD4hepDetector", physicslist=physicslisttool,
+                        actions="SimG4FullSimActions", regions=["SimG4FastSimShowerLibraryRegion/modelCalo"])
+geantservice.randomNumbersFromGaudi = False
+geantservice.seedValue = 4242
+
+from Configurables import SimG4Alg, SimG4PrimariesFromEdmTool, SimG4SaveCalHits
+saveecaltool = SimG4SaveCalHits("saveECalBarrelHits", readoutName="ECalBarrelModuleThetaMerged")
+saveecaltool.CaloHits.Path = "ECalBarrelHits"
+particle_converter = SimG4PrimariesFromEdmTool("EdmConverter")
+particle_converter.GenParticles.Path = "GenParticles"
+geantsim = SimG4Alg("SimG4Alg", outputs=["SimG4SaveCalHits/saveECalBarrelHits"], eventProvider=particle_converter)
+
+ApplicationMgr(
+    TopAlg=[gen, hepmc_converter, geantsim],
+    EvtSel='NONE',
+    EvtMax=20 if harvest else 5,
+    ExtSvc=[RndmGenSvc(), EventDataSvc("EventDataSvc"), geoservice, geantservice],
+    OutputLevel=INFO,
+    StopOnSignal=True,
+)
@@ -0,0 +1,95 @@
+# Overlay of pre-simulated minimum-bias hits on the hits of the signal events, in the ALLEGRO detector.
+# With the environment variable OVERLAY_PRODUCE_PILEUP set, low-energy pions are simulated and their calorimeter hits
+# (with the contributions) and vertex detector hits are saved as the pile-up file. Otherwise electrons are simulated
+# and the hits of three pile-up events per signal event are overlaid on theirs. The environment variable
+# OVERLAY_PILEUP_TRACKER replaces the name of the overlaid tracker collection, to test a collection missing from the
+# pile-up file.
+
+import os
+
+from Gaudi.Configuration import INFO
+from GaudiKernel.SystemOfUnits import GeV
+from GaudiKernel.PhysicalConstants import pi
+
+from Configurables import EventDataSvc, RndmGenSvc
+from k4FWCore import ApplicationMgr, IOSvc
+
+producePileup = bool(os.environ.get("OVERLAY_PRODUCE_PILEUP", ""))
+pileupFile = "output_geant_fullsim_overlayPileup_minBias.root"
+
+iosvc = IOSvc("IOSvc")
+iosvc.Output = pileupFile if producePileup else "output_geant_fullsim_overlayPileup.root"
+iosvc.outputCommands = ["keep *"]
+
+# Particle gun
+from Configurables import MomentumRangeParticleGun
+guntool = MomentumRangeParticleGun()
+guntool.ThetaMin = 60 * pi / 180.
+guntool.ThetaMax = 120 * pi / 180.
+guntool.PhiMin = 0.
+guntool.PhiMax = 2. * pi
+guntool.MomentumMin = 0.5 * GeV if producePileup else 5 * GeV
+guntool.MomentumMax = 0.5 * GeV if producePileup else 5 * GeV
+guntool.PdgCodes = [211] if producePileup else [11]
+
+from Configurables import GenAlg
+gen = GenAlg()
+gen.SignalProvider = guntool
+gen.hepmc.Path = "hepmc"
+
+from Configurables import HepMCToEDMConverter
+hepmc_converter = HepMCToEDMConverter()
+hepmc_converter.hepmc.Path = "hepmc"
+hepmc_converter.GenParticles.Path = "GenParticles"
+
+from Configurables import GeoSvc
+geoservice = GeoSvc("GeoSvc")
+path_to_detectors = os.environ.get("K4GEO", "")
+geoservice.detectors = [os.path.join(path_to_detectors, 'FCCee/ALLEGRO/compact/ALLEGRO_o1_v03/ALLEGRO_o1_v03.xml')]
+geoservice.OutputLevel = INFO
+
+from Configurables import SimG4Svc
+geantservice = SimG4Svc("SimG4Svc", detector="SimG4DD4hepDetector", physicslist="SimG4FtfpBert",
+                        actions="SimG4FullSimActions")
+geantservice.randomNumbersFromGaudi = False
+geantservice.seedValue = 4242
+
+# Calorimeter hits with their contributions and vertex detector hits, in the same collections for both files
+from Configurables import SimG4Alg, SimG4PrimariesFromEdmTool, SimG4SaveCalHits, SimG4SaveTrackerHits
+saveecaltool = SimG4SaveCalHits("saveECalBarrelHits", readoutName="ECalBarrelModuleThetaMerged",
+                                saveFirstTrackContributions=True)
+saveecaltool.CaloHits.Path = "ECalBarrelHits"
+saveecaltool.FirstTrackContributions.Path = "ECalBarrelHitContributions"
+savevertextool = SimG4SaveTrackerHits("saveVertexBarrelHits", readoutName="VertexBarrelCollection")
+savevertextool.SimTrackHits.Path = "VertexBarrelHits"
+particle_converter = SimG4PrimariesFromEdmTool("EdmConverter")
+particle_converter.GenParticles.Path = "GenParticles"
+geantsim = SimG4Alg("SimG4Alg",
+                    outputs=["SimG4SaveCalHits/saveECalBarrelHits", "SimG4SaveTrackerHits/saveVertexBarrelHits"],
+                    eventProvider=particle_converter)
+algorithms = [gen, hepmc_converter, geantsim]
+
+# Three pile-up events per signal event, from the two previous bunch crossings or the signal one
+if not producePileup:
+    from Configurables import SimG4OverlayPileupHits
+    overlay = SimG4OverlayPileupHits("OverlayPileup", pileupFile=pileupFile, numPileupEvents=3,
+                                     minBunchCrossing=-2, maxBunchCrossing=0, minCaloTime=-30, maxCaloTime=100,
+                                     pileupCaloCollection="ECalBarrelHits",
+                                     pileupCaloContributionCollection="ECalBarrelHitContributions",
+                                     pileupTrackerCollection=os.environ.get("OVERLAY_PILEUP_TRACKER",
+                                                                            "VertexBarrelHits"))
+    overlay.SignalCaloHits.Path = "ECalBarrelHits"
+    overlay.MergedCaloHits.Path = "ECalBarrelHitsWithPileup"
+    overlay.MergedCaloHitContributions.Path = "ECalBarrelHitContributionsWithPileup"
+    overlay.SignalTrackerHits.Path = "VertexBarrelHits"
+    overlay.MergedTrackerHits.Path = "VertexBarrelHitsWithPileup"
+    algorithms.append(overlay)
+
+ApplicationMgr(
+    TopAlg=algorithms,
+    EvtSel='NONE',
+    EvtMax=10 if producePileup else 5,
+    ExtSvc=[RndmGenSvc(), EventDataSvc("EventDataSvc"), geoservice, geantservice],
+    OutputLevel=INFO,
+    StopOnSignal=True,
+)
@@ -0,0 +1,78 @@
+# Events of several electron vertices, each event split into four sub-events simulated one after the other.
+# Only the primary particles are kept in the history, so that the merged output can be checked exactly:
+# every primary of the event is saved once, with the track IDs of each sub-event offset by trackIdOffsetStep,
+# and the calorimeter hits of all the sub-events are saved in one collection.
+
+import os
+
+from Gaudi.Configuration import INFO
+from GaudiKernel.SystemOfUnits import GeV, mm
+from GaudiKernel.PhysicalConstants import pi
+
+from Configurables import EventDataSvc, RndmGenSvc
+from k4FWCore import ApplicationMgr, IOSvc
+
+iosvc = IOSvc("IOSvc")
+iosvc.Output = "output_geant_fullsim_subEvents.root"
+iosvc.outputCommands = ["keep *"]
+
+# One signal and seven pile-up electrons per event, each from its own vertex
+from Configurables import MomentumRangeParticleGun, ConstPileUp, FlatSmearVertex, GenAlg
+guns = []
+for name in ["SignalGun", "PileUpGun"]:
+    gun = MomentumRangeParticleGun(name)
+    gun.ThetaMin = 60 * pi / 180.
+    gun.ThetaMax = 120 * pi / 180.
+    gun.PhiMin = 0.
+    gun.PhiMax = 2. * pi
+    gun.MomentumMin = 5. * GeV
+    gun.MomentumMax = 5. * GeV
+    gun.PdgCodes = [11]
+    guns.append(gun)
+pileuptool = ConstPileUp(numPileUpEvents=7)
+smeartool = FlatSmearVertex(xVertexMin=-1 * mm, xVertexMax=1 * mm, yVertexMin=-1 * mm, yVertexMax=1 * mm,
+                            zVertexMin=-50 * mm, zVertexMax=50 * mm)
+gen = GenAlg(SignalProvider=guns[0], PileUpProvider=guns[1], PileUpTool=pileuptool, VertexSmearingTool=smeartool)
+gen.hepmc.Path = "hepmc"
+
+from Configurables import HepMCToEDMConverter
+hepmc_converter = HepMCToEDMConverter()
+hepmc_converter.hepmc.Path = "hepmc"
+hepmc_converter.GenParticles.Path = "GenParticles"
+
+from Configurables import GeoSvc
+geoservice = GeoSvc("GeoSvc")
+path_to_detectors = os.environ.get("K4GEO", "")
+geoservice.detectors = [os.path.join(path_to_detectors, 'FCCee/ALLEGRO/compact/ALLEGRO_o1_v03/ALLEGRO_o1_v03.xml')]
+geoservice.OutputLevel = INFO
+
+# Only the primary particles are kept in the history
+from Configurables import SimG4FullSimActions
+actions = SimG4FullSimActions(enableHistory=True, truthRules=["keep creator=primary", "drop"])
+
+from Configurables import SimG4Svc
+geantservice = SimG4Svc("SimG4Svc", detector="SimG4DD4hepDetector", physicslist="SimG4FtfpBert", actions=actions)
+geantservice.randomNumbersFromGaudi = False
+geantservice.seedValue = 4242
+
+from Configurables import SimG4Alg, SimG4PrimariesFromEdmTool, SimG4SaveCalHits, SimG4SaveParticleHistory
+savehisttool = SimG4SaveParticleHistory("saveHistory")
+savehisttool.GenParticles.Path = "SimParticles"
+saveecaltool = SimG4SaveCalHits("saveECalBarrelHits", readoutName="ECalBarrelModuleThetaMerged")
+saveecaltool.CaloHits.Path = "ECalBarrelHits"
+particle_converter = SimG4PrimariesFromEdmTool("EdmConverter", minParticlesPerSubEvent=1)
+particle_converter.GenParticles.Path = "GenParticles"
+geantsim = SimG4Alg("SimG4Alg",
+                    outputs=["SimG4SaveParticleHistory/saveHistory", "SimG4SaveCalHits/saveECalBarrelHits"],
+                    eventProvider=particle_converter,
+                    numSubEvents=4,
+                    trackIdOffsetStep=10000000)
+
+ApplicationMgr(
+    TopAlg=[gen, hepmc_converter, geantsim],
+    EvtSel='NONE',
+    EvtMax=3,
+    ExtSvc=[RndmGenSvc(), EventDataSvc("EventDataSvc"), geoservice, geantservice],
+    OutputLevel=INFO,
+    StopOnSignal=True,
+)
@@ -0,0 +1,76 @@
+# Electrons showering in the ALLEGRO electromagnetic calorimeter barrel, with a pruned particle history.
+# Only the primaries and the photons above 0.5 GeV created in the region of the calorimeter barrel are kept.
+# The region of the rule can be changed with the environment variable TRUTH_REGION, e.g. to check that
+# a misspelled region is rejected at initialisation.
+
+import os
+
+from Gaudi.Configuration import INFO
+from GaudiKernel.SystemOfUnits import GeV
+from GaudiKernel.PhysicalConstants import pi
+
+from Configurables import EventDataSvc, RndmGenSvc
+from k4FWCore import ApplicationMgr, IOSvc
+
+iosvc = IOSvc("IOSvc")
+iosvc.Output = "output_geant_fullsim_truthPruning.root"
+iosvc.outputCommands = ["keep *"]
+
+from Configurables import MomentumRangeParticleGun
+guntool = MomentumRangeParticleGun()
+guntool.ThetaMin = 80 * pi / 180.
+guntool.ThetaMax = 100 * pi / 180.
+guntool.PhiMin = 0.
+guntool.PhiMax = 2. * pi
+guntool.MomentumMin = 10. * GeV
+guntool.MomentumMax = 10. * GeV
+guntool.PdgCodes = [11]
+
+from Configurables import GenAlg
+gen = GenAlg()
+gen.SignalProvider = guntool
+gen.hepmc.Path = "hepmc"
+
+from Configurables import HepMCToEDMConverter
+hepmc_converter = HepMCToEDMConverter()
+hepmc_converter.hepmc.Path = "hepmc"
+hepmc_converter.GenParticles.Path = "GenParticles"
+
+from Configurables import GeoSvc
+geoservice = GeoSvc("GeoSvc")
+path_to_detectors = os.environ.get("K4GEO", "")
+geoservice.detectors = [os.path.join(path_to_detectors, 'FCCee/ALLEGRO/compact/ALLEGRO_o1_v03/ALLEGRO_o1_v03.xml')]
+geoservice.OutputLevel = INFO
+
+# Region of the calorimeter barrel, named ECalBarrel_userLimits, without any limit
+from Configurables import SimG4UserLimitRegion
+ecalregion = SimG4UserLimitRegion("ecalRegion", volumeNames=["ECalBarrel"])
+
+truthRegion = os.environ.get("TRUTH_REGION", "ECalBarrel_userLimits")
+from Configurables import SimG4FullSimActions
+actions = SimG4FullSimActions(enableHistory=True, keepAncestors=False,
+                              truthRules=["keep creator=primary",
+                                          "keep region=" + truthRegion + " pdg=22 minEnergy=0.5",
+                                          "drop"])
+
+from Configurables import SimG4Svc
+geantservice = SimG4Svc("SimG4Svc", detector="SimG4DD4hepDetector", physicslist="SimG4FtfpBert", actions=actions,
+                        regions=["SimG4UserLimitRegion/ecalRegion"])
+geantservice.randomNumbersFromGaudi = False
+geantservice.seedValue = 4242
+
+from Configurables import SimG4Alg, SimG4PrimariesFromEdmTool, SimG4SaveParticleHistory
+savehisttool = SimG4SaveParticleHistory("saveHistory")
+savehisttool.GenParticles.Path = "SimParticles"
+particle_converter = SimG4PrimariesFromEdmTool("EdmConverter")
+particle_converter.GenParticles.Path = "GenParticles"
+geantsim = SimG4Alg("SimG4Alg", outputs=["SimG4SaveParticleHistory/saveHistory"], eventProvider=particle_converter)
+
+ApplicationMgr(
+    TopAlg=[gen, hepmc_converter, geantsim],
+    EvtSel='NONE',
+    EvtMax=3,
+    ExtSvc=[RndmGenSvc(), EventDataSvc("EventDataSvc"), geoservice, geantservice],
+    OutputLevel=INFO,
+    StopOnSignal=True,
+)
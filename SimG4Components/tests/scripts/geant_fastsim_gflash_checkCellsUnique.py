@@ -0,0 +1,13 @@
+# Check that the fast and full simulation deposits of a cell end up in one hit
+from podio.root_io import Reader
+
+reader = Reader('output_geant_fastsim_gflash_mixedDeposits.root')
+
+numHits = 0
+for iev, event in enumerate(reader.get('events')):
+    cellIds = [hit.getCellID() for hit in event.get('ECalBarrelHits')]
+    duplicates = len(cellIds) - len(set(cellIds))
+    print(f"event {iev}: {len(cellIds)} hits, {duplicates} duplicated cells")
+    assert duplicates == 0
+    numHits += len(cellIds)
+assert numHits > 0
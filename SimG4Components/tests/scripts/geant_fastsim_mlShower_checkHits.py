@@ -0,0 +1,17 @@
+# Check that the photons entering the calorimeter deposit the outputs of the known-weight network: 1/40 of their
+# energy, 0.25 GeV, per voxel, so the showered cells hold multiples of 0.25 GeV
+from podio.root_io import Reader
+
+reader = Reader('output_geant_fastsim_mlShower.root')
+
+numEvents = 0
+numShowerCells = 0
+for iev, event in enumerate(reader.get('events')):
+    energies = [hit.getEnergy() for hit in event.get('ECalBarrelHits')]
+    print(f"event {iev}: {len(energies)} hits, {sum(energies):.3f} GeV")
+    # the 10 GeV photon is showered at most once, the particles from a conversion upstream are fully simulated
+    assert sum(energies) <= 10 + 1e-3
+    numShowerCells += sum(1 for energy in energies if energy > 0.2 and abs(energy / 0.25 - round(energy / 0.25)) < 1e-4)
+    numEvents += 1
+assert numEvents > 0
+assert numShowerCells > 0
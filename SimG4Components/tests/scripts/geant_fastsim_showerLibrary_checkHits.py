@@ -0,0 +1,13 @@
+# Check that the photons replaced by the showers of the library deposit their energy in the calorimeter
+from podio.root_io import Reader
+
+reader = Reader('output_geant_fastsim_showerLibrary.root')
+
+numEvents = 0
+for iev, event in enumerate(reader.get('events')):
+    energy = sum(hit.getEnergy() for hit in event.get('ECalBarrelHits'))
+    print(f"event {iev}: {len(event.get('ECalBarrelHits'))} hits, {energy:.3f} GeV")
+    # the showers are scaled to the photon energy, 0.5 GeV, of which only a sampling fraction is in the readout
+    assert 0 < energy <= 0.5 + 1e-6
+    numEvents += 1
+assert numEvents > 0
@@ -0,0 +1,33 @@
+# Check that the pile-up hits are overlaid on the signal hits: the calorimeter cells are merged, keeping the signal
+# energy, and the pile-up tracker hits are appended, flagged as overlay
+from podio.root_io import Reader
+
+reader = Reader('output_geant_fullsim_overlayPileup.root')
+
+numEvents = 0
+pileupCaloEnergy = 0
+numPileupTrackerHits = 0
+for iev, event in enumerate(reader.get('events')):
+    signalCalo = event.get('ECalBarrelHits')
+    mergedCalo = event.get('ECalBarrelHitsWithPileup')
+    signalTracker = event.get('VertexBarrelHits')
+    mergedTracker = event.get('VertexBarrelHitsWithPileup')
+    signalEnergy = sum(hit.getEnergy() for hit in signalCalo)
+    mergedEnergy = sum(hit.getEnergy() for hit in mergedCalo)
+    print(f"event {iev}: calorimeter {signalEnergy:.3f} -> {mergedEnergy:.3f} GeV, "
+          f"tracker {len(signalTracker)} -> {len(mergedTracker)} hits")
+    # one merged hit per cell, each holding at least the energy of the signal hit of the cell
+    mergedCells = {hit.getCellID(): hit.getEnergy() for hit in mergedCalo}
+    assert len(mergedCells) == len(mergedCalo)
+    for hit in signalCalo:
+        assert mergedCells[hit.getCellID()] >= hit.getEnergy() - 1e-6
+    # the signal tracker hits come first, followed by the pile-up hits
+    assert len(mergedTracker) >= len(signalTracker)
+    assert not any(hit.isOverlay() for hit in list(mergedTracker)[:len(signalTracker)])
+    assert all(hit.isOverlay() for hit in list(mergedTracker)[len(signalTracker):])
+    pileupCaloEnergy += mergedEnergy - signalEnergy
+    numPileupTrackerHits += len(mergedTracker) - len(signalTracker)
+    numEvents += 1
+assert numEvents > 0
+assert pileupCaloEnergy > 0
+assert numPileupTrackerHits > 0
@@ -0,0 +1,24 @@
+# Check that the output of the four sub-events of each event is merged into one event
+from podio.root_io import Reader
+
+numSubEvents = 4
+trackIdOffsetStep = 10000000
+
+reader = Reader('output_geant_fullsim_subEvents.root')
+
+numHits = 0
+for iev, event in enumerate(reader.get('events')):
+    numPrimaries = len(event.get('GenParticles'))
+    trackIds = [particle.getSimulatorStatus() for particle in event.get('SimParticles')]
+    subEvents = set(trackId // trackIdOffsetStep for trackId in trackIds)
+    cellIds = [hit.getCellID() for hit in event.get('ECalBarrelHits')]
+    print(f"event {iev}: {numPrimaries} primaries, {len(trackIds)} saved particles from sub-events {sorted(subEvents)}, "
+          f"{len(cellIds)} hits")
+    # every primary is saved once, and the track IDs of the sub-events do not overlap
+    assert len(trackIds) == numPrimaries
+    assert len(set(trackIds)) == len(trackIds)
+    assert subEvents == set(range(numSubEvents))
+    # the hits of all the sub-events are appended to the collection of the event
+    assert len(cellIds) > 0
+    numHits += len(cellIds)
+assert numHits > 0
@@ -0,0 +1,31 @@
+# Check that only the particles selected by the pruning rules are kept in the history
+import math
+
+from podio.root_io import Reader
+
+reader = Reader('output_geant_fullsim_truthPruning.root')
+
+numPhotons = 0
+for iev, event in enumerate(reader.get('events')):
+    numPrimaries = len(event.get('GenParticles'))
+    primaries = 0
+    photons = 0
+    for particle in event.get('SimParticles'):
+        if len(particle.getParents()) == 0:
+            # primary electrons
+            assert particle.getPDG() == 11
+            primaries += 1
+            continue
+        # photons created in the calorimeter barrel, linked to their primary
+        mom = particle.getMomentum()
+        energy = math.sqrt(mom.x**2 + mom.y**2 + mom.z**2 + particle.getMass()**2)
+        vertex = particle.getVertex()
+        assert particle.getPDG() == 22
+        assert energy >= 0.5
+        assert math.hypot(vertex.x, vertex.y) > 1500
+        assert len(particle.getParents()[0].getParents()) == 0
+        photons += 1
+    print(f"event {iev}: {primaries} primaries and {photons} photons kept")
+    assert primaries == numPrimaries
+    numPhotons += photons
+assert numPhotons > 0
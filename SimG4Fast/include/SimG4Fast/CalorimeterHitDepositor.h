@@ -0,0 +1,74 @@
+#ifndef SIMG4FAST_CALORIMETERHITDEPOSITOR_H
+#define SIMG4FAST_CALORIMETERHITDEPOSITOR_H
+
+// Geant
+#include "G4ThreeVector.hh"
+class G4Navigator;
+
+// DD4hep
+#include "DD4hep/Segmentations.h"
+
+// STL
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+
+namespace k4 {
+class Geant4CaloHit;
+}
+
+/** @class sim::CalorimeterHitDepositor SimG4Fast/SimG4Fast/CalorimeterHitDepositor.h CalorimeterHitDepositor.h
+ *
+ *  Deposits the energy of parametrised showers directly into calorimeter hits, bypassing the sensitive detectors.
+ *  Each energy deposit is located in the geometry with a dedicated navigator (relative search from the previous
+ *  deposit), its cellID is computed by the DD4hep segmentation of the readout, and its energy is added to the hit of
+ *  that cell in the hits collection of the readout (named as the readout) which is created by the sensitive detector.
+ *  If the cell was already hit in the event, by the full simulation or by an earlier deposit, the energy is added to
+ *  its first hit, otherwise a hit is appended to the collection. The depositor thus adds no cell twice: with a
+ *  sensitive detector aggregating the steps per cell the collection keeps one hit per cell and event.
+ *  Deposits outside of volumes sensitive for the readout are lost.
+ */
+
+namespace sim {
+class CalorimeterHitDepositor {
+public:
+  /** Constructor.
+   *  @param aReadoutName Name of the readout (and of the hits collection) where energy is deposited.
+   *  @param aSegmentation Segmentation of the readout.
+   */
+  CalorimeterHitDepositor(const std::string& aReadoutName, dd4hep::Segmentation aSegmentation);
+  ~CalorimeterHitDepositor();
+  /** Add the energy deposits to the hits of the cells they fall into.
+   *  @param aPositions Positions of the deposits (global frame).
+   *  @param aEnergies Energies of the deposits.
+   *  @param aTrackId Identifier of the track which caused the deposits.
+   *  @param aPdg PDG code of the track which caused the deposits.
+   *  @param aTime Time of the deposits.
+   *  @return energy deposited in the hits
+   */
+  double deposit(std::span<const G4ThreeVector> aPositions, std::span<const double> aEnergies, int aTrackId, int aPdg,
+                 double aTime);
+
+private:
+  /// Name of the readout (and of the hits collection)
+  std::string m_readoutName;
+  /// Segmentation of the readout
+  dd4hep::Segmentation m_segmentation;
+  /// Identifier of the hits collection (-1 if not yet known)
+  int m_collectionId = -1;
+  /// Navigator used to locate the deposits, separate from the navigator for tracking
+  std::unique_ptr<G4Navigator> m_navigator;
+  /// Hits of the current event, per cellID (owned by the hits collection)
+  std::unordered_map<uint64_t, k4::Geant4CaloHit*> m_cellHits;
+  /// Number of hits of the collection already indexed in m_cellHits
+  size_t m_indexedHits = 0;
+  /// Identifier of the event of the hits in m_cellHits
+  int m_eventId = -1;
+  /// Hits collection of the hits in m_cellHits
+  const void* m_collection = nullptr;
+};
+} // namespace sim
+
+#endif /* SIMG4FAST_CALORIMETERHITDEPOSITOR_H */
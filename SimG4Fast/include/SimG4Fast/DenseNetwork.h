@@ -0,0 +1,68 @@
+#ifndef SIMG4FAST_DENSENETWORK_H
+#define SIMG4FAST_DENSENETWORK_H
+
+// STL
+#include <string>
+#include <vector>
+
+/** @class sim::DenseNetwork SimG4Fast/SimG4Fast/DenseNetwork.h DenseNetwork.h
+ *
+ *  Small fully connected neural network (multilayer perceptron) evaluated on the CPU.
+ *  The network is read from a text file with the number of layers, followed for each layer by a line
+ *  '<inputs> <outputs> <activation>' (activation: linear, relu, sigmoid, softplus or softmax),
+ *  the weights (one row of <inputs> values per output) and the <outputs> biases. Lines starting with '#' are comments.
+ *  The network is evaluated for a batch of inputs at once: each row of the weights is applied to all the inputs of
+ *  the batch before moving to the next one, so the weights are read from memory once per batch.
+ */
+
+namespace sim {
+class DenseNetwork {
+public:
+  /** Read the network from the file.
+   *  @param[in] aFileName Name of the file.
+   *  @param[out] aError Description of the problem if the file cannot be read.
+   *  @return true if the network was read
+   */
+  bool load(const std::string& aFileName, std::string& aError);
+  /// Number of inputs of the network (0 if not loaded)
+  size_t inputSize() const;
+  /// Number of outputs of the network (0 if not loaded)
+  size_t outputSize() const;
+  /** Evaluate the network for a batch of inputs.
+   *  @param[in] aInputs Inputs, stored as [batch entry][input].
+   *  @param[in] aBatchSize Number of entries in the batch.
+   *  @param[out] aOutputs Outputs, stored as [batch entry][output].
+   *  @param aBuffer Buffer for the intermediate layers, reused between the calls.
+   */
+  void evaluate(const float* aInputs, size_t aBatchSize, std::vector<float>& aOutputs,
+                std::vector<float>& aBuffer) const;
+
+private:
+  /// Activation functions of the layers
+  enum class Activation { Linear, ReLU, Sigmoid, Softplus, Softmax };
+  /// Fully connected layer
+  struct Layer {
+    /// Number of inputs
+    size_t numInputs;
+    /// Number of outputs
+    size_t numOutputs;
+    /// Activation function
+    Activation activation;
+    /// Weights, stored as [output][input]
+    std::vector<float> weights;
+    /// Biases, one per output
+    std::vector<float> biases;
+  };
+  /** Evaluate one layer for a batch of inputs.
+   *  @param[in] aLayer Layer.
+   *  @param[in] aInputs Inputs, stored as [batch entry][input].
+   *  @param[in] aBatchSize Number of entries in the batch.
+   *  @param[out] aOutputs Outputs, stored as [batch entry][output].
+   */
+  static void evaluateLayer(const Layer& aLayer, const float* aInputs, size_t aBatchSize, float* aOutputs);
+  /// Layers of the network
+  std::vector<Layer> m_layers;
+};
+} // namespace sim
+
+#endif /* SIMG4FAST_DENSENETWORK_H */
@@ -0,0 +1,25 @@
+#ifndef SIMG4FAST_ENVELOPEENTRY_H
+#define SIMG4FAST_ENVELOPEENTRY_H
+
+// Geant4
+class G4FastTrack;
+
+/** Entry of a particle into the envelope of a fast simulation model.
+ *  The models trained on (or harvested from) the particles entering the envelope use them to reject the particles
+ *  created inside it, e.g. by a fully simulated shower.
+ */
+
+namespace sim {
+/** Check if the particle enters the envelope: it is on the envelope surface and moves inwards.
+ *  @param[in] aFastTrack Track in the envelope.
+ *  @return true if the particle enters the envelope
+ */
+bool isEnteringEnvelope(const G4FastTrack& aFastTrack);
+/** Angle between the particle direction and the inward normal of the closest surface of the envelope.
+ *  @param[in] aFastTrack Track in the envelope.
+ *  @return angle, 0 for a particle entering perpendicularly to the surface, pi/2 for a grazing one (0 to pi)
+ */
+double envelopeEntryAngle(const G4FastTrack& aFastTrack);
+} // namespace sim
+
+#endif /* SIMG4FAST_ENVELOPEENTRY_H */
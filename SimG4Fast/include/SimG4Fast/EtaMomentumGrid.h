@@ -0,0 +1,71 @@
+#ifndef SIMG4FAST_ETAMOMENTUMGRID_H
+#define SIMG4FAST_ETAMOMENTUMGRID_H
+
+// STL
+#include <vector>
+
+/** @class EtaMomentumGrid SimG4Fast/SimG4Fast/EtaMomentumGrid.h EtaMomentumGrid.h
+ *
+ *  Binning of the resolution tables of the smearing tools: bins in |eta| and momentum values.
+ *  The |eta| bins are given by their upper edges, the lower edge of the first bin is 0.
+ *  Resolutions are linearly interpolated between the momentum values, the momentum segment of a point
+ *  is the one used for this interpolation (outermost segments are used outside the momentum range).
+ *  The bins are found with a first guess assuming equidistant binning, corrected for the actual edges.
+ */
+
+namespace sim {
+class EtaMomentumGrid {
+public:
+  /// Position of a point in the grid
+  struct Bin {
+    /// Index of the |eta| bin
+    unsigned int eta = 0;
+    /// Index of the momentum segment: index of its lower momentum value
+    unsigned int momentum = 0;
+    /// Distance of the momentum from the lower momentum value of the segment
+    double deltaMomentum = 0;
+  };
+
+  /** Set the binning.
+   *  @param[in] aEtaEdges Upper edges of the |eta| bins, strictly increasing and positive.
+   *  @param[in] aMomentumValues Momentum values, strictly increasing.
+   *  @return false if a binning is empty or not strictly increasing (the grid is then left empty)
+   */
+  bool set(const std::vector<double>& aEtaEdges, const std::vector<double>& aMomentumValues);
+  /** Find the bin of a point.
+   *  @param[in] aEta Pseudorapidity, its absolute value is used.
+   *  @param[in] aMomentum Momentum, in the unit of the momentum values.
+   *  @param[out] aBin Bin of the point.
+   *  @return false outside the |eta| range (including |eta| equal to the last edge), for a momentum that is not
+   *  finite, or if the grid is empty
+   */
+  bool find(double aEta, double aMomentum, Bin& aBin) const;
+
+  /// Number of |eta| bins
+  inline unsigned int etaBins() const { return m_etaEdges.size(); }
+  /// Number of momentum values
+  inline unsigned int momentumBins() const { return m_momentumValues.size(); }
+  /// Upper edges of the |eta| bins
+  inline const std::vector<double>& etaEdges() const { return m_etaEdges; }
+  /// Momentum values
+  inline const std::vector<double>& momentumValues() const { return m_momentumValues; }
+  /// Upper edge of the last |eta| bin
+  inline double maxEta() const { return m_etaEdges.empty() ? 0 : m_etaEdges.back(); }
+  /// Lowest momentum value
+  inline double minMomentum() const { return m_momentumValues.empty() ? 0 : m_momentumValues.front(); }
+  /// Highest momentum value
+  inline double maxMomentum() const { return m_momentumValues.empty() ? 0 : m_momentumValues.back(); }
+
+private:
+  /// Upper edges of the |eta| bins
+  std::vector<double> m_etaEdges;
+  /// Momentum values
+  std::vector<double> m_momentumValues;
+  /// Width of the |eta| bins if they were equidistant, used as a first guess of the |eta| bin
+  double m_etaStep = 0;
+  /// Distance between the momentum values if they were equidistant, used as a first guess of the momentum segment
+  double m_momentumStep = 0;
+};
+} // namespace sim
+
+#endif /* SIMG4FAST_ETAMOMENTUMGRID_H */
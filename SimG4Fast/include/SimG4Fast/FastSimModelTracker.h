@@ -5,7 +5,9 @@
 class ISimG4ParticleSmearTool;
 
 // Geant
+#include "G4ThreeVector.hh"
 #include "G4VFastSimulationModel.hh"
+class G4LogicalVolume;
 
 // Gaudi
 #include "GaudiKernel/IMessageSvc.h"
@@ -13,6 +15,10 @@ class ISimG4ParticleSmearTool;
 #include "GaudiKernel/ServiceHandle.h"
 #include "GaudiKernel/ToolHandle.h"
 
+// STL
+#include <deque>
+#include <unordered_set>
+
 class IToolSvc;
 
 /** FastSimModelTracker SimG4Fast/SimG4Fast/FastSimModelTracker.h FastSimModelTracker.h
@@ -29,6 +35,10 @@ class IToolSvc;
  *  a particle is moved to the exit of the tracker (as it would be transported with initial momentum and no
  *  physics processes on the way) and the particle momentum is smeared according to the smearing tool
  *  defined in the job options file.
+ *  If the envelope is a full cylinder (G4Tubs) and the magnetic field sampled within it is uniform and parallel to
+ *  its axis, the exit point is computed analytically from the intersection of the helix with the cylinders and the
+ *  end planes. For other shapes or fields the particle is propagated with G4PathFinder. A particle which does not
+ *  leave the envelope (e.g. a looper) is not smeared again if the model is triggered again.
  *
  *  @author    Anna Zaborowska
  */
@@ -45,10 +55,11 @@ public:
    *  @param aMinMomentum Minimum particle momentum that triggers that model
    *  @param aMinMomentum Maximum particle momentum that triggers that model
    *  @param aMinMomentum Maximum pseudorapidity that triggers that model
+   *  @param aAnalyticPropagation Compute the exit point analytically for cylindrical envelopes in uniform field
    */
   explicit FastSimModelTracker(const std::string& aModelName, G4Region* aEnvelope,
                                ToolHandle<ISimG4ParticleSmearTool>& aSmearTool, double aMinMomentum,
-                               double aMaxMomentum, double aMaxEta);
+                               double aMaxMomentum, double aMaxEta, bool aAnalyticPropagation = true);
   /** Constructor.
    *  @param aModelName Name of the fast simulation model.
    */
@@ -64,13 +75,52 @@ public:
   virtual G4bool ModelTrigger(const G4FastTrack& aFastTrack) final;
   /** Apply the parametrisation.
    *  Move the particle to the exit from the volume along the computed trajectory.
-   *  Smear the momentum with the smearing tool m_smearTool.
+   *  Smear the momentum (and the vertex, if supported) with the smearing tool m_smearTool, given the PDG code.
    *  @param aFastTrack Track.
    *  @param aFastStep Step.
    */
   virtual void DoIt(const G4FastTrack& aFastTrack, G4FastStep& aFastStep) final;
 
 private:
+  /// Description of the envelope used by the propagation to the exit point
+  struct EnvelopeInfo {
+    /// Envelope volume
+    const G4LogicalVolume* volume = nullptr;
+    /// Step proposed to G4PathFinder: diagonal of the bounding box of the envelope, longer than any straight path in
+    /// it, and at least 10 m for the curling paths
+    double maxStep = 0;
+    /// Whether the exit point can be computed analytically
+    bool analytic = false;
+    /// Inner radius of the cylinder
+    double rMin = 0;
+    /// Outer radius of the cylinder
+    double rMax = 0;
+    /// Half-length of the cylinder
+    double dz = 0;
+    /// Magnetic field in the envelope (global frame)
+    G4ThreeVector field;
+  };
+  /** Get the description of the envelope, analysing its shape and field at first use.
+   *  The model is only used by the thread which tracks the particles, so no locking is needed.
+   *  @param aFastTrack Track.
+   */
+  const EnvelopeInfo& envelopeInfo(const G4FastTrack& aFastTrack);
+  /** Compute the exit point from the cylindrical envelope analytically, for a helix in a uniform field.
+   *  @param aFastTrack Track.
+   *  @param aEnvelope Description of the envelope.
+   *  @param[out] aExitPosition Exit point (global frame).
+   *  @return false if the particle does not leave the envelope through the cylinders or the end planes
+   */
+  bool propagateHelix(const G4FastTrack& aFastTrack, const EnvelopeInfo& aEnvelope,
+                      G4ThreeVector& aExitPosition) const;
+  /// IDs of the tracks smeared in the current event
+  std::unordered_set<int> m_smearedTracks;
+  /// ID of the event of m_smearedTracks
+  int m_smearedEventId = -1;
+  /// Descriptions of the envelopes of this model (deque: references stay valid when an envelope is added)
+  std::deque<EnvelopeInfo> m_envelopes;
+  /// Flag to compute the exit point analytically where possible
+  bool m_analyticPropagation = true;
   /// Message Service
   ServiceHandle<IMessageSvc> m_msgSvc;
   /// Message Stream
@@ -0,0 +1,68 @@
+#ifndef SIMG4FAST_GFLASHBATCHSHOWERMODEL_H
+#define SIMG4FAST_GFLASHBATCHSHOWERMODEL_H
+
+// FCCSW
+#include "SimG4Fast/CalorimeterHitDepositor.h"
+
+// Geant
+#include "G4ThreeVector.hh"
+#include "GFlashShowerModel.hh"
+class GVFlashShowerParameterisation;
+
+// DD4hep
+#include "DD4hep/Segmentations.h"
+
+// STL
+#include <string>
+#include <vector>
+
+/** @class sim::GFlashBatchShowerModel SimG4Fast/SimG4Fast/GFlashBatchShowerModel.h GFlashBatchShowerModel.h
+ *
+ *  GFlash shower model which deposits the energy spots directly into calorimeter hits.
+ *  The trigger conditions are the ones of GFlashShowerModel. Once triggered, the longitudinal and radial profiles
+ *  of the parametrisation are sampled and all the spot positions of the shower are computed in one pass,
+ *  before any of them is deposited.
+ *  The spots are then deposited into the cells of the readout by sim::CalorimeterHitDepositor, sensitive detectors
+ *  are not called for the spots. Spots outside of sensitive volumes are not deposited.
+ */
+
+namespace sim {
+class GFlashBatchShowerModel : public GFlashShowerModel {
+public:
+  /** Constructor.
+   *  @param aModelName Name of the fast simulation model.
+   *  @param aEnvelope Region where the model can take over the ordinary tracking.
+   *  @param aParametrisation Shower parametrisation (not owned), also set as the GFlashShowerModel parametrisation.
+   *  @param aReadoutName Name of the readout (and of the hits collection) where energy is deposited.
+   *  @param aSegmentation Segmentation of the readout.
+   *  @param aStepInX0 Longitudinal step of the shower profile, in radiation lengths.
+   */
+  GFlashBatchShowerModel(const std::string& aModelName, G4Region* aEnvelope,
+                         GVFlashShowerParameterisation& aParametrisation, const std::string& aReadoutName,
+                         dd4hep::Segmentation aSegmentation, double aStepInX0 = 0.1);
+  virtual ~GFlashBatchShowerModel();
+  /** Parametrise the shower of the electron (positron) and deposit its energy in the calorimeter cells.
+   *  @param aFastTrack Track.
+   *  @param aFastStep Step.
+   */
+  virtual void DoIt(const G4FastTrack& aFastTrack, G4FastStep& aFastStep) final;
+
+private:
+  /** Sample the shower profile, filling the positions and energies of all the spots.
+   *  @param aFastTrack Track.
+   */
+  void generateSpots(const G4FastTrack& aFastTrack);
+  /// Shower parametrisation
+  GVFlashShowerParameterisation& m_parametrisation;
+  /// Longitudinal step of the shower profile, in radiation lengths
+  double m_stepInX0;
+  /// Positions of the spots of the current shower
+  std::vector<G4ThreeVector> m_spotPositions;
+  /// Energies of the spots of the current shower
+  std::vector<double> m_spotEnergies;
+  /// Deposits the spots into the calorimeter hits
+  CalorimeterHitDepositor m_depositor;
+};
+} // namespace sim
+
+#endif /* SIMG4FAST_GFLASHBATCHSHOWERMODEL_H */
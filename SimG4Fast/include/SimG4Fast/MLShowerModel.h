@@ -0,0 +1,135 @@
+#ifndef SIMG4FAST_MLSHOWERMODEL_H
+#define SIMG4FAST_MLSHOWERMODEL_H
+
+// FCCSW
+#include "SimG4Fast/CalorimeterHitDepositor.h"
+#include "SimG4Fast/DenseNetwork.h"
+
+// Geant
+#include "G4ThreeVector.hh"
+#include "G4VFastSimulationModel.hh"
+
+// DD4hep
+#include "DD4hep/Segmentations.h"
+
+// STL
+#include <string>
+#include <vector>
+
+/** @class sim::MLShowerModel SimG4Fast/SimG4Fast/MLShowerModel.h MLShowerModel.h
+ *
+ *  Fast simulation model generating the calorimeter showers with a neural network (sim::DenseNetwork).
+ *  The network takes the conditions of the particle entering the envelope, followed by the latent variables
+ *  drawn from the standard normal distribution:
+ *  log10(E/GeV), polar and azimuthal angles of the direction (rad), entry point x, y, z (m), latent variables.
+ *  The outputs are the energies of the voxels of a cylindrical grid aligned with the particle direction and starting
+ *  at the entry point, in units of the particle energy, stored as [r bin][phi bin][z bin].
+ *  Triggered particles are killed and their showers are queued; the showers are generated for all the queued
+ *  particles with one evaluation of the network, when the queue is full or when Geant4 flushes the fast simulation
+ *  models at the end of the event. The voxel energies are deposited at the voxel centres into the hits of the
+ *  readout by sim::CalorimeterHitDepositor.
+ */
+
+namespace sim {
+class MLShowerModel : public G4VFastSimulationModel {
+public:
+  /// Cylindrical grid of the voxels of the shower
+  struct VoxelGrid {
+    /// Number of radial bins
+    size_t numR;
+    /// Number of azimuthal bins
+    size_t numPhi;
+    /// Number of longitudinal bins
+    size_t numZ;
+    /// Radial size of the voxels
+    double sizeR;
+    /// Longitudinal size of the voxels
+    double sizeZ;
+  };
+  /** Constructor.
+   *  @param aModelName Name of the fast simulation model.
+   *  @param aEnvelope Region where the model can take over the ordinary tracking.
+   *  @param aNetwork Shower generator (not owned), with (6 + aLatentSize) inputs and as many outputs as voxels.
+   *  @param aLatentSize Number of latent variables of the network.
+   *  @param aGrid Grid of the voxels.
+   *  @param aReadoutName Name of the readout (and of the hits collection) where energy is deposited.
+   *  @param aSegmentation Segmentation of the readout.
+   *  @param aParticles PDG codes of the particles which trigger the model.
+   *  @param aMinEnergy Minimum energy of the particle that triggers the model.
+   *  @param aMaxEnergy Maximum energy of the particle that triggers the model.
+   *  @param aMaxBatchSize Number of queued particles for which the showers are generated before the end of event.
+   */
+  MLShowerModel(const std::string& aModelName, G4Region* aEnvelope, const DenseNetwork& aNetwork, size_t aLatentSize,
+                const VoxelGrid& aGrid, const std::string& aReadoutName, dd4hep::Segmentation aSegmentation,
+                const std::vector<int>& aParticles, double aMinEnergy, double aMaxEnergy, size_t aMaxBatchSize);
+  virtual ~MLShowerModel();
+  /** Check if the particle type triggers the model.
+   *  @param aParticleType Particle type.
+   *  @return true if the PDG code of the particle is one of the triggering ones
+   */
+  virtual G4bool IsApplicable(const G4ParticleDefinition& aParticleType) final;
+  /** Check if the particle enters the envelope with an energy in the triggering range.
+   *  @param aFastTrack Track.
+   *  @return true if the model is triggered
+   */
+  virtual G4bool ModelTrigger(const G4FastTrack& aFastTrack) final;
+  /** Kill the particle and queue its shower, generating the showers of the queue if it is full.
+   *  @param aFastTrack Track.
+   *  @param aFastStep Step.
+   */
+  virtual void DoIt(const G4FastTrack& aFastTrack, G4FastStep& aFastStep) final;
+  /// Generate the showers of all the queued particles, called by Geant4 at the end of the event.
+  virtual void Flush() final;
+
+private:
+  /// Number of conditions of the particle given to the network, before the latent variables
+  static constexpr size_t kNumConditions = 6;
+  /// Particle which shower is waiting for generation
+  struct QueuedShower {
+    /// Entry point
+    G4ThreeVector position;
+    /// Direction
+    G4ThreeVector direction;
+    /// Kinetic energy
+    double energy;
+    /// Time
+    double time;
+    /// Track identifier
+    int trackId;
+    /// PDG code
+    int pdg;
+  };
+  /// Shower generator
+  const DenseNetwork& m_network;
+  /// Number of latent variables of the network
+  size_t m_latentSize;
+  /// PDG codes of the particles which trigger the model
+  std::vector<int> m_particles;
+  /// Minimum energy of the particle that triggers the model
+  double m_minEnergy;
+  /// Maximum energy of the particle that triggers the model
+  double m_maxEnergy;
+  /// Number of queued particles for which the showers are generated before the end of event
+  size_t m_maxBatchSize;
+  /// Positions of the voxel centres in the shower frame (z along the particle direction)
+  std::vector<G4ThreeVector> m_voxelCentres;
+  /// Particles waiting for the generation of their showers
+  std::vector<QueuedShower> m_queue;
+  /// Inputs of the network for the queued particles
+  std::vector<float> m_inputs;
+  /// Outputs of the network for the queued particles
+  std::vector<float> m_outputs;
+  /// Buffer of the intermediate layers of the network
+  std::vector<float> m_networkBuffer;
+  /// Latent variables of one particle
+  std::vector<double> m_latent;
+  /// Positions of the voxels of one shower (global frame)
+  std::vector<G4ThreeVector> m_positions;
+  /// Energies of the voxels of one shower
+  std::vector<double> m_energies;
+  /// Deposits the voxel energies into the calorimeter hits
+  CalorimeterHitDepositor m_depositor;
+};
+} // namespace sim
+
+#endif /* SIMG4FAST_MLSHOWERMODEL_H */
@@ -0,0 +1,49 @@
+#ifndef SIMG4FAST_NORMALDEVIATEGENERATOR_H
+#define SIMG4FAST_NORMALDEVIATEGENERATOR_H
+
+// STL
+#include <vector>
+
+// Gaudi
+#include "GaudiKernel/IRndmGenSvc.h"
+#include "GaudiKernel/RndmGenerators.h"
+#include "GaudiKernel/SmartIF.h"
+
+/** @class NormalDeviateGenerator SimG4Fast/SimG4Fast/NormalDeviateGenerator.h NormalDeviateGenerator.h
+ *
+ *  Generator of random numbers following the standard normal distribution (mean 0, sigma 1).
+ *  One generator is created at initialization and reused for all the particles,
+ *  so the smearing tools do not create a Gaudi random generator for each particle.
+ *  Nothing is drawn in advance: the numbers used in an event depend only on the state of the
+ *  random engine at the start of that event, which keeps the events reproducible one by one.
+ *  A Gaussian with mean `mu` and sigma `s` is obtained as `mu + s * next()`.
+ */
+
+namespace sim {
+class NormalDeviateGenerator {
+public:
+  NormalDeviateGenerator() = default;
+  /** Initialize the unit normal generator.
+   *  @param[in] aRandSvc Random number service.
+   *  @return status code
+   */
+  StatusCode initialize(const SmartIF<IRndmGenSvc>& aRandSvc);
+  /** Draw the next random number.
+   *  @return random number following the standard normal distribution
+   */
+  inline double next() { return m_gauss(); }
+  /** Fill an array with random numbers following the standard normal distribution.
+   *  @param[out] aDeviates Array to be filled.
+   *  @param[in] aNum Number of random numbers to draw.
+   */
+  void fill(double* aDeviates, size_t aNum);
+
+private:
+  /// Unit normal random number generator
+  Rndm::Numbers m_gauss;
+  /// Random numbers drawn by the last call to fill, kept to avoid reallocation
+  std::vector<double> m_batch;
+};
+} // namespace sim
+
+#endif /* SIMG4FAST_NORMALDEVIATEGENERATOR_H */
@@ -0,0 +1,172 @@
+#ifndef SIMG4FAST_SHOWERLIBRARY_H
+#define SIMG4FAST_SHOWERLIBRARY_H
+
+// STL
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** @class sim::ShowerLibrary SimG4Fast/SimG4Fast/ShowerLibrary.h ShowerLibrary.h
+ *
+ *  Library of pre-simulated (frozen) showers, binned in particle type, energy and entry angle (with respect to the
+ *  inward normal of the envelope surface, see sim::ShowerLibraryModel).
+ *  The library is a binary file which is memory-mapped (read-only) rather than read into memory, so only the showers
+ *  used by the job are loaded, and the pages are shared between the processes using the same file.
+ *  The showers are stored as lists of energy spots in the shower frame: z along the particle direction, starting at
+ *  the entry point, x and y transverse to it. The spot energies are fractions of the energy of the particle.
+ *  The file layout is (little-endian, all sections aligned to 8 bytes):
+ *  header (FileHeader), PDG codes (int32_t, padded to 8 bytes), energy bin edges (double), angle bin edges (double),
+ *  bins (BinEntry, ordered as [particle][energy bin][angle bin]), showers (ShowerEntry), spots (Spot).
+ *  Libraries are written by sim::ShowerLibraryWriter.
+ */
+
+namespace sim {
+class ShowerLibrary {
+public:
+  /// Header of the library file
+  struct FileHeader {
+    /// File identifier, "FCCSHLIB"
+    char magic[8];
+    /// Version of the file layout
+    uint32_t version;
+    /// Number of particle types
+    uint32_t numParticles;
+    /// Number of energy bins
+    uint32_t numEnergyBins;
+    /// Number of angle bins
+    uint32_t numAngleBins;
+    /// Number of showers
+    uint64_t numShowers;
+    /// Number of energy spots
+    uint64_t numSpots;
+  };
+  /// Showers of one bin
+  struct BinEntry {
+    /// Index of the first shower of the bin
+    uint64_t firstShower;
+    /// Number of showers of the bin
+    uint64_t numShowers;
+  };
+  /// One shower
+  struct ShowerEntry {
+    /// Index of the first spot of the shower
+    uint64_t firstSpot;
+    /// Number of spots of the shower
+    uint32_t numSpots;
+    /// Kinetic energy of the particle which created the shower (MeV)
+    float energy;
+  };
+  /// Energy spot of a shower
+  struct Spot {
+    /// Position in the shower frame (mm)
+    float x, y, z;
+    /// Fraction of the particle energy
+    float energy;
+  };
+  /// Identifier of the library files
+  static constexpr char kMagic[8] = {'F', 'C', 'C', 'S', 'H', 'L', 'I', 'B'};
+  /// Version of the file layout (2: entry angle with respect to the surface normal instead of the polar angle)
+  static constexpr uint32_t kVersion = 2;
+
+  ShowerLibrary() = default;
+  ShowerLibrary(const ShowerLibrary&) = delete;
+  ShowerLibrary& operator=(const ShowerLibrary&) = delete;
+  /// Destructor, unmapping the file
+  ~ShowerLibrary();
+  /** Map the library file into memory.
+   *  @param[in] aFileName Name of the file.
+   *  @param[out] aError Description of the problem if the file cannot be mapped.
+   *  @return true if the library was mapped
+   */
+  bool open(const std::string& aFileName, std::string& aError);
+  /** Get the showers of the bin.
+   *  @param[in] aPdg Particle PDG code.
+   *  @param[in] aEnergy Kinetic energy of the particle (MeV).
+   *  @param[in] aAngle Entry angle of the particle (rad).
+   *  @return the bin (nullptr outside the library)
+   */
+  const BinEntry* bin(int aPdg, double aEnergy, double aAngle) const;
+  /// Get the shower with the index
+  inline const ShowerEntry& shower(uint64_t aIndex) const { return m_showers[aIndex]; }
+  /// Get the spots of the shower
+  inline const Spot* spots(const ShowerEntry& aShower) const { return m_spots + aShower.firstSpot; }
+  /// Total number of showers in the library
+  inline uint64_t numShowers() const { return m_header ? m_header->numShowers : 0; }
+
+private:
+  /// Unmap the file
+  void close();
+  /// Start of the mapped file
+  void* m_data = nullptr;
+  /// Size of the mapped file
+  size_t m_size = 0;
+  /// Header of the library
+  const FileHeader* m_header = nullptr;
+  /// PDG codes of the particles
+  const int32_t* m_pdgs = nullptr;
+  /// Edges of the energy bins (MeV)
+  const double* m_energyEdges = nullptr;
+  /// Edges of the angle bins (rad)
+  const double* m_angleEdges = nullptr;
+  /// Bins
+  const BinEntry* m_bins = nullptr;
+  /// Showers
+  const ShowerEntry* m_showers = nullptr;
+  /// Spots
+  const Spot* m_spots = nullptr;
+};
+
+/** @class sim::ShowerLibraryWriter SimG4Fast/SimG4Fast/ShowerLibrary.h ShowerLibrary.h
+ *
+ *  Collects the harvested showers in memory and writes them as a sim::ShowerLibrary file.
+ */
+class ShowerLibraryWriter {
+public:
+  /** Constructor.
+   *  @param[in] aPdgs PDG codes of the particles.
+   *  @param[in] aEnergyEdges Edges of the energy bins (MeV).
+   *  @param[in] aAngleEdges Edges of the angle bins (rad).
+   *  @param[in] aMaxShowersPerBin Maximum number of showers stored per bin.
+   */
+  ShowerLibraryWriter(const std::vector<int>& aPdgs, const std::vector<double>& aEnergyEdges,
+                      const std::vector<double>& aAngleEdges, size_t aMaxShowersPerBin);
+  /** Add a shower.
+   *  @param[in] aPdg Particle PDG code.
+   *  @param[in] aEnergy Kinetic energy of the particle (MeV).
+   *  @param[in] aAngle Entry angle of the particle (rad).
+   *  @param[in] aSpots Spots of the shower.
+   *  @return false if the shower is outside of the library or if its bin is full
+   */
+  bool add(int aPdg, double aEnergy, double aAngle, const std::vector<ShowerLibrary::Spot>& aSpots);
+  /// Check if a shower of the particle would be stored by add
+  bool accepts(int aPdg, double aEnergy, double aAngle) const;
+  /// Number of stored showers
+  inline size_t numShowers() const { return m_numShowers; }
+  /** Write the library file, through a temporary file renamed once it is complete.
+   *  @param[in] aFileName Name of the file.
+   *  @param[out] aError Description of the problem if the file cannot be written.
+   *  @return true if the library was written
+   */
+  bool write(const std::string& aFileName, std::string& aError) const;
+
+private:
+  /// Find the bin of the particle (-1 outside the library)
+  long binIndex(int aPdg, double aEnergy, double aAngle) const;
+  /// PDG codes of the particles
+  std::vector<int32_t> m_pdgs;
+  /// Edges of the energy bins (MeV)
+  std::vector<double> m_energyEdges;
+  /// Edges of the angle bins (rad)
+  std::vector<double> m_angleEdges;
+  /// Maximum number of showers stored per bin
+  size_t m_maxShowersPerBin;
+  /// Showers of each bin
+  std::vector<std::vector<ShowerLibrary::ShowerEntry>> m_binShowers;
+  /// Spots of each bin, indexed from the start of the bin
+  std::vector<std::vector<ShowerLibrary::Spot>> m_binSpots;
+  /// Number of stored showers
+  size_t m_numShowers = 0;
+};
+} // namespace sim
+
+#endif /* SIMG4FAST_SHOWERLIBRARY_H */
@@ -0,0 +1,122 @@
+#ifndef SIMG4FAST_SHOWERLIBRARYMODEL_H
+#define SIMG4FAST_SHOWERLIBRARYMODEL_H
+
+// FCCSW
+#include "SimG4Fast/CalorimeterHitDepositor.h"
+#include "SimG4Fast/ShowerLibrary.h"
+
+// Geant
+#include "G4ThreeVector.hh"
+#include "G4VFastSimulationModel.hh"
+
+// DD4hep
+#include "DD4hep/Segmentations.h"
+
+// STL
+#include <memory>
+#include <string>
+#include <vector>
+
+/** @class sim::ShowerLibraryModel SimG4Fast/SimG4Fast/ShowerLibraryModel.h ShowerLibraryModel.h
+ *
+ *  Fast simulation model replacing the showers of low-energy particles by pre-simulated (frozen) showers.
+ *  The entry angle is the angle between the particle direction and the inward normal of the closest surface of the
+ *  envelope: 0 for a particle entering perpendicularly to the surface, pi/2 for a grazing one.
+ *  In the substitution mode (with sim::ShowerLibrary), the particles in the energy range of the model entering the
+ *  envelope, for which the library has showers, are killed and replaced by a random shower of their bin. The
+ *  shower is rotated to the particle direction (with a random rotation around it) and translated to the particle
+ *  position, its energy is scaled to the particle energy and it is deposited into the hits of the readout by
+ *  sim::CalorimeterHitDepositor.
+ *  In the harvesting mode (with sim::ShowerLibraryWriter), the model never triggers. Events with exactly one
+ *  particle in the energy range entering the envelope are fully simulated, and when Geant4 flushes the fast
+ *  simulation models at the end of the event, the hits of the readout are converted to the shower frame of that
+ *  particle and added to the library. Harvesting is meant to be run with single particles.
+ */
+
+namespace sim {
+class ShowerLibraryModel : public G4VFastSimulationModel {
+public:
+  /** Constructor of the substitution mode.
+   *  @param aModelName Name of the fast simulation model.
+   *  @param aEnvelope Region where the model can take over the ordinary tracking.
+   *  @param aLibrary Library of showers (not owned).
+   *  @param aReadoutName Name of the readout (and of the hits collection) where energy is deposited.
+   *  @param aSegmentation Segmentation of the readout.
+   *  @param aMinEnergy Minimum energy of the particle that triggers the model.
+   *  @param aMaxEnergy Maximum energy of the particle that triggers the model.
+   */
+  ShowerLibraryModel(const std::string& aModelName, G4Region* aEnvelope, const ShowerLibrary& aLibrary,
+                     const std::string& aReadoutName, dd4hep::Segmentation aSegmentation, double aMinEnergy,
+                     double aMaxEnergy);
+  /** Constructor of the harvesting mode.
+   *  @param aModelName Name of the fast simulation model.
+   *  @param aEnvelope Region where the showers are harvested.
+   *  @param aWriter Library under construction (not owned).
+   *  @param aReadoutName Name of the readout (and of the hits collection) from which the showers are harvested.
+   *  @param aMinEnergy Minimum energy of the particle which shower is harvested.
+   *  @param aMaxEnergy Maximum energy of the particle which shower is harvested.
+   */
+  ShowerLibraryModel(const std::string& aModelName, G4Region* aEnvelope, ShowerLibraryWriter& aWriter,
+                     const std::string& aReadoutName, double aMinEnergy, double aMaxEnergy);
+  virtual ~ShowerLibraryModel();
+  /// All particles can trigger the model, the library decides which ones are substituted
+  virtual G4bool IsApplicable(const G4ParticleDefinition&) final { return true; }
+  /** Check if the particle is substituted by a library shower (always false when harvesting).
+   *  @param aFastTrack Track.
+   *  @return true if the model is triggered
+   */
+  virtual G4bool ModelTrigger(const G4FastTrack& aFastTrack) final;
+  /** Kill the particle and deposit a library shower instead.
+   *  @param aFastTrack Track.
+   *  @param aFastStep Step.
+   */
+  virtual void DoIt(const G4FastTrack& aFastTrack, G4FastStep& aFastStep) final;
+  /// Harvest the shower of the event, called by Geant4 at the end of the event.
+  virtual void Flush() final;
+
+private:
+  /// Particle which shower is harvested
+  struct HarvestedParticle {
+    /// Entry point
+    G4ThreeVector position;
+    /// Direction
+    G4ThreeVector direction;
+    /// Kinetic energy
+    double energy;
+    /// Entry angle, with respect to the inward normal of the envelope surface
+    double angle;
+    /// PDG code
+    int pdg;
+  };
+  /** Record the particle entering the envelope, for harvesting.
+   *  @param aFastTrack Track entering the envelope.
+   */
+  void recordHarvestedParticle(const G4FastTrack& aFastTrack);
+  /// Library of showers (nullptr when harvesting)
+  const ShowerLibrary* m_library = nullptr;
+  /// Library under construction (nullptr when substituting)
+  ShowerLibraryWriter* m_writer = nullptr;
+  /// Name of the readout (and of the hits collection)
+  std::string m_readoutName;
+  /// Minimum energy of the particle that triggers the model
+  double m_minEnergy;
+  /// Maximum energy of the particle that triggers the model
+  double m_maxEnergy;
+  /// Deposits the library showers into the calorimeter hits (nullptr when harvesting)
+  std::unique_ptr<CalorimeterHitDepositor> m_depositor;
+  /// Positions of the spots of the current shower (global frame)
+  std::vector<G4ThreeVector> m_positions;
+  /// Energies of the spots of the current shower
+  std::vector<double> m_energies;
+  /// Particles entering the envelope in the current event, when harvesting
+  std::vector<HarvestedParticle> m_harvested;
+  /// Identifier of the event of the particles in m_harvested
+  int m_harvestEventId = -1;
+  /// Identifier of the event which was last harvested, so it is harvested only once
+  int m_lastHarvestedEventId = -1;
+  /// Spots of the harvested shower
+  std::vector<ShowerLibrary::Spot> m_spots;
+};
+} // namespace sim
+
+#endif /* SIMG4FAST_SHOWERLIBRARYMODEL_H */
@@ -1,20 +1,30 @@
 #include "SimG4FastSimCalorimeterRegion.h"
 
+// FCCSW
+#include "SimG4Fast/GFlashBatchShowerModel.h"
+#include "SimG4Common/VolumeSelector.h"
+
+// DD4hep
+#include "DD4hep/Detector.h"
+
 // Geant4
 #include "G4Electron.hh"
 #include "G4Positron.hh"
+#include "G4LogicalVolume.hh"
 #include "G4RegionStore.hh"
-#include "G4TransportationManager.hh"
 #include "G4VFastSimulationModel.hh"
 #include "GFlashShowerModel.hh"
 
 #include "G4NistManager.hh"
 
+// STL
+#include <algorithm>
+
 DECLARE_COMPONENT(SimG4FastSimCalorimeterRegion)
 
 SimG4FastSimCalorimeterRegion::SimG4FastSimCalorimeterRegion(const std::string& type, const std::string& name,
                                                              const IInterface* parent)
-    : AlgTool(type, name, parent) {
+    : AlgTool(type, name, parent), m_geoSvc("GeoSvc", name) {
   declareInterface<ISimG4RegionTool>(this);
   declareProperty("parametrisation", m_parametrisationTool,
                   "Pointer to a parametrisation tool, to retrieve calorimeter parametrisation");
@@ -30,57 +40,113 @@ StatusCode SimG4FastSimCalorimeterRegion::initialize() {
     error() << "No detector name is specified for the parametrisation" << endmsg;
     return StatusCode::FAILURE;
   }
-  if (m_minTriggerEnergy > m_maxTriggerEnergy) {
-    error() << "Energy range is not defined properly" << endmsg;
-    return StatusCode::FAILURE;
+  for (const auto* perParticle :
+       {&m_minTriggerEnergyPerParticle, &m_maxTriggerEnergyPerParticle, &m_energyToKillPerParticle}) {
+    for (const auto& bound : perParticle->value()) {
+      if (bound.first != "e-" && bound.first != "e+") {
+        error() << "GFlash bounds can only be set for e- and e+, not for " << bound.first << endmsg;
+        return StatusCode::FAILURE;
+      }
+    }
+  }
+  for (const std::string particle : {"e-", "e+"}) {
+    if (particleBound(m_minTriggerEnergyPerParticle, particle, m_minTriggerEnergy) >
+        particleBound(m_maxTriggerEnergyPerParticle, particle, m_maxTriggerEnergy)) {
+      error() << "Energy range is not defined properly for " << particle << endmsg;
+      return StatusCode::FAILURE;
+    }
   }
   if (!m_parametrisationTool.retrieve()) {
     error() << "GFlash parametrisation tool cannot be retieved" << endmsg;
     return StatusCode::FAILURE;
   }
+  for (const auto& volumeTool : m_volumeParametrisations) {
+    if (std::find(m_volumeNames.begin(), m_volumeNames.end(), volumeTool.first) == m_volumeNames.end()) {
+      error() << "Parametrisation tool " << volumeTool.second << " is given for volume " << volumeTool.first
+              << " which is not in volumeNames" << endmsg;
+      return StatusCode::FAILURE;
+    }
+    auto tool =
+        m_volumeParametrisationTools.emplace(volumeTool.first, ToolHandle<ISimG4GflashTool>(volumeTool.second, this))
+            .first;
+    if (!tool->second.retrieve()) {
+      error() << "GFlash parametrisation tool " << volumeTool.second << " of volume " << volumeTool.first
+              << " cannot be retieved" << endmsg;
+      return StatusCode::FAILURE;
+    }
+  }
+  if (m_batchDeposition) {
+    if (!m_geoSvc) {
+      error() << "Unable to locate Geometry Service, needed for the batch deposition of the energy spots" << endmsg;
+      return StatusCode::FAILURE;
+    }
+    auto readouts = m_geoSvc->getDetector()->readouts();
+    if (readouts.find(m_readoutName) == readouts.end()) {
+      error() << "Readout <<" << m_readoutName << ">> for the batch deposition of the energy spots not found"
+              << endmsg;
+      return StatusCode::FAILURE;
+    }
+  }
   return StatusCode::SUCCESS;
 }
 
 StatusCode SimG4FastSimCalorimeterRegion::finalize() { return AlgTool::finalize(); }
 
+double SimG4FastSimCalorimeterRegion::particleBound(const std::map<std::string, double>& aPerParticle,
+                                                    const std::string& aParticle, double aCommon) const {
+  auto bound = aPerParticle.find(aParticle);
+  return (bound == aPerParticle.end()) ? aCommon : bound->second;
+}
+
 StatusCode SimG4FastSimCalorimeterRegion::create() {
-  G4LogicalVolume* world =
-      (*G4TransportationManager::GetTransportationManager()->GetWorldsIterator())->GetLogicalVolume();
   for (const auto& calorimeterName : m_volumeNames) {
-    for (size_t iter_region = 0; iter_region < world->GetNoDaughters(); ++iter_region) {
-      if (world->GetDaughter(iter_region)->GetName().find(calorimeterName) != std::string::npos) {
-        /// all G4Region objects are deleted by the G4RegionStore
-        m_g4regions.emplace_back(
-            new G4Region(world->GetDaughter(iter_region)->GetLogicalVolume()->GetName() + "_fastsim"));
-        m_g4regions.back()->AddRootLogicalVolume(world->GetDaughter(iter_region)->GetLogicalVolume());
-        std::unique_ptr<GFlashShowerModel> model(
-            new GFlashShowerModel(m_g4regions.back()->GetName(), m_g4regions.back()));
-        // make model active (by default it is inactive)
-        model->SetFlagParamType(1);
-        // energy cuts - currently all are the same
-        m_particleBounds = std::unique_ptr<GFlashParticleBounds>(new GFlashParticleBounds());
-        m_particleBounds->SetMinEneToParametrise(*G4Electron::ElectronDefinition(),
-                                                 m_minTriggerEnergy / Gaudi::Units::MeV);
-        m_particleBounds->SetMinEneToParametrise(*G4Positron::PositronDefinition(),
-                                                 m_minTriggerEnergy / Gaudi::Units::MeV);
-        m_particleBounds->SetMaxEneToParametrise(*G4Electron::ElectronDefinition(),
-                                                 m_maxTriggerEnergy / Gaudi::Units::MeV);
-        m_particleBounds->SetMaxEneToParametrise(*G4Positron::PositronDefinition(),
-                                                 m_maxTriggerEnergy / Gaudi::Units::MeV);
-        m_particleBounds->SetEneToKill(*G4Electron::ElectronDefinition(), m_energyToKill / Gaudi::Units::MeV);
-        m_particleBounds->SetEneToKill(*G4Positron::PositronDefinition(), m_energyToKill / Gaudi::Units::MeV);
-        model->SetParticleBounds(*m_particleBounds);
-
-        // set parametrisation with the material
-        m_parametrisation = std::unique_ptr<GVFlashShowerParameterisation>(m_parametrisationTool->parametrisation());
-        model->SetParameterisation(*m_parametrisation);
-        // Makes the Energy Spots in the SD attached to the volume
-        m_hitMaker = std::unique_ptr<GFlashHitMaker>(new GFlashHitMaker());
-        model->SetHitMaker(*m_hitMaker);
-        m_models.push_back(std::move(model));
-        info() << "Attaching a Calorimeter fast simulation model (GFlash) to the region "
-               << m_g4regions.back()->GetName() << endmsg;
+    std::vector<G4LogicalVolume*> volumes;
+    std::string selectionError;
+    if (!sim::VolumeSelector::geometry().select(calorimeterName, volumes, selectionError)) {
+      error() << selectionError << endmsg;
+      return StatusCode::FAILURE;
+    }
+    for (auto* volume : volumes) {
+      /// all G4Region objects are deleted by the G4RegionStore
+      m_g4regions.emplace_back(new G4Region(volume->GetName() + "_fastsim"));
+      m_g4regions.back()->AddRootLogicalVolume(volume);
+      // set parametrisation with the material, from the tool of this volume if defined
+      auto volumeTool = m_volumeParametrisationTools.find(calorimeterName);
+      ISimG4GflashTool* parametrisationTool =
+          (volumeTool == m_volumeParametrisationTools.end()) ? m_parametrisationTool.get() : volumeTool->second.get();
+      m_parametrisations.push_back(parametrisationTool->parametrisation());
+      GVFlashShowerParameterisation& parametrisation = *m_parametrisations.back();
+      std::unique_ptr<GFlashShowerModel> model;
+      if (m_batchDeposition) {
+        model = std::make_unique<sim::GFlashBatchShowerModel>(
+            m_g4regions.back()->GetName(), m_g4regions.back(), parametrisation, m_readoutName,
+            m_geoSvc->getDetector()->readout(m_readoutName).segmentation());
+      } else {
+        model = std::make_unique<GFlashShowerModel>(m_g4regions.back()->GetName(), m_g4regions.back());
+      }
+      // make model active (by default it is inactive)
+      model->SetFlagParamType(1);
+      // energy cuts, per particle type
+      m_particleBounds.push_back(std::make_unique<GFlashParticleBounds>());
+      for (G4ParticleDefinition* particle : {G4Electron::ElectronDefinition(), G4Positron::PositronDefinition()}) {
+        const std::string& particleName = particle->GetParticleName();
+        m_particleBounds.back()->SetMinEneToParametrise(
+            *particle, particleBound(m_minTriggerEnergyPerParticle, particleName, m_minTriggerEnergy) /
+                           Gaudi::Units::MeV);
+        m_particleBounds.back()->SetMaxEneToParametrise(
+            *particle, particleBound(m_maxTriggerEnergyPerParticle, particleName, m_maxTriggerEnergy) /
+                           Gaudi::Units::MeV);
+        m_particleBounds.back()->SetEneToKill(
+            *particle, particleBound(m_energyToKillPerParticle, particleName, m_energyToKill) / Gaudi::Units::MeV);
       }
+      model->SetParticleBounds(*m_particleBounds.back());
+      model->SetParameterisation(parametrisation);
+      // Makes the Energy Spots in the SD attached to the volume
+      m_hitMakers.push_back(std::make_unique<GFlashHitMaker>());
+      model->SetHitMaker(*m_hitMakers.back());
+      m_models.push_back(std::move(model));
+      info() << "Attaching a Calorimeter fast simulation model (GFlash) to the region "
+             << m_g4regions.back()->GetName() << endmsg;
     }
   }
   return StatusCode::SUCCESS;
@@ -9,6 +9,10 @@
 // FCCSW
 #include "SimG4Interface/ISimG4GflashTool.h"
 #include "SimG4Interface/ISimG4RegionTool.h"
+#include "k4Interface/IGeoSvc.h"
+
+// STL
+#include <map>
 
 // Geant
 #include "GFlashHitMaker.hh"
@@ -22,7 +26,13 @@ class G4Region;
  *
  *  Tool for creating regions for fast simulation, attaching GFlashModel to them.
  *  Regions are created for volumes specified in the job options (\b'volumeNames').
- *  Details on the parametrisation of shower profiles is set by tool '\b parametrisation'
+ *  Details on the parametrisation of shower profiles is set by tool '\b parametrisation', which can be replaced
+ *  for some of the volumes by the tools given in '\b volumeParametrisations' (volume name -> tool).
+ *  Trigger and kill energies are common to electrons and positrons, unless set for one particle type
+ *  ("e-" or "e+") in '\b minEnergyPerParticle', '\b maxEnergyPerParticle' or '\b energyToKillPerParticle'.
+ *  Each region owns its parametrisation, particle bounds and hit maker.
+ *  If '\b batchDeposition' is set, the energy spots are deposited directly into the hits of the readout
+ *  '\b readoutName' by sim::GFlashBatchShowerModel, instead of calling the sensitive detector for each spot.
  *  [For more information please see](@ref md_sim_doc_geant4fastsim).
  *
  *  @author Anna Zaborowska
@@ -50,19 +60,31 @@ public:
   inline virtual const std::vector<std::string>& volumeNames() const final { return m_volumeNames; };
 
 private:
+  /// Pointer to the geometry service
+  ServiceHandle<IGeoSvc> m_geoSvc;
+  /**  Get the energy bound of the particle type, falling back to the common value.
+   *   @param[in] aPerParticle Bounds set per particle type.
+   *   @param[in] aParticle Name of the particle type.
+   *   @param[in] aCommon Common bound of electrons and positrons.
+   *   @return energy bound
+   */
+  double particleBound(const std::map<std::string, double>& aPerParticle, const std::string& aParticle,
+                       double aCommon) const;
   /// Pointer to a parametrisation tool, to retrieve calorimeter parametrisation
   ToolHandle<ISimG4GflashTool> m_parametrisationTool{"SimG4GflashHomo", this, true};
+  /// Parametrisation tools of the volumes which do not use m_parametrisationTool
+  std::map<std::string, ToolHandle<ISimG4GflashTool>> m_volumeParametrisationTools;
   /// Envelopes that are used in a parametric simulation
   /// deleted by the G4RegionStore
   std::vector<G4Region*> m_g4regions;
   /// Fast simulation (parametrisation) models
   std::vector<std::unique_ptr<G4VFastSimulationModel>> m_models;
-  /// GFlash model parametrisation (retrieved from the m_parametrisationTool)
-  std::unique_ptr<GVFlashShowerParameterisation> m_parametrisation{nullptr};
-  /// GFlash model configuration
-  std::unique_ptr<GFlashParticleBounds> m_particleBounds{nullptr};
-  /// GFlash hit maker
-  std::unique_ptr<GFlashHitMaker> m_hitMaker{nullptr};
+  /// GFlash model parametrisations, one per region
+  std::vector<std::unique_ptr<GVFlashShowerParameterisation>> m_parametrisations;
+  /// GFlash model configurations, one per region
+  std::vector<std::unique_ptr<GFlashParticleBounds>> m_particleBounds;
+  /// GFlash hit makers, one per region
+  std::vector<std::unique_ptr<GFlashHitMaker>> m_hitMakers;
   /// Names of the parametrised volumes (set by job options)
   Gaudi::Property<std::vector<std::string>> m_volumeNames{
       this, "volumeNames", {}, "Names of the parametrised volumes (set by job options)"};
@@ -70,11 +92,30 @@ private:
   Gaudi::Property<double> m_minTriggerEnergy{this, "minEnergy", 0.1 * Gaudi::Units::GeV,
                                              "minimum energy of the electron (positron) that triggers the model"};
   /// maximum energy of the electron (positron) that triggers the model
-  Gaudi::Property<double> m_maxTriggerEnergy{this, "minEnergy", 10 * Gaudi::Units::TeV,
+  Gaudi::Property<double> m_maxTriggerEnergy{this, "maxEnergy", 10 * Gaudi::Units::TeV,
                                              "maximum energy of the electron (positron) that triggers the model"};
   /// threshold below which the electrons (positrons) are killed
-  Gaudi::Property<double> m_energyToKill{this, "minEnergy", 0.1 * Gaudi::Units::GeV,
+  Gaudi::Property<double> m_energyToKill{this, "energyToKill", 0.1 * Gaudi::Units::GeV,
                                          "threshold below which the electrons (positrons) are killed"};
+  /// minimum energy that triggers the model, per particle type ("e-", "e+"), overriding minEnergy
+  Gaudi::Property<std::map<std::string, double>> m_minTriggerEnergyPerParticle{
+      this, "minEnergyPerParticle", {}, "minimum energy that triggers the model, per particle type (e-, e+)"};
+  /// maximum energy that triggers the model, per particle type ("e-", "e+"), overriding maxEnergy
+  Gaudi::Property<std::map<std::string, double>> m_maxTriggerEnergyPerParticle{
+      this, "maxEnergyPerParticle", {}, "maximum energy that triggers the model, per particle type (e-, e+)"};
+  /// threshold below which the particles are killed, per particle type ("e-", "e+"), overriding energyToKill
+  Gaudi::Property<std::map<std::string, double>> m_energyToKillPerParticle{
+      this, "energyToKillPerParticle", {},
+      "threshold below which the particles are killed, per particle type (e-, e+)"};
+  /// Parametrisation tools of the volumes, volume name -> tool type/name (set by job options)
+  Gaudi::Property<std::map<std::string, std::string>> m_volumeParametrisations{
+      this, "volumeParametrisations", {}, "Parametrisation tools of the volumes (volume name -> tool type/name)"};
+  /// Flag to deposit the energy spots directly into the calorimeter hits (set by job options)
+  Gaudi::Property<bool> m_batchDeposition{this, "batchDeposition", false,
+                                          "Deposit the energy spots directly into the calorimeter hits"};
+  /// Name of the readout where the energy spots are deposited, if batchDeposition is set (set by job options)
+  Gaudi::Property<std::string> m_readoutName{this, "readoutName", "",
+                                             "Name of the readout where the energy spots are deposited"};
 };
 
 #endif /* SIMG4FAST_SIMG4FASTSIMCALORIMETERREGION_H */
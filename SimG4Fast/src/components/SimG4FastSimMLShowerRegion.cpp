@@ -0,0 +1,92 @@
+#include "SimG4FastSimMLShowerRegion.h"
+
+// FCCSW
+#include "SimG4Fast/MLShowerModel.h"
+#include "SimG4Common/VolumeSelector.h"
+
+// DD4hep
+#include "DD4hep/Detector.h"
+
+// Geant4
+#include "G4LogicalVolume.hh"
+#include "G4RegionStore.hh"
+#include "G4VFastSimulationModel.hh"
+
+DECLARE_COMPONENT(SimG4FastSimMLShowerRegion)
+
+SimG4FastSimMLShowerRegion::SimG4FastSimMLShowerRegion(const std::string& type, const std::string& name,
+                                                       const IInterface* parent)
+    : AlgTool(type, name, parent), m_geoSvc("GeoSvc", name) {
+  declareInterface<ISimG4RegionTool>(this);
+}
+
+SimG4FastSimMLShowerRegion::~SimG4FastSimMLShowerRegion() {}
+
+StatusCode SimG4FastSimMLShowerRegion::initialize() {
+  if (AlgTool::initialize().isFailure()) {
+    return StatusCode::FAILURE;
+  }
+  if (m_volumeNames.size() == 0) {
+    error() << "No detector name is specified for the parametrisation" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  if (m_minTriggerEnergy > m_maxTriggerEnergy) {
+    error() << "Energy range is not defined properly" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  if (m_numVoxelsR == 0 || m_numVoxelsPhi == 0 || m_numVoxelsZ == 0 || m_voxelSizeR <= 0 || m_voxelSizeZ <= 0) {
+    error() << "Voxel grid is not defined properly" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  std::string networkError;
+  if (!m_network.load(m_modelFile, networkError)) {
+    error() << "Shower network cannot be read from " << m_modelFile << ": " << networkError << endmsg;
+    return StatusCode::FAILURE;
+  }
+  if (m_network.inputSize() != 6 + m_latentSize) {
+    error() << "Shower network has " << m_network.inputSize() << " inputs, expected 6 particle conditions and "
+            << m_latentSize << " latent variables" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  if (m_network.outputSize() != m_numVoxelsR * m_numVoxelsPhi * m_numVoxelsZ) {
+    error() << "Shower network has " << m_network.outputSize() << " outputs, expected one per voxel ("
+            << m_numVoxelsR * m_numVoxelsPhi * m_numVoxelsZ << ")" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  if (!m_geoSvc) {
+    error() << "Unable to locate Geometry Service, needed for the deposition of the showers" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  auto readouts = m_geoSvc->getDetector()->readouts();
+  if (readouts.find(m_readoutName) == readouts.end()) {
+    error() << "Readout <<" << m_readoutName << ">> for the deposition of the showers not found" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  return StatusCode::SUCCESS;
+}
+
+StatusCode SimG4FastSimMLShowerRegion::finalize() { return AlgTool::finalize(); }
+
+StatusCode SimG4FastSimMLShowerRegion::create() {
+  sim::MLShowerModel::VoxelGrid grid{m_numVoxelsR, m_numVoxelsPhi, m_numVoxelsZ, m_voxelSizeR, m_voxelSizeZ};
+  for (const auto& calorimeterName : m_volumeNames) {
+    std::vector<G4LogicalVolume*> volumes;
+    std::string selectionError;
+    if (!sim::VolumeSelector::geometry().select(calorimeterName, volumes, selectionError)) {
+      error() << selectionError << endmsg;
+      return StatusCode::FAILURE;
+    }
+    for (auto* volume : volumes) {
+      /// all G4Region objects are deleted by the G4RegionStore
+      m_g4regions.emplace_back(new G4Region(volume->GetName() + "_fastsim"));
+      m_g4regions.back()->AddRootLogicalVolume(volume);
+      m_models.push_back(std::make_unique<sim::MLShowerModel>(
+          m_g4regions.back()->GetName(), m_g4regions.back(), m_network, m_latentSize, grid, m_readoutName,
+          m_geoSvc->getDetector()->readout(m_readoutName).segmentation(), m_particles, m_minTriggerEnergy,
+          m_maxTriggerEnergy, m_batchSize));
+      info() << "Attaching a Calorimeter fast simulation model (neural network) to the region "
+             << m_g4regions.back()->GetName() << endmsg;
+    }
+  }
+  return StatusCode::SUCCESS;
+}
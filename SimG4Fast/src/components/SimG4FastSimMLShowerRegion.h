@@ -0,0 +1,96 @@
+#ifndef SIMG4FAST_SIMG4FASTSIMMLSHOWERREGION_H
+#define SIMG4FAST_SIMG4FASTSIMMLSHOWERREGION_H
+
+// Gaudi
+#include "GaudiKernel/AlgTool.h"
+#include "GaudiKernel/SystemOfUnits.h"
+
+// FCCSW
+#include "SimG4Fast/DenseNetwork.h"
+#include "SimG4Interface/ISimG4RegionTool.h"
+#include "k4Interface/IGeoSvc.h"
+
+// Geant
+class G4VFastSimulationModel;
+class G4Region;
+
+/** @class SimG4FastSimMLShowerRegion SimG4Fast/src/components/SimG4FastSimMLShowerRegion.h
+ * SimG4FastSimMLShowerRegion.h
+ *
+ *  Tool for creating regions for fast simulation, attaching to them a shower model based on a neural network
+ *  (sim::MLShowerModel), evaluated on the CPU.
+ *  Regions are created for volumes specified in the job options (\b'volumeNames').
+ *  The network is read from the file '\b modelFile' (format described in sim::DenseNetwork). It takes the particle
+ *  energy, direction and entry point and '\b latentSize' latent variables, and returns the energies of the voxels of
+ *  a cylindrical grid ('\b numVoxelsR' x '\b numVoxelsPhi' x '\b numVoxelsZ', of size '\b voxelSizeR' and
+ *  '\b voxelSizeZ'), which are deposited into the hits of the readout '\b readoutName'.
+ *  The showers of the particles of an event are generated in batches of up to '\b batchSize' particles.
+ *  [For more information please see](@ref md_sim_doc_geant4fastsim).
+ */
+
+class SimG4FastSimMLShowerRegion : public AlgTool, virtual public ISimG4RegionTool {
+public:
+  explicit SimG4FastSimMLShowerRegion(const std::string& type, const std::string& name, const IInterface* parent);
+  virtual ~SimG4FastSimMLShowerRegion();
+  /**  Initialize, reading the network.
+   *   @return status code
+   */
+  virtual StatusCode initialize() final;
+  /**  Finalize.
+   *   @return status code
+   */
+  virtual StatusCode finalize() final;
+  /**  Create regions and fast simulation models
+   *   @return status code
+   */
+  virtual StatusCode create() final;
+  /**  Get the names of the volumes where fast simulation should be performed.
+   *   @return vector of volume names
+   */
+  inline virtual const std::vector<std::string>& volumeNames() const final { return m_volumeNames; };
+
+private:
+  /// Pointer to the geometry service
+  ServiceHandle<IGeoSvc> m_geoSvc;
+  /// Shower generator, shared by the models of all the regions
+  sim::DenseNetwork m_network;
+  /// Envelopes that are used in a parametric simulation
+  /// deleted by the G4RegionStore
+  std::vector<G4Region*> m_g4regions;
+  /// Fast simulation (parametrisation) models
+  std::vector<std::unique_ptr<G4VFastSimulationModel>> m_models;
+  /// Names of the parametrised volumes (set by job options)
+  Gaudi::Property<std::vector<std::string>> m_volumeNames{
+      this, "volumeNames", {}, "Names of the parametrised volumes (set by job options)"};
+  /// File with the network (set by job options)
+  Gaudi::Property<std::string> m_modelFile{this, "modelFile", "", "File with the network generating the showers"};
+  /// Number of latent variables of the network
+  Gaudi::Property<size_t> m_latentSize{this, "latentSize", 10, "Number of latent variables of the network"};
+  /// Number of radial bins of the voxel grid
+  Gaudi::Property<size_t> m_numVoxelsR{this, "numVoxelsR", 18, "Number of radial bins of the voxel grid"};
+  /// Number of azimuthal bins of the voxel grid
+  Gaudi::Property<size_t> m_numVoxelsPhi{this, "numVoxelsPhi", 50, "Number of azimuthal bins of the voxel grid"};
+  /// Number of longitudinal bins of the voxel grid
+  Gaudi::Property<size_t> m_numVoxelsZ{this, "numVoxelsZ", 45, "Number of longitudinal bins of the voxel grid"};
+  /// Radial size of the voxels
+  Gaudi::Property<double> m_voxelSizeR{this, "voxelSizeR", 2.325 * Gaudi::Units::mm, "Radial size of the voxels"};
+  /// Longitudinal size of the voxels
+  Gaudi::Property<double> m_voxelSizeZ{this, "voxelSizeZ", 3.4 * Gaudi::Units::mm, "Longitudinal size of the voxels"};
+  /// Name of the readout where the showers are deposited (set by job options)
+  Gaudi::Property<std::string> m_readoutName{this, "readoutName", "",
+                                             "Name of the readout where the showers are deposited"};
+  /// PDG codes of the particles that trigger the model
+  Gaudi::Property<std::vector<int>> m_particles{
+      this, "particles", {11, -11, 22}, "PDG codes of the particles that trigger the model"};
+  /// minimum energy of the particle that triggers the model
+  Gaudi::Property<double> m_minTriggerEnergy{this, "minEnergy", 1 * Gaudi::Units::GeV,
+                                             "minimum energy of the particle that triggers the model"};
+  /// maximum energy of the particle that triggers the model
+  Gaudi::Property<double> m_maxTriggerEnergy{this, "maxEnergy", 1 * Gaudi::Units::TeV,
+                                             "maximum energy of the particle that triggers the model"};
+  /// Maximum number of particles which showers are generated together
+  Gaudi::Property<size_t> m_batchSize{this, "batchSize", 64,
+                                      "Maximum number of particles which showers are generated together"};
+};
+
+#endif /* SIMG4FAST_SIMG4FASTSIMMLSHOWERREGION_H */
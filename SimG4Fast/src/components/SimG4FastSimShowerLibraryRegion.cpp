@@ -0,0 +1,117 @@
+#include "SimG4FastSimShowerLibraryRegion.h"
+
+// FCCSW
+#include "SimG4Fast/ShowerLibraryModel.h"
+#include "SimG4Common/VolumeSelector.h"
+
+// DD4hep
+#include "DD4hep/Detector.h"
+
+// Geant4
+#include "G4LogicalVolume.hh"
+#include "G4RegionStore.hh"
+#include "G4VFastSimulationModel.hh"
+
+// STL
+#include <algorithm>
+
+DECLARE_COMPONENT(SimG4FastSimShowerLibraryRegion)
+
+SimG4FastSimShowerLibraryRegion::SimG4FastSimShowerLibraryRegion(const std::string& type, const std::string& name,
+                                                                 const IInterface* parent)
+    : AlgTool(type, name, parent), m_geoSvc("GeoSvc", name) {
+  declareInterface<ISimG4RegionTool>(this);
+}
+
+SimG4FastSimShowerLibraryRegion::~SimG4FastSimShowerLibraryRegion() {}
+
+StatusCode SimG4FastSimShowerLibraryRegion::initialize() {
+  if (AlgTool::initialize().isFailure()) {
+    return StatusCode::FAILURE;
+  }
+  if (m_volumeNames.size() == 0) {
+    error() << "No detector name is specified for the parametrisation" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  if (m_minEnergy > m_maxEnergy) {
+    error() << "Energy range is not defined properly" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  if (m_libraryFile.value().empty()) {
+    error() << "No shower library file is specified" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  if (m_harvest) {
+    if (m_readoutName.value().empty()) {
+      error() << "No readout is specified for the harvesting of the showers" << endmsg;
+      return StatusCode::FAILURE;
+    }
+    for (const auto* edges : {&m_energyBins, &m_angleBins}) {
+      if (edges->value().size() < 2 || !std::is_sorted(edges->value().begin(), edges->value().end())) {
+        error() << "Bins of " << edges->name() << " must be given as at least two increasing edges" << endmsg;
+        return StatusCode::FAILURE;
+      }
+    }
+    m_writer = std::make_unique<sim::ShowerLibraryWriter>(m_particles, m_energyBins, m_angleBins, m_maxShowersPerBin);
+    info() << "Showers will be harvested into the library " << m_libraryFile << endmsg;
+    return StatusCode::SUCCESS;
+  }
+  std::string libraryError;
+  if (!m_library.open(m_libraryFile, libraryError)) {
+    error() << "Shower library cannot be mapped: " << libraryError << endmsg;
+    return StatusCode::FAILURE;
+  }
+  info() << "Shower library " << m_libraryFile << " mapped with " << m_library.numShowers() << " showers" << endmsg;
+  if (!m_geoSvc) {
+    error() << "Unable to locate Geometry Service, needed for the deposition of the showers" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  auto readouts = m_geoSvc->getDetector()->readouts();
+  if (readouts.find(m_readoutName) == readouts.end()) {
+    error() << "Readout <<" << m_readoutName << ">> for the deposition of the showers not found" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  return StatusCode::SUCCESS;
+}
+
+StatusCode SimG4FastSimShowerLibraryRegion::finalize() {
+  if (m_writer) {
+    std::string libraryError;
+    if (!m_writer->write(m_libraryFile, libraryError)) {
+      error() << "Shower library cannot be written: " << libraryError << endmsg;
+      return StatusCode::FAILURE;
+    }
+    info() << "Shower library " << m_libraryFile << " written with " << m_writer->numShowers() << " showers"
+           << endmsg;
+  }
+  return AlgTool::finalize();
+}
+
+StatusCode SimG4FastSimShowerLibraryRegion::create() {
+  for (const auto& calorimeterName : m_volumeNames) {
+    std::vector<G4LogicalVolume*> volumes;
+    std::string selectionError;
+    if (!sim::VolumeSelector::geometry().select(calorimeterName, volumes, selectionError)) {
+      error() << selectionError << endmsg;
+      return StatusCode::FAILURE;
+    }
+    for (auto* volume : volumes) {
+      /// all G4Region objects are deleted by the G4RegionStore
+      m_g4regions.emplace_back(new G4Region(volume->GetName() + "_fastsim"));
+      m_g4regions.back()->AddRootLogicalVolume(volume);
+      if (m_harvest) {
+        m_models.push_back(std::make_unique<sim::ShowerLibraryModel>(m_g4regions.back()->GetName(),
+                                                                     m_g4regions.back(), *m_writer, m_readoutName,
+                                                                     m_minEnergy, m_maxEnergy));
+        info() << "Harvesting showers in the region " << m_g4regions.back()->GetName() << endmsg;
+      } else {
+        m_models.push_back(std::make_unique<sim::ShowerLibraryModel>(
+            m_g4regions.back()->GetName(), m_g4regions.back(), m_library, m_readoutName,
+            m_geoSvc->getDetector()->readout(m_readoutName).segmentation(), m_minEnergy, m_maxEnergy));
+        info() << "Attaching a Calorimeter fast simulation model (shower library) to the region "
+               << m_g4regions.back()->GetName() << endmsg;
+      }
+    }
+  }
+  return StatusCode::SUCCESS;
+}
@@ -0,0 +1,104 @@
+#ifndef SIMG4FAST_SIMG4FASTSIMSHOWERLIBRARYREGION_H
+#define SIMG4FAST_SIMG4FASTSIMSHOWERLIBRARYREGION_H
+
+// Gaudi
+#include "GaudiKernel/AlgTool.h"
+#include "GaudiKernel/SystemOfUnits.h"
+
+// FCCSW
+#include "SimG4Fast/ShowerLibrary.h"
+#include "SimG4Interface/ISimG4RegionTool.h"
+#include "k4Interface/IGeoSvc.h"
+
+// STL
+#include <memory>
+
+// Geant
+class G4VFastSimulationModel;
+class G4Region;
+
+/** @class SimG4FastSimShowerLibraryRegion SimG4Fast/src/components/SimG4FastSimShowerLibraryRegion.h
+ * SimG4FastSimShowerLibraryRegion.h
+ *
+ *  Tool for creating regions for fast simulation, attaching to them a shower library model (sim::ShowerLibraryModel).
+ *  Regions are created for volumes specified in the job options (\b'volumeNames').
+ *  By default the particles in the region with energy between '\b minEnergy' and '\b maxEnergy' are replaced by
+ *  pre-simulated showers of the library '\b libraryFile', deposited into the hits of the readout '\b readoutName'.
+ *  If '\b harvest' is set, the showers are harvested instead from the full simulation of single particles, and
+ *  the library is written to '\b libraryFile' at finalization, binned in '\b particles', '\b energyBins' and
+ *  '\b angleBins' (angle to the inward normal of the envelope surface), with up to '\b maxShowersPerBin' showers
+ *  per bin.
+ *  [For more information please see](@ref md_sim_doc_geant4fastsim).
+ */
+
+class SimG4FastSimShowerLibraryRegion : public AlgTool, virtual public ISimG4RegionTool {
+public:
+  explicit SimG4FastSimShowerLibraryRegion(const std::string& type, const std::string& name,
+                                           const IInterface* parent);
+  virtual ~SimG4FastSimShowerLibraryRegion();
+  /**  Initialize, mapping the library (or preparing the harvested one).
+   *   @return status code
+   */
+  virtual StatusCode initialize() final;
+  /**  Finalize, writing the harvested library.
+   *   @return status code
+   */
+  virtual StatusCode finalize() final;
+  /**  Create regions and fast simulation models
+   *   @return status code
+   */
+  virtual StatusCode create() final;
+  /**  Get the names of the volumes where fast simulation should be performed.
+   *   @return vector of volume names
+   */
+  inline virtual const std::vector<std::string>& volumeNames() const final { return m_volumeNames; };
+
+private:
+  /// Pointer to the geometry service
+  ServiceHandle<IGeoSvc> m_geoSvc;
+  /// Library of showers, when substituting
+  sim::ShowerLibrary m_library;
+  /// Library under construction, when harvesting
+  std::unique_ptr<sim::ShowerLibraryWriter> m_writer;
+  /// Envelopes that are used in a parametric simulation
+  /// deleted by the G4RegionStore
+  std::vector<G4Region*> m_g4regions;
+  /// Fast simulation (parametrisation) models
+  std::vector<std::unique_ptr<G4VFastSimulationModel>> m_models;
+  /// Names of the parametrised volumes (set by job options)
+  Gaudi::Property<std::vector<std::string>> m_volumeNames{
+      this, "volumeNames", {}, "Names of the parametrised volumes (set by job options)"};
+  /// File of the shower library (set by job options)
+  Gaudi::Property<std::string> m_libraryFile{this, "libraryFile", "", "File of the shower library"};
+  /// Name of the readout where the showers are deposited or harvested (set by job options)
+  Gaudi::Property<std::string> m_readoutName{this, "readoutName", "",
+                                             "Name of the readout where the showers are deposited or harvested"};
+  /// minimum energy of the particle that is replaced by a library shower
+  Gaudi::Property<double> m_minEnergy{this, "minEnergy", 0, "minimum energy of the particle replaced by a shower"};
+  /// maximum energy of the particle that is replaced by a library shower
+  Gaudi::Property<double> m_maxEnergy{this, "maxEnergy", 1 * Gaudi::Units::GeV,
+                                      "maximum energy of the particle replaced by a shower"};
+  /// Flag to harvest the showers and write the library instead of using it
+  Gaudi::Property<bool> m_harvest{this, "harvest", false, "Harvest the showers and write the library"};
+  /// PDG codes of the particles of the harvested library
+  Gaudi::Property<std::vector<int>> m_particles{
+      this, "particles", {11, -11, 22}, "PDG codes of the particles of the harvested library"};
+  /// Edges of the energy bins of the harvested library
+  Gaudi::Property<std::vector<double>> m_energyBins{
+      this,
+      "energyBins",
+      {0, 10 * Gaudi::Units::MeV, 50 * Gaudi::Units::MeV, 100 * Gaudi::Units::MeV, 500 * Gaudi::Units::MeV,
+       1 * Gaudi::Units::GeV},
+      "Edges of the energy bins of the harvested library"};
+  /// Edges of the entry angle bins of the harvested library
+  Gaudi::Property<std::vector<double>> m_angleBins{
+      this,
+      "angleBins",
+      {0, 0.25, 0.5, 0.75, 1, 1.25, 1.6},
+      "Edges of the entry angle bins of the harvested library (rad)"};
+  /// Maximum number of showers per bin of the harvested library
+  Gaudi::Property<size_t> m_maxShowersPerBin{this, "maxShowersPerBin", 100,
+                                             "Maximum number of showers per bin of the harvested library"};
+};
+
+#endif /* SIMG4FAST_SIMG4FASTSIMSHOWERLIBRARYREGION_H */
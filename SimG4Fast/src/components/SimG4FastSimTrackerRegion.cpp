@@ -2,10 +2,11 @@
 
 // FCCSW
 #include "SimG4Fast/FastSimModelTracker.h"
+#include "SimG4Common/VolumeSelector.h"
 
 // Geant4
+#include "G4LogicalVolume.hh"
 #include "G4RegionStore.hh"
-#include "G4TransportationManager.hh"
 #include "G4VFastSimulationModel.hh"
 
 DECLARE_COMPONENT(SimG4FastSimTrackerRegion)
@@ -46,19 +47,21 @@ StatusCode SimG4FastSimTrackerRegion::initialize() {
 StatusCode SimG4FastSimTrackerRegion::finalize() { return AlgTool::finalize(); }
 
 StatusCode SimG4FastSimTrackerRegion::create() {
-  G4LogicalVolume* world =
-      (*G4TransportationManager::GetTransportationManager()->GetWorldsIterator())->GetLogicalVolume();
   for (const auto& trackerName : m_volumeNames) {
-    for (size_t iter_region = 0; iter_region < world->GetNoDaughters(); ++iter_region) {
-      if (world->GetDaughter(iter_region)->GetName().find(trackerName) != std::string::npos) {
-        /// all G4Region objects are deleted by the G4RegionStore
-        m_g4regions.emplace_back(
-            new G4Region(world->GetDaughter(iter_region)->GetLogicalVolume()->GetName() + "_fastsim"));
-        m_g4regions.back()->AddRootLogicalVolume(world->GetDaughter(iter_region)->GetLogicalVolume());
-        m_models.emplace_back(new sim::FastSimModelTracker(m_g4regions.back()->GetName(), m_g4regions.back(),
-                                                           m_smearTool, m_minMomentum, m_maxMomentum, m_maxEta));
-        info() << "Attaching a Tracker fast simulation model to the region " << m_g4regions.back()->GetName() << endmsg;
-      }
+    std::vector<G4LogicalVolume*> volumes;
+    std::string selectionError;
+    if (!sim::VolumeSelector::geometry().select(trackerName, volumes, selectionError)) {
+      error() << selectionError << endmsg;
+      return StatusCode::FAILURE;
+    }
+    for (auto* volume : volumes) {
+      /// all G4Region objects are deleted by the G4RegionStore
+      m_g4regions.emplace_back(new G4Region(volume->GetName() + "_fastsim"));
+      m_g4regions.back()->AddRootLogicalVolume(volume);
+      m_models.emplace_back(new sim::FastSimModelTracker(m_g4regions.back()->GetName(), m_g4regions.back(),
+                                                         m_smearTool, m_minMomentum, m_maxMomentum, m_maxEta,
+                                                         m_analyticPropagation));
+      info() << "Attaching a Tracker fast simulation model to the region " << m_g4regions.back()->GetName() << endmsg;
     }
   }
   return StatusCode::SUCCESS;
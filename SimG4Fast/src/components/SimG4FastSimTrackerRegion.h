@@ -73,6 +73,10 @@ private:
   Gaudi::Property<double> m_maxMomentum{this, "maxMomentum", 0, "maximum momentum that triggers the fast sim model"};
   /// maximum pseudorapidity (set by job options)
   Gaudi::Property<double> m_maxEta{this, "maxEta", 0, "maximum pseudorapidity"};
+  /// Flag to compute the exit point analytically for cylindrical envelopes in uniform field (set by job options)
+  Gaudi::Property<bool> m_analyticPropagation{
+      this, "analyticPropagation", true,
+      "Compute the exit point analytically for cylindrical envelopes in uniform field, otherwise use G4PathFinder"};
 };
 
 #endif /* SIMG4FAST_SIMG4FASTSIMTRACKERREGION_H */
@@ -1,8 +1,11 @@
 #include "SimG4ParticleSmearFormula.h"
 
-// Gaudi
+// STL
+#include <algorithm>
+#include <cctype>
+#include <regex>
 
-#include "GaudiKernel/IRndmGen.h"
+// Gaudi
 #include "GaudiKernel/IRndmGenSvc.h"
 
 // ROOT
@@ -30,9 +33,24 @@ StatusCode SimG4ParticleSmearFormula::initialize() {
     error() << "Couldn't get RndmGenSvc" << endmsg;
     return StatusCode::FAILURE;
   }
+  if (m_normalDeviates.initialize(m_randSvc).isFailure()) {
+    error() << "Couldn't initialize the Gaussian random number generator" << endmsg;
+    return StatusCode::FAILURE;
+  }
   if (!m_resolutionMomentumStr.empty()) {
+    // the expression is parsed and compiled here, once, and not on each evaluation
     m_resolutionMomentum = TFormula("pdep", m_resolutionMomentumStr.value().c_str());
+    if (!m_resolutionMomentum.IsValid()) {
+      error() << "Unable to compile the momentum-dependent resolution: " << m_resolutionMomentumStr.value() << endmsg;
+      return StatusCode::FAILURE;
+    }
     info() << "Momentum-dependent resolutions: " << m_resolutionMomentum.GetExpFormula() << endmsg;
+    if (recogniseKernel(m_resolutionMomentumStr)) {
+      debug() << "Resolution evaluated with a dedicated kernel, coefficients: " << m_coeffA << ", " << m_coeffB
+              << endmsg;
+    } else {
+      m_kernel = Kernel::Formula;
+    }
   } else {
     info() << "No momentum-dependent resolutions defined." << endmsg;
   }
@@ -42,12 +60,101 @@ StatusCode SimG4ParticleSmearFormula::initialize() {
 StatusCode SimG4ParticleSmearFormula::finalize() { return AlgTool::finalize(); }
 
 StatusCode SimG4ParticleSmearFormula::smearMomentum(CLHEP::Hep3Vector& aMom, int /*aPdg*/) {
-  if (!m_resolutionMomentum.IsValid()) {
+  if (m_kernel == Kernel::None) {
     error() << "Unable to smear particle's momentum - no resolution given!" << endmsg;
     return StatusCode::FAILURE;
   }
-  m_randSvc->generator(Rndm::Gauss(1, m_resolutionMomentum.Eval(aMom.mag())), m_gauss).ignore();
-  double tmp = m_gauss->shoot();
-  aMom *= tmp;
+  aMom *= 1 + resolution(aMom.mag()) * m_normalDeviates.next();
+  return StatusCode::SUCCESS;
+}
+
+StatusCode SimG4ParticleSmearFormula::smearMomenta(std::span<CLHEP::Hep3Vector> aMom, std::span<const int> aPdg) {
+  if (!aPdg.empty() && aPdg.size() != aMom.size()) {
+    error() << "Number of PDG codes (" << aPdg.size() << ") differs from the number of momenta (" << aMom.size()
+            << ")" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  if (m_kernel == Kernel::None) {
+    error() << "Unable to smear particles' momenta - no resolution given!" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  const size_t num = aMom.size();
+  m_batchResolutions.resize(num);
+  m_batchDeviates.resize(num);
+  for (size_t i = 0; i < num; ++i) {
+    m_batchResolutions[i] = aMom[i].mag();
+  }
+  // evaluation in place: each resolution depends only on the momentum at the same position
+  resolutions(m_batchResolutions.data(), m_batchResolutions.data(), num);
+  m_normalDeviates.fill(m_batchDeviates.data(), num);
+  for (size_t i = 0; i < num; ++i) {
+    aMom[i] *= 1 + m_batchResolutions[i] * m_batchDeviates[i];
+  }
   return StatusCode::SUCCESS;
 }
+
+void SimG4ParticleSmearFormula::resolutions(const double* aMomenta, double* aResolutions, size_t aNum) const {
+  switch (m_kernel) {
+  case Kernel::None:
+    std::fill(aResolutions, aResolutions + aNum, 0.);
+    break;
+  case Kernel::Constant:
+    std::fill(aResolutions, aResolutions + aNum, m_coeffA);
+    break;
+  case Kernel::Linear:
+    for (size_t i = 0; i < aNum; ++i) {
+      aResolutions[i] = m_coeffA + m_coeffB * aMomenta[i];
+    }
+    break;
+  case Kernel::Quadrature: {
+    const double a2 = m_coeffA * m_coeffA;
+    const double b2 = m_coeffB * m_coeffB;
+    for (size_t i = 0; i < aNum; ++i) {
+      aResolutions[i] = std::sqrt(a2 + b2 * aMomenta[i] * aMomenta[i]);
+    }
+    break;
+  }
+  case Kernel::Formula:
+    for (size_t i = 0; i < aNum; ++i) {
+      aResolutions[i] = m_resolutionMomentum.EvalPar(aMomenta + i);
+    }
+    break;
+  }
+}
+
+bool SimG4ParticleSmearFormula::recogniseKernel(const std::string& aFormula) {
+  std::string expr;
+  for (char c : aFormula) {
+    if (!std::isspace(static_cast<unsigned char>(c))) {
+      expr += c;
+    }
+  }
+  const std::string num = "([-+]?(?:[0-9]+\\.?[0-9]*|\\.[0-9]+)(?:[eE][-+]?[0-9]+)?)";
+  const std::string var = "(?:x|x\\[0\\])";
+  std::smatch match;
+  if (std::regex_match(expr, match, std::regex(num))) {
+    m_kernel = Kernel::Constant;
+    m_coeffA = std::stod(match[1]);
+    return true;
+  }
+  if (std::regex_match(expr, match, std::regex(num + "\\*" + var))) {
+    m_kernel = Kernel::Linear;
+    m_coeffB = std::stod(match[1]);
+    return true;
+  }
+  if (std::regex_match(expr, match, std::regex(num + "\\+" + num + "\\*" + var))) {
+    m_kernel = Kernel::Linear;
+    m_coeffA = std::stod(match[1]);
+    m_coeffB = std::stod(match[2]);
+    return true;
+  }
+  if (std::regex_match(expr, match, std::regex("sqrt\\(" + num + "\\^2\\+\\(" + num + "\\*" + var + "\\)\\^2\\)")) ||
+      std::regex_match(expr, match,
+                       std::regex("sqrt\\(pow\\(" + num + ",2\\)\\+pow\\(" + num + "\\*" + var + ",2\\)\\)"))) {
+    m_kernel = Kernel::Quadrature;
+    m_coeffA = std::stod(match[1]);
+    m_coeffB = std::stod(match[2]);
+    return true;
+  }
+  return false;
+}
@@ -1,16 +1,20 @@
 #ifndef SIMG4FAST_G4PARTICLESMEARFORMULA_H
 #define SIMG4FAST_G4PARTICLESMEARFORMULA_H
 
+// STL
+#include <cmath>
+#include <vector>
+
 // Gaudi
 #include "GaudiKernel/AlgTool.h"
 #include "GaudiKernel/RndmGenerators.h"
 class IRndmGenSvc;
-class IRndmGen;
 
 // ROOT
 #include "TFormula.h"
 
 // FCCSW
+#include "SimG4Fast/NormalDeviateGenerator.h"
 #include "SimG4Interface/ISimG4ParticleSmearTool.h"
 
 /** @class SimG4ParticleSmearFormula SimG4Fast/src/components/SimG4ParticleSmearFormula.h SimG4ParticleSmearFormula.h
@@ -18,6 +22,8 @@ class IRndmGen;
  *  Formula particle smearing tool.
  *  The resolution dependence can be expressed by an arbitrary formula in the configuration.
  *  Smears momentum of the particle following a Gaussian distribution, using the evaluated formula as the mean.
+ *  The formula is compiled once at initialization. Constant, linear and quadrature-sum forms are recognised and
+ *  evaluated by hand-written kernels, any other expression by the JIT-compiled TFormula.
  *  [For more information please see](@ref md_sim_doc_geant4fastsim).
  *
  *  @author Anna Zaborowska
@@ -44,6 +50,13 @@ public:
    */
   virtual StatusCode smearMomentum(CLHEP::Hep3Vector& aMom, int aPdg = 0) final;
 
+  /**  Smear the momenta of many particles at once, in place
+   *   @param aMom Particle momenta to be smeared.
+   *   @param[in] aPdg Particle PDG codes, either empty or of the same size as aMom.
+   *   @return status code
+   */
+  virtual StatusCode smearMomenta(std::span<CLHEP::Hep3Vector> aMom, std::span<const int> aPdg = {}) final;
+
   /**  Check conditions of the smearing model, especially if the given parametrs do not exceed the parameters of the
    * model.
    *   @param[in] aMinMomentum Minimum momentum.
@@ -53,13 +66,51 @@ public:
    */
   inline virtual StatusCode checkConditions(double, double, double) const final { return StatusCode::SUCCESS; }
 
+  /**  Evaluate the resolution for an array of momenta.
+   *   @param[in] aMomenta Momenta for which the resolution is evaluated.
+   *   @param[out] aResolutions Evaluated resolutions (at least aNum elements).
+   *   @param[in] aNum Number of momenta.
+   */
+  void resolutions(const double* aMomenta, double* aResolutions, size_t aNum) const;
+
 private:
+  /// Evaluation strategies of the resolution formula
+  enum class Kernel { None, Constant, Linear, Quadrature, Formula };
+  /**  Recognise the common forms of the resolution formula (constant, a+b*x, sqrt(a^2+(b*x)^2)).
+   *   The coefficients of the recognised form are stored in m_coeffA and m_coeffB.
+   *   @param[in] aFormula Formula expression.
+   *   @return true if the formula matches one of the hand-written kernels
+   */
+  bool recogniseKernel(const std::string& aFormula);
+  /// Evaluate the resolution for the given momentum
+  inline double resolution(double aMom) const {
+    switch (m_kernel) {
+    case Kernel::Constant:
+      return m_coeffA;
+    case Kernel::Linear:
+      return m_coeffA + m_coeffB * aMom;
+    case Kernel::Quadrature:
+      return std::sqrt(m_coeffA * m_coeffA + m_coeffB * m_coeffB * aMom * aMom);
+    default:
+      return m_resolutionMomentum.EvalPar(&aMom);
+    }
+  }
+  /// Strategy used to evaluate the resolution, chosen at initialization
+  Kernel m_kernel = Kernel::None;
+  /// First coefficient of the recognised formula (constant term)
+  double m_coeffA = 0;
+  /// Second coefficient of the recognised formula (momentum term)
+  double m_coeffB = 0;
+  /// Momenta, and then resolutions, of the particles smeared in a batch, kept to avoid reallocation
+  std::vector<double> m_batchResolutions;
+  /// Random numbers drawn for the batch smearing, kept to avoid reallocation
+  std::vector<double> m_batchDeviates;
   /// TFormula representing resolution momentum-dependent for the smearing
   TFormula m_resolutionMomentum;
   /// Random Number Service
   SmartIF<IRndmGenSvc> m_randSvc;
-  /// Gaussian random number generator used for smearing with a constant resolution (m_sigma)
-  IRndmGen* m_gauss;
+  /// Unit normal random numbers, created once and scaled by the resolution for each particle
+  sim::NormalDeviateGenerator m_normalDeviates;
   /// string defining a TFormula representing resolution momentum-dependent for the smearing (set by job options)
   Gaudi::Property<std::string> m_resolutionMomentumStr{
       this, "resolutionMomentum", "",
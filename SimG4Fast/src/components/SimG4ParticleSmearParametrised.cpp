@@ -0,0 +1,293 @@
+#include "SimG4ParticleSmearParametrised.h"
+
+// Gaudi
+#include "GaudiKernel/IRndmGenSvc.h"
+#include "GaudiKernel/SystemOfUnits.h"
+
+// STL
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+
+// ROOT
+#include "TArray.h"
+#include "TFile.h"
+#include "TTree.h"
+
+// CLHEP
+#include "CLHEP/Units/PhysicalConstants.h"
+#include "CLHEP/Units/SystemOfUnits.h"
+#include "CLHEP/Vector/ThreeVector.h"
+
+DECLARE_COMPONENT(SimG4ParticleSmearParametrised)
+
+namespace {
+/// Names of the branches with the resolutions, indexed by the smeared quantity
+const char* const quantityNames[] = {"momentum", "theta", "phi", "d0", "z0"};
+/// Prefix of the names of the trees with the resolutions of each species
+const std::string tablePrefix = "resolutions_";
+} // namespace
+
+SimG4ParticleSmearParametrised::SimG4ParticleSmearParametrised(const std::string& type, const std::string& name,
+                                                               const IInterface* parent)
+    : AlgTool(type, name, parent) {
+  declareInterface<ISimG4ParticleSmearTool>(this);
+}
+
+SimG4ParticleSmearParametrised::~SimG4ParticleSmearParametrised() {}
+
+StatusCode SimG4ParticleSmearParametrised::initialize() {
+  if (AlgTool::initialize().isFailure()) {
+    return StatusCode::FAILURE;
+  }
+  m_randSvc = service("RndmGenSvc");
+  if (!m_randSvc) {
+    error() << "Couldn't get RndmGenSvc" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  if (m_normalDeviates.initialize(m_randSvc).isFailure()) {
+    error() << "Couldn't initialize the Gaussian random number generator" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  if (readResolutions().isFailure()) {
+    error() << "Couldn't read the input resolution file" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  return StatusCode::SUCCESS;
+}
+
+StatusCode SimG4ParticleSmearParametrised::finalize() { return AlgTool::finalize(); }
+
+StatusCode SimG4ParticleSmearParametrised::smearMomentum(CLHEP::Hep3Vector& aMom, int aPdg) {
+  smear(nullptr, aMom, aPdg);
+  return StatusCode::SUCCESS;
+}
+
+StatusCode SimG4ParticleSmearParametrised::smearMomenta(std::span<CLHEP::Hep3Vector> aMom, std::span<const int> aPdg) {
+  if (!aPdg.empty() && aPdg.size() != aMom.size()) {
+    error() << "Number of PDG codes (" << aPdg.size() << ") differs from the number of momenta (" << aMom.size()
+            << ")" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  for (size_t i = 0; i < aMom.size(); ++i) {
+    smear(nullptr, aMom[i], aPdg.empty() ? 0 : aPdg[i]);
+  }
+  return StatusCode::SUCCESS;
+}
+
+StatusCode SimG4ParticleSmearParametrised::smearTrack(CLHEP::Hep3Vector& aVertex, CLHEP::Hep3Vector& aMom, int aPdg) {
+  smear(&aVertex, aMom, aPdg);
+  return StatusCode::SUCCESS;
+}
+
+void SimG4ParticleSmearParametrised::smear(CLHEP::Hep3Vector* aVertex, CLHEP::Hep3Vector& aMom, int aPdg) {
+  const SpeciesTable* speciesTable = table(aPdg);
+  if (speciesTable == nullptr) {
+    return;
+  }
+  double mom = aMom.mag();
+  std::array<double, kNumQuantities> res;
+  if (mom == 0 || !resolutions(*speciesTable, aMom.pseudoRapidity(), mom / CLHEP::GeV, res)) {
+    return;
+  }
+  double deviates[kNumQuantities];
+  m_normalDeviates.fill(deviates, kNumQuantities);
+
+  // impact parameters: d0 is perpendicular to the transverse momentum, z0 along the beam axis
+  if (aVertex != nullptr) {
+    double pT = aMom.perp();
+    if (pT > 0) {
+      double d0 = res[kD0] * deviates[kD0] * CLHEP::mm;
+      aVertex->setX(aVertex->x() - d0 * aMom.y() / pT);
+      aVertex->setY(aVertex->y() + d0 * aMom.x() / pT);
+    }
+    aVertex->setZ(aVertex->z() + res[kZ0] * deviates[kZ0] * CLHEP::mm);
+  }
+
+  // momentum magnitude and direction, polar angle reflected back into [0, pi]
+  double theta = aMom.theta() + res[kTheta] * deviates[kTheta];
+  double phi = aMom.phi() + res[kPhi] * deviates[kPhi];
+  if (theta < 0) {
+    theta = -theta;
+    phi += CLHEP::pi;
+  } else if (theta > CLHEP::pi) {
+    theta = CLHEP::twopi - theta;
+    phi += CLHEP::pi;
+  }
+  aMom.setRThetaPhi(mom * (1 + res[kMomentum] * deviates[kMomentum]), theta, phi);
+}
+
+const SimG4ParticleSmearParametrised::SpeciesTable* SimG4ParticleSmearParametrised::table(int aPdg) const {
+  auto it = m_tableIndex.find(aPdg);
+  if (it == m_tableIndex.end()) {
+    it = m_tableIndex.find(std::abs(aPdg));
+  }
+  return (it == m_tableIndex.end()) ? m_defaultTable : &m_tables[it->second];
+}
+
+bool SimG4ParticleSmearParametrised::resolutions(const SpeciesTable& aTable, double aEta, double aMom,
+                                                 std::array<double, kNumQuantities>& aRes) const {
+  // smear particles only in the pseudorapidity region where resolutions are defined
+  sim::EtaMomentumGrid::Bin bin;
+  if (!m_grid.find(aEta, aMom, bin))
+    return false;
+  size_t binsEta = m_grid.etaBins();
+  size_t binsP = m_grid.momentumBins();
+  double deltaP = bin.deltaMomentum;
+  size_t offset = bin.eta * binsP + bin.momentum;
+  size_t quantityStride = binsEta * binsP;
+  for (int iQ = 0; iQ < kNumQuantities; ++iQ) {
+    size_t index = iQ * quantityStride + offset;
+    aRes[iQ] = aTable.resolutions[index] + aTable.slopes[index] * deltaP;
+  }
+  return true;
+}
+
+StatusCode SimG4ParticleSmearParametrised::readResolutions() {
+  // check if file exists
+  if (m_resolutionFileName.empty()) {
+    error() << "Name of the resolution file not set" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  std::unique_ptr<TFile> file(TFile::Open(m_resolutionFileName.value().c_str(), "READ"));
+  if (!file || file->IsZombie()) {
+    error() << "Couldn't open the resolution file" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  // retrieve the pseudorapidity and momentum values for which the resolutions are defined
+  TTree* infoTree = dynamic_cast<TTree*>(file->Get("info"));
+  if (infoTree == nullptr || !(infoTree->GetListOfBranches()->Contains("eta") &&
+                               infoTree->GetListOfBranches()->Contains("p"))) {
+    error() << "Resolution file " << m_resolutionFileName << " does not contain tree <<info>>"
+            << " with branches <<eta>> and <<p>>" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  TArrayD* readEta = nullptr;
+  TArrayD* readP = nullptr;
+  infoTree->SetBranchAddress("eta", &readEta);
+  infoTree->SetBranchAddress("p", &readP);
+  infoTree->GetEntry(0);
+  int binsEta = readEta->GetSize();
+  int binsP = readP->GetSize();
+  if (binsEta == 0 || binsP == 0) {
+    error() << "Resolution file " << m_resolutionFileName << " defines no eta bins or momentum values" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  if (!m_grid.set(std::vector<double>(readEta->GetArray(), readEta->GetArray() + binsEta),
+                  std::vector<double>(readP->GetArray(), readP->GetArray() + binsP))) {
+    error() << "Resolution file " << m_resolutionFileName << " defines eta bins or momentum values which are not "
+            << "positive and strictly increasing" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  m_minMomentum = m_grid.minMomentum();
+  m_maxMomentum = m_grid.maxMomentum();
+  m_maxEta = m_grid.maxEta();
+  info() << "Reading the resolutions from file: " << file->GetName() << endmsg;
+  info() << "\tMinimum momentum with resolutions defined: " << m_minMomentum << " GeV" << endmsg;
+  info() << "\tMaximum momentum with resolutions defined: " << m_maxMomentum << " GeV" << endmsg;
+  info() << "\tMaximum pseudorapidity with resolutions defined: " << m_maxEta << endmsg;
+
+  // retrieve the resolutions of each species, flattened into dense (eta, p) grids
+  size_t quantityStride = binsEta * binsP;
+  for (TObject* obj : *file->GetListOfKeys()) {
+    std::string treeName = obj->GetName();
+    if (treeName.rfind(tablePrefix, 0) != 0) {
+      continue;
+    }
+    int pdg = 0;
+    const char* pdgBegin = treeName.data() + tablePrefix.size();
+    const char* pdgEnd = treeName.data() + treeName.size();
+    auto [pdgParsed, pdgError] = std::from_chars(pdgBegin, pdgEnd, pdg);
+    if (pdgBegin == pdgEnd || pdgError != std::errc() || pdgParsed != pdgEnd) {
+      error() << "Resolution file " << m_resolutionFileName << " contains tree <<" << treeName << ">> whose name "
+              << "does not end with a PDG code" << endmsg;
+      return StatusCode::FAILURE;
+    }
+    // several cycles of the same tree may be listed, the first one is the latest
+    if (m_tableIndex.count(pdg)) {
+      continue;
+    }
+    TTree* resolutionTree = dynamic_cast<TTree*>(file->Get(treeName.c_str()));
+    if (resolutionTree == nullptr || resolutionTree->GetEntries() < binsEta) {
+      error() << "Resolution file " << m_resolutionFileName << " does not contain tree <<" << treeName << ">> with "
+              << binsEta << " entries" << endmsg;
+      return StatusCode::FAILURE;
+    }
+    SpeciesTable speciesTable;
+    speciesTable.resolutions.assign(kNumQuantities * quantityStride, 0);
+    speciesTable.slopes.assign(kNumQuantities * quantityStride, 0);
+    std::array<TArrayD*, kNumQuantities> readRes{};
+    for (int iQ = 0; iQ < kNumQuantities; ++iQ) {
+      if (resolutionTree->GetListOfBranches()->Contains(quantityNames[iQ])) {
+        resolutionTree->SetBranchAddress(quantityNames[iQ], &readRes[iQ]);
+      }
+    }
+    for (int itEta = 0; itEta < binsEta; itEta++) {
+      resolutionTree->GetEntry(itEta);
+      for (int iQ = 0; iQ < kNumQuantities; ++iQ) {
+        if (readRes[iQ] == nullptr) {
+          continue;
+        }
+        if (readRes[iQ]->GetSize() < binsP) {
+          error() << "Resolution file " << m_resolutionFileName << " defines " << readRes[iQ]->GetSize() << " "
+                  << quantityNames[iQ] << " resolutions of " << treeName << " for eta bin " << itEta << ", expected "
+                  << binsP << endmsg;
+          return StatusCode::FAILURE;
+        }
+        double* row = &speciesTable.resolutions[iQ * quantityStride + itEta * binsP];
+        double* slopes = &speciesTable.slopes[iQ * quantityStride + itEta * binsP];
+        for (int iP = 0; iP < binsP; ++iP) {
+          row[iP] = readRes[iQ]->At(iP);
+        }
+        for (int iP = 0; iP + 1 < binsP; ++iP) {
+          slopes[iP] = (row[iP + 1] - row[iP]) / (m_grid.momentumValues()[iP + 1] - m_grid.momentumValues()[iP]);
+        }
+      }
+    }
+    resolutionTree->ResetBranchAddresses();
+    for (auto res : readRes) {
+      delete res;
+    }
+    m_tableIndex[pdg] = m_tables.size();
+    m_tables.push_back(std::move(speciesTable));
+    info() << "\tResolutions defined for PDG code " << pdg << (pdg == 0 ? " (default)" : "") << endmsg;
+  }
+  if (m_tables.empty()) {
+    error() << "Resolution file " << m_resolutionFileName << " does not contain any tree <<" << tablePrefix
+            << "PDG>>" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  // the default table is only used through m_defaultTable, the tables are not modified anymore
+  auto defaultIt = m_tableIndex.find(0);
+  if (defaultIt != m_tableIndex.end()) {
+    m_defaultTable = &m_tables[defaultIt->second];
+    m_tableIndex.erase(defaultIt);
+  }
+  file->Close();
+  return StatusCode::SUCCESS;
+}
+
+StatusCode SimG4ParticleSmearParametrised::checkConditions(double aMinMomentum, double aMaxMomentum,
+                                                           double aMaxEta) const {
+  // check if thresholds for fast sim are not broader than values for which resolutions are defined
+  if (aMinMomentum / Gaudi::Units::GeV < m_minMomentum) {
+    error() << "Minimum trigger momentum defined in region tool properties (" << aMinMomentum / Gaudi::Units::GeV
+            << " GeV) is smaller then the minimal momentum from ROOT file (" << m_minMomentum << " GeV)" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  if (aMaxMomentum == 0) {
+    error() << "Maximum trigger momentum is not defined in tool properties." << endmsg;
+    return StatusCode::FAILURE;
+  } else if (aMaxMomentum / Gaudi::Units::GeV > m_maxMomentum) {
+    error() << "Maximum trigger momentum defined in region tool properties (" << aMaxMomentum / Gaudi::Units::GeV
+            << " GeV) is larger then the maximal momentum from ROOT file (" << m_maxMomentum << " GeV)" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  if (aMaxEta > 0 && aMaxEta > m_maxEta) {
+    error() << "Maximum trigger pseudorapidity defined in tool properties (" << aMaxEta << ")"
+            << " is larger then the maximal eta from ROOT file (" << m_maxEta << ")" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  return StatusCode::SUCCESS;
+}
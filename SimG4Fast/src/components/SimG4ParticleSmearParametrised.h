@@ -0,0 +1,142 @@
+#ifndef SIMG4FAST_G4PARTICLESMEARPARAMETRISED_H
+#define SIMG4FAST_G4PARTICLESMEARPARAMETRISED_H
+
+// Gaudi
+#include "GaudiKernel/AlgTool.h"
+class IRndmGenSvc;
+
+// STL
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+// FCCSW
+#include "SimG4Fast/EtaMomentumGrid.h"
+#include "SimG4Fast/NormalDeviateGenerator.h"
+#include "SimG4Interface/ISimG4ParticleSmearTool.h"
+
+/** @class SimG4ParticleSmearParametrised SimG4Fast/src/components/SimG4ParticleSmearParametrised.h
+ * SimG4ParticleSmearParametrised.h
+ *
+ *  Parametrised tracker response, depending on the particle species.
+ *  The resolutions are read from the ROOT file, which path is given in configuration.
+ *  Root file contains tree 'info' and one tree 'resolutions_<PDG>' for each particle species.
+ *  'info' has two arrays of type TArrayD containing edges of eta bins ('eta') and momentum values ('p'),
+ *  shared by all the species.
+ *  'resolutions_<PDG>' trees have one entry per eta bin, with TArrayD branches of resolutions computed for the momentum
+ *  values: 'momentum' (relative), 'theta' and 'phi' (rad), 'd0' and 'z0' (mm). Missing branches are not smeared.
+ *  The table of a particle is chosen by its PDG code, then by its absolute value (charge-symmetric table),
+ *  and finally 'resolutions_0' is used as the default table, if defined. Other particles are not smeared.
+ *  A tree 'resolutions_<x>' whose suffix is not an integer PDG code makes the initialisation fail.
+ *  Momentum magnitude, polar and azimuthal angles, and the transverse and longitudinal impact parameters
+ *  (production vertex) are smeared following Gaussian distributions of the interpolated resolutions.
+ *  At initialization the tables are flattened into dense (eta, p) grids, all quantities are evaluated with one lookup.
+ *  [For more information please see](@ref md_sim_doc_geant4fastsim).
+ */
+
+class SimG4ParticleSmearParametrised : public AlgTool, virtual public ISimG4ParticleSmearTool {
+public:
+  explicit SimG4ParticleSmearParametrised(const std::string& type, const std::string& name, const IInterface* parent);
+  virtual ~SimG4ParticleSmearParametrised();
+
+  /**  Initialize the tool, a random number generator and read the resolution tables.
+   *   @return status code
+   */
+  virtual StatusCode initialize() final;
+  /**  Finalize.
+   *   @return status code
+   */
+  virtual StatusCode finalize() final;
+
+  /**  Smear the momentum (magnitude and direction) of the particle
+   *   @param aMom Particle momentum to be smeared.
+   *   @param[in] aPdg Particle PDG code.
+   *   @return status code
+   */
+  virtual StatusCode smearMomentum(CLHEP::Hep3Vector& aMom, int aPdg = 0) final;
+
+  /**  Smear the momenta of many particles at once, in place
+   *   @param aMom Particle momenta to be smeared.
+   *   @param[in] aPdg Particle PDG codes, either empty or of the same size as aMom.
+   *   @return status code
+   */
+  virtual StatusCode smearMomenta(std::span<CLHEP::Hep3Vector> aMom, std::span<const int> aPdg = {}) final;
+
+  /**  Smear the momentum and the impact parameters of the particle
+   *   @param aVertex Particle production vertex to be smeared.
+   *   @param aMom Particle momentum to be smeared.
+   *   @param[in] aPdg Particle PDG code.
+   *   @return status code
+   */
+  virtual StatusCode smearTrack(CLHEP::Hep3Vector& aVertex, CLHEP::Hep3Vector& aMom, int aPdg = 0) final;
+
+  /**  Check conditions of the smearing model, especially if the given parametrs do not exceed the parameters of the
+   * model.
+   *   @param[in] aMinMomentum Minimum momentum.
+   *   @param[in] aMaxMomentum Maximum momentum.
+   *   @param[in] aMaxEta Maximum pseudorapidity.
+   *   @return status code
+   */
+  virtual StatusCode checkConditions(double aMinMomentum, double aMaxMomentum, double aMaxEta) const final;
+
+private:
+  /// Smeared quantities
+  enum Quantity { kMomentum = 0, kTheta, kPhi, kD0, kZ0, kNumQuantities };
+  /// Resolutions of one particle species
+  struct SpeciesTable {
+    /// Resolutions in the (eta, p) grid, stored as [quantity][eta bin][momentum value]
+    std::vector<double> resolutions;
+    /// Slopes of the resolutions between consecutive momentum values, stored as resolutions
+    std::vector<double> slopes;
+  };
+  /**  Read the file with the resolutions. File name is set by job options.
+   *   @return status code
+   */
+  StatusCode readResolutions();
+  /**  Find the resolution table of the particle species.
+   *   @param[in] aPdg Particle PDG code.
+   *   @return Resolution table (nullptr if the species is not parametrised)
+   */
+  const SpeciesTable* table(int aPdg) const;
+  /**  Get the resolutions of all the quantities for the given pseudorapidity and momentum.
+   *   The resolutions are linearly interpolated in momentum within the eta bin (extrapolated outside the momentum
+   *   range).
+   *   @param[in] aTable Resolution table of the particle species.
+   *   @param[in] aEta Particle's pseudorapidity
+   *   @param[in] aMom Particle's momentum (GeV)
+   *   @param[out] aRes Resolutions, indexed by Quantity
+   *   @return false outside the pseudorapidity range of the resolution file
+   */
+  bool resolutions(const SpeciesTable& aTable, double aEta, double aMom,
+                   std::array<double, kNumQuantities>& aRes) const;
+  /**  Smear the momentum and optionally the vertex.
+   *   @param aVertex Particle production vertex to be smeared (not smeared if nullptr).
+   *   @param aMom Particle momentum to be smeared.
+   *   @param[in] aPdg Particle PDG code.
+   */
+  void smear(CLHEP::Hep3Vector* aVertex, CLHEP::Hep3Vector& aMom, int aPdg);
+
+  /// Random Number Service
+  SmartIF<IRndmGenSvc> m_randSvc;
+  /// Unit normal random numbers, created once and scaled by the resolutions for each particle
+  sim::NormalDeviateGenerator m_normalDeviates;
+  /// Bins in eta and momentum values (GeV) for which the resolutions are defined
+  sim::EtaMomentumGrid m_grid;
+  /// Resolution tables of all the species
+  std::vector<SpeciesTable> m_tables;
+  /// Index of the resolution table for the PDG codes with a dedicated table
+  std::unordered_map<int, size_t> m_tableIndex;
+  /// Resolution table used for the species without a dedicated table (nullptr if not defined)
+  const SpeciesTable* m_defaultTable = nullptr;
+  /// File name with the resolutions (set by job options)
+  Gaudi::Property<std::string> m_resolutionFileName{this, "filename", "",
+                                                    "File name with the resolutions of the particle species"};
+  /// minimum momentum defined in the resolution file
+  double m_minMomentum = 0;
+  /// maximum momentum defined in the resolution file
+  double m_maxMomentum = 0;
+  /// maximum pseudorapidity defined in the resolution file
+  double m_maxEta = 0;
+};
+
+#endif /* SIMG4FAST_G4PARTICLESMEARPARAMETRISED_H */
@@ -1,11 +1,12 @@
 #include "SimG4ParticleSmearRootFile.h"
 
 // Gaudi
-
-#include "GaudiKernel/IRndmGen.h"
 #include "GaudiKernel/IRndmGenSvc.h"
 #include "GaudiKernel/SystemOfUnits.h"
 
+// STL
+#include <algorithm>
+
 // ROOT
 #include "TArray.h"
 #include "TFile.h"
@@ -34,6 +35,10 @@ StatusCode SimG4ParticleSmearRootFile::initialize() {
     error() << "Couldn't get RndmGenSvc" << endmsg;
     return StatusCode::FAILURE;
   }
+  if (m_normalDeviates.initialize(m_randSvc).isFailure()) {
+    error() << "Couldn't initialize the Gaussian random number generator" << endmsg;
+    return StatusCode::FAILURE;
+  }
   if (readResolutions().isFailure()) {
     error() << "Couldn't read the input resolution file from tkLayout" << endmsg;
     return StatusCode::FAILURE;
@@ -46,9 +51,24 @@ StatusCode SimG4ParticleSmearRootFile::finalize() { return AlgTool::finalize();
 StatusCode SimG4ParticleSmearRootFile::smearMomentum(CLHEP::Hep3Vector& aMom, int /*aPdg*/) {
   double res = resolution(aMom.pseudoRapidity(), aMom.mag() / CLHEP::GeV);
   if (res > 0) {
-    m_randSvc->generator(Rndm::Gauss(1, res), m_gauss).ignore();
-    double tmp = m_gauss->shoot();
-    aMom *= tmp;
+    aMom *= 1 + res * m_normalDeviates.next();
+  }
+  return StatusCode::SUCCESS;
+}
+
+StatusCode SimG4ParticleSmearRootFile::smearMomenta(std::span<CLHEP::Hep3Vector> aMom, std::span<const int> aPdg) {
+  if (!aPdg.empty() && aPdg.size() != aMom.size()) {
+    error() << "Number of PDG codes (" << aPdg.size() << ") differs from the number of momenta (" << aMom.size()
+            << ")" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  m_batchDeviates.resize(aMom.size());
+  m_normalDeviates.fill(m_batchDeviates.data(), aMom.size());
+  for (size_t i = 0; i < aMom.size(); ++i) {
+    double res = resolution(aMom[i].pseudoRapidity(), aMom[i].mag() / CLHEP::GeV);
+    if (res > 0) {
+      aMom[i] *= 1 + res * m_batchDeviates[i];
+    }
   }
   return StatusCode::SUCCESS;
 }
@@ -85,9 +105,15 @@ StatusCode SimG4ParticleSmearRootFile::readResolutions() {
   infoTree->GetEntry(0);
   int binsEta = readEta->GetSize();
   int binsP = readP->GetSize();
-  m_minMomentum = readP->At(0);
-  m_maxMomentum = readP->At(binsP - 1);
-  m_maxEta = readEta->At(binsEta - 1);
+  if (!m_grid.set(std::vector<double>(readEta->GetArray(), readEta->GetArray() + binsEta),
+                  std::vector<double>(readP->GetArray(), readP->GetArray() + binsP))) {
+    error() << "Resolution file " << m_resolutionFileName << " defines eta bins or momentum values which are not "
+            << "positive and strictly increasing" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  m_minMomentum = m_grid.minMomentum();
+  m_maxMomentum = m_grid.maxMomentum();
+  m_maxEta = m_grid.maxEta();
   info() << "Reading the resolutions from file: " << file->GetName() << endmsg;
   info() << "\tMinimum momentum with resolutions defined: " << m_minMomentum << " GeV" << endmsg;
   info() << "\tMaximum momentum with resolutions defined: " << m_maxMomentum << " GeV" << endmsg;
@@ -103,9 +129,24 @@ StatusCode SimG4ParticleSmearRootFile::readResolutions() {
   }
   TArrayD* readRes = nullptr;
   resolutionTree->SetBranchAddress("resolution", &readRes);
+  // flatten the resolutions into a dense (eta, p) grid
+  m_resolutions.assign(binsEta * binsP, 0);
+  m_resolutionSlopes.assign(binsEta * binsP, 0);
   for (int itEta = 0; itEta < binsEta; itEta++) {
     resolutionTree->GetEntry(itEta);
-    m_momentumResolutions[readEta->At(itEta)] = TGraph(binsP, readP->GetArray(), readRes->GetArray());
+    if (readRes->GetSize() < binsP) {
+      error() << "Resolution file " << m_resolutionFileName << " defines " << readRes->GetSize()
+              << " resolutions for eta bin " << itEta << ", expected " << binsP << endmsg;
+      return StatusCode::FAILURE;
+    }
+    double* row = &m_resolutions[itEta * binsP];
+    double* slopes = &m_resolutionSlopes[itEta * binsP];
+    for (int iP = 0; iP < binsP; ++iP) {
+      row[iP] = readRes->At(iP);
+    }
+    for (int iP = 0; iP + 1 < binsP; ++iP) {
+      slopes[iP] = (row[iP + 1] - row[iP]) / (m_grid.momentumValues()[iP + 1] - m_grid.momentumValues()[iP]);
+    }
     if (msgLevel(MSG::DEBUG)) {
       debug() << "resolutions for eta (" << (itEta == 0 ? 0 : readEta->At(itEta - 1)) << ", " << readEta->At(itEta)
               << "): \n";
@@ -119,16 +160,13 @@ StatusCode SimG4ParticleSmearRootFile::readResolutions() {
   return StatusCode::SUCCESS;
 }
 
-double SimG4ParticleSmearRootFile::resolution(double aEta, double aMom) {
+double SimG4ParticleSmearRootFile::resolution(double aEta, double aMom) const {
   // smear particles only in the pseudorapidity region where resolutions are defined
-  if (fabs(aEta) > m_maxEta)
+  sim::EtaMomentumGrid::Bin bin;
+  if (!m_grid.find(aEta, aMom, bin))
     return 0;
-  for (auto& m : m_momentumResolutions) {
-    if (fabs(aEta) < m.first) {
-      return m.second.Eval(aMom);
-    }
-  }
-  return 0;
+  size_t index = bin.eta * m_grid.momentumBins() + bin.momentum;
+  return m_resolutions[index] + m_resolutionSlopes[index] * bin.deltaMomentum;
 }
 
 StatusCode SimG4ParticleSmearRootFile::checkConditions(double aMinMomentum, double aMaxMomentum, double aMaxEta) const {
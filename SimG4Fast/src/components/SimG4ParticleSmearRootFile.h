@@ -5,12 +5,13 @@
 #include "GaudiKernel/AlgTool.h"
 #include "GaudiKernel/RndmGenerators.h"
 class IRndmGenSvc;
-class IRndmGen;
 
-// ROOT
-#include "TGraph.h"
+// STL
+#include <vector>
 
 // FCCSW
+#include "SimG4Fast/EtaMomentumGrid.h"
+#include "SimG4Fast/NormalDeviateGenerator.h"
 #include "SimG4Interface/ISimG4ParticleSmearTool.h"
 
 /** @class SimG4ParticleSmearRootFile SimG4Fast/src/components/SimG4ParticleSmearRootFile.h SimG4ParticleSmearRootFile.h
@@ -24,6 +25,8 @@ class IRndmGen;
  *  using the evaluated resolution as the mean.
  *  User needs to specify the min/max momentum nad max eta for fast sim in the `SimG4FastSimTrackerRegion` tool.
  *  The defined values cannot be broader than eta and p values for which the resolutions were computed.
+ *  At initialization the resolutions are flattened into a dense (eta, p) grid, so the lookup for each particle
+ *  is an index computation followed by a linear interpolation in momentum.
  *
  *  @author Anna Zaborowska
  */
@@ -47,16 +50,23 @@ public:
    *   @return status code
    */
   virtual StatusCode smearMomentum(CLHEP::Hep3Vector& aMom, int aPdg = 0) final;
+  /**  Smear the momenta of many particles at once, in place
+   *   @param aMom Particle momenta to be smeared.
+   *   @param[in] aPdg Particle PDG codes, either empty or of the same size as aMom.
+   *   @return status code
+   */
+  virtual StatusCode smearMomenta(std::span<CLHEP::Hep3Vector> aMom, std::span<const int> aPdg = {}) final;
   /**  Read the file with the resolutions. File name is set by job options.
    *   @return status code
    */
   StatusCode readResolutions();
-  /**  Read the file with the resolutions. File name is set by job options.
+  /**  Get the resolution for the given pseudorapidity and momentum.
+   *   The resolution is linearly interpolated in momentum within the eta bin (extrapolated outside the momentum range).
    *   @param[in] aEta Particle's pseudorapidity
    *   @param[in] aMom Particle's momentum
-   *   @return Resolution
+   *   @return Resolution (0 outside the pseudorapidity range of the resolution file)
    */
-  double resolution(double aEta, double aMom);
+  double resolution(double aEta, double aMom) const;
 
   /**  Check conditions of the smearing model, especially if the given parametrs do not exceed the parameters of the
    * model.
@@ -70,11 +80,16 @@ public:
 private:
   /// Random Number Service
   SmartIF<IRndmGenSvc> m_randSvc;
-  /// Gaussian random number generator used for smearing with a constant resolution (m_sigma)
-  IRndmGen* m_gauss;
-  /// Map of p-dependent resolutions and the end of eta bin that it refers to
-  /// (lower end is defined by previous entry, and eta=0 for the first one)
-  std::map<double, TGraph> m_momentumResolutions;
+  /// Unit normal random numbers, created once and scaled by the resolution for each particle
+  sim::NormalDeviateGenerator m_normalDeviates;
+  /// Bins in eta and momentum values (GeV) for which the resolutions are defined
+  sim::EtaMomentumGrid m_grid;
+  /// Resolutions in the (eta, p) grid, stored row by row (one row of momentum values per eta bin)
+  std::vector<double> m_resolutions;
+  /// Slopes of the resolutions between consecutive momentum values, stored as m_resolutions
+  std::vector<double> m_resolutionSlopes;
+  /// Random numbers drawn for the batch smearing, kept to avoid reallocation
+  std::vector<double> m_batchDeviates;
   /// File name with the resolutions obtained from root file (set by job options)
   Gaudi::Property<std::string> m_resolutionFileName{this, "filename", "",
                                                     "File name with the resolutions obtained from root file"};
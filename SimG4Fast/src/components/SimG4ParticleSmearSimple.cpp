@@ -36,3 +36,22 @@ StatusCode SimG4ParticleSmearSimple::smearMomentum(CLHEP::Hep3Vector& aMom, int
   aMom *= tmp;
   return StatusCode::SUCCESS;
 }
+
+StatusCode SimG4ParticleSmearSimple::smearMomenta(std::span<CLHEP::Hep3Vector> aMom, std::span<const int> aPdg) {
+  if (!aPdg.empty() && aPdg.size() != aMom.size()) {
+    error() << "Number of PDG codes (" << aPdg.size() << ") differs from the number of momenta (" << aMom.size()
+            << ")" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  if (aMom.empty()) {
+    return StatusCode::SUCCESS;
+  }
+  if (m_gauss.shootArray(m_factors, aMom.size()).isFailure()) {
+    error() << "Couldn't generate random numbers for the smearing" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  for (size_t i = 0; i < aMom.size(); ++i) {
+    aMom[i] *= m_factors[i];
+  }
+  return StatusCode::SUCCESS;
+}
@@ -1,6 +1,9 @@
 #ifndef SIMG4FAST_G4PARTICLESMEARSIMPLE_H
 #define SIMG4FAST_G4PARTICLESMEARSIMPLE_H
 
+// STL
+#include <vector>
+
 // Gaudi
 #include "GaudiKernel/AlgTool.h"
 #include "GaudiKernel/IRndmGenSvc.h"
@@ -40,6 +43,13 @@ public:
    */
   virtual StatusCode smearMomentum(CLHEP::Hep3Vector& aMom, int aPdg = 0) final;
 
+  /**  Smear the momenta of many particles at once, in place
+   *   @param aMom Particle momenta to be smeared.
+   *   @param[in] aPdg Particle PDG codes, either empty or of the same size as aMom.
+   *   @return status code
+   */
+  virtual StatusCode smearMomenta(std::span<CLHEP::Hep3Vector> aMom, std::span<const int> aPdg = {}) final;
+
   /**  Check conditions of the smearing model, especially if the given parametrs do not exceed the parameters of the
    * model.
    *   @param[in] aMinMomentum Minimum momentum.
@@ -54,6 +64,8 @@ private:
   SmartIF<IRndmGenSvc> m_randSvc;
   /// Gaussian random number generator used for smearing with a constant resolution (m_sigma)
   Rndm::Numbers m_gauss;
+  /// Random numbers drawn for the batch smearing, kept to avoid reallocation
+  std::vector<double> m_factors;
   /// Constant resolution for the smearing (set by job options)
   Gaudi::Property<double> m_sigma{this, "sigma", 0.01, "Constant resolution for the smearing"};
 };
@@ -0,0 +1,115 @@
+#include "SimG4Fast/CalorimeterHitDepositor.h"
+
+// FCCSW
+#include "SimG4Common/Geant4CaloHit.h"
+
+// Geant4
+#include "G4Event.hh"
+#include "G4EventManager.hh"
+#include "G4HCofThisEvent.hh"
+#include "G4Navigator.hh"
+#include "G4SDManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4TouchableHistory.hh"
+#include "G4TransportationManager.hh"
+#include "G4VSensitiveDetector.hh"
+
+// DD4hep
+#include "DD4hep/DD4hepUnits.h"
+#include "DDG4/Geant4Mapping.h"
+#include "DDG4/Geant4VolumeManager.h"
+
+namespace sim {
+
+CalorimeterHitDepositor::CalorimeterHitDepositor(const std::string& aReadoutName, dd4hep::Segmentation aSegmentation)
+    : m_readoutName(aReadoutName), m_segmentation(aSegmentation) {}
+
+CalorimeterHitDepositor::~CalorimeterHitDepositor() {}
+
+double CalorimeterHitDepositor::deposit(std::span<const G4ThreeVector> aPositions, std::span<const double> aEnergies,
+                                        int aTrackId, int aPdg, double aTime) {
+  if (aPositions.empty()) {
+    return 0;
+  }
+  // hits collection created for this event by the sensitive detector of the readout
+  if (m_collectionId < 0) {
+    m_collectionId = G4SDManager::GetSDMpointer()->GetCollectionID(m_readoutName);
+  }
+  const G4Event* event = G4EventManager::GetEventManager()->GetConstCurrentEvent();
+  if (m_collectionId < 0 || event == nullptr || event->GetHCofThisEvent() == nullptr) {
+    return 0;
+  }
+  auto collection =
+      dynamic_cast<G4THitsCollection<k4::Geant4CaloHit>*>(event->GetHCofThisEvent()->GetHC(m_collectionId));
+  if (collection == nullptr) {
+    return 0;
+  }
+  if (event->GetEventID() != m_eventId || collection != m_collection) {
+    m_cellHits.clear();
+    m_indexedHits = 0;
+    m_eventId = event->GetEventID();
+    m_collection = collection;
+  }
+  // index the hits added since the last deposit, by the sensitive detector (full simulation) or by this depositor,
+  // so that the energy of a cell already hit is added to its first hit
+  for (size_t numHits = collection->entries(); m_indexedHits < numHits; ++m_indexedHits) {
+    const auto hit = (*collection)[m_indexedHits];
+    m_cellHits.emplace(hit->cellID, hit);
+  }
+  if (!m_navigator) {
+    m_navigator = std::make_unique<G4Navigator>();
+    m_navigator->SetWorldVolume(
+        G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume());
+  }
+  const auto& volumeManager = dd4hep::sim::Geant4Mapping::instance().volumeManager();
+
+  // the volume ID is only recomputed when the deposit falls into a different placement than the previous one
+  double deposited = 0;
+  const G4VPhysicalVolume* lastVolume = nullptr;
+  G4ThreeVector lastTranslation;
+  bool sensitive = false;
+  dd4hep::VolumeID volumeId = 0;
+  for (size_t iDeposit = 0; iDeposit < aPositions.size(); ++iDeposit) {
+    const G4ThreeVector& position = aPositions[iDeposit];
+    if (aEnergies[iDeposit] <= 0) {
+      continue;
+    }
+    G4VPhysicalVolume* volume = m_navigator->LocateGlobalPointAndSetup(position, nullptr, lastVolume != nullptr, true);
+    if (volume == nullptr) {
+      continue;
+    }
+    const G4AffineTransform& toLocal = m_navigator->GetGlobalToLocalTransform();
+    if (volume != lastVolume || toLocal.NetTranslation() != lastTranslation) {
+      lastVolume = volume;
+      lastTranslation = toLocal.NetTranslation();
+      const G4VSensitiveDetector* sd = volume->GetLogicalVolume()->GetSensitiveDetector();
+      sensitive = sd != nullptr && sd->GetNumberOfCollections() > 0 && sd->GetCollectionName(0) == m_readoutName;
+      if (sensitive) {
+        std::unique_ptr<G4TouchableHistory> touchable(m_navigator->CreateTouchableHistory());
+        volumeId = volumeManager.volumeID(touchable.get());
+      }
+    }
+    if (!sensitive) {
+      continue;
+    }
+    G4ThreeVector local = toLocal.TransformPoint(position);
+    dd4hep::Position localPos(local.x() / mm * dd4hep::mm, local.y() / mm * dd4hep::mm, local.z() / mm * dd4hep::mm);
+    dd4hep::Position globalPos(position.x() / mm * dd4hep::mm, position.y() / mm * dd4hep::mm,
+                               position.z() / mm * dd4hep::mm);
+    uint64_t cellId = m_segmentation.cellID(localPos, globalPos, volumeId);
+    deposited += aEnergies[iDeposit];
+    auto cellHit = m_cellHits.find(cellId);
+    if (cellHit != m_cellHits.end()) {
+      cellHit->second->energyDeposit += aEnergies[iDeposit];
+      continue;
+    }
+    auto hit = new k4::Geant4CaloHit(aTrackId, aPdg, aEnergies[iDeposit], aTime);
+    hit->cellID = cellId;
+    hit->position = position;
+    collection->insert(hit);
+    m_cellHits.emplace(cellId, hit);
+    ++m_indexedHits;
+  }
+  return deposited;
+}
+} // namespace sim
@@ -0,0 +1,163 @@
+#include "SimG4Fast/DenseNetwork.h"
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+namespace {
+/// Stream of the values of the network file, skipping the comment lines
+class NetworkFileReader {
+public:
+  explicit NetworkFileReader(const std::string& aFileName) : m_file(aFileName) {}
+  bool isOpen() const { return m_file.is_open(); }
+  template <typename T>
+  bool read(T& aValue) {
+    while (!(m_line >> aValue)) {
+      std::string line;
+      if (!std::getline(m_file, line)) {
+        return false;
+      }
+      if (line.find('#') != std::string::npos) {
+        line.erase(line.find('#'));
+      }
+      m_line.clear();
+      m_line.str(line);
+    }
+    return true;
+  }
+
+private:
+  std::ifstream m_file;
+  std::istringstream m_line;
+};
+} // namespace
+
+namespace sim {
+bool DenseNetwork::load(const std::string& aFileName, std::string& aError) {
+  m_layers.clear();
+  NetworkFileReader reader(aFileName);
+  if (!reader.isOpen()) {
+    aError = "cannot open file " + aFileName;
+    return false;
+  }
+  size_t numLayers = 0;
+  if (!reader.read(numLayers) || numLayers == 0) {
+    aError = "missing number of layers";
+    return false;
+  }
+  for (size_t iLayer = 0; iLayer < numLayers; ++iLayer) {
+    Layer layer;
+    std::string activation;
+    if (!reader.read(layer.numInputs) || !reader.read(layer.numOutputs) || !reader.read(activation)) {
+      aError = "missing definition of layer " + std::to_string(iLayer);
+      return false;
+    }
+    if (layer.numInputs == 0 || layer.numOutputs == 0) {
+      aError = "empty layer " + std::to_string(iLayer);
+      return false;
+    }
+    if (!m_layers.empty() && m_layers.back().numOutputs != layer.numInputs) {
+      aError = "inputs of layer " + std::to_string(iLayer) + " do not match the outputs of the previous layer";
+      return false;
+    }
+    if (activation == "linear") {
+      layer.activation = Activation::Linear;
+    } else if (activation == "relu") {
+      layer.activation = Activation::ReLU;
+    } else if (activation == "sigmoid") {
+      layer.activation = Activation::Sigmoid;
+    } else if (activation == "softplus") {
+      layer.activation = Activation::Softplus;
+    } else if (activation == "softmax") {
+      layer.activation = Activation::Softmax;
+    } else {
+      aError = "unknown activation " + activation + " of layer " + std::to_string(iLayer);
+      return false;
+    }
+    layer.weights.resize(layer.numInputs * layer.numOutputs);
+    layer.biases.resize(layer.numOutputs);
+    for (auto& weight : layer.weights) {
+      if (!reader.read(weight)) {
+        aError = "missing weights of layer " + std::to_string(iLayer);
+        return false;
+      }
+    }
+    for (auto& bias : layer.biases) {
+      if (!reader.read(bias)) {
+        aError = "missing biases of layer " + std::to_string(iLayer);
+        return false;
+      }
+    }
+    m_layers.push_back(std::move(layer));
+  }
+  return true;
+}
+
+size_t DenseNetwork::inputSize() const { return m_layers.empty() ? 0 : m_layers.front().numInputs; }
+
+size_t DenseNetwork::outputSize() const { return m_layers.empty() ? 0 : m_layers.back().numOutputs; }
+
+void DenseNetwork::evaluate(const float* aInputs, size_t aBatchSize, std::vector<float>& aOutputs,
+                            std::vector<float>& aBuffer) const {
+  aOutputs.resize(aBatchSize * outputSize());
+  if (m_layers.empty() || aBatchSize == 0) {
+    return;
+  }
+  // intermediate layers alternate between the two halves of the buffer
+  size_t maxSize = 0;
+  for (const auto& layer : m_layers) {
+    maxSize = std::max(maxSize, layer.numOutputs);
+  }
+  aBuffer.resize(2 * maxSize * aBatchSize);
+  const float* inputs = aInputs;
+  for (size_t iLayer = 0; iLayer < m_layers.size(); ++iLayer) {
+    float* outputs = (iLayer + 1 == m_layers.size()) ? aOutputs.data()
+                                                     : aBuffer.data() + (iLayer % 2) * maxSize * aBatchSize;
+    evaluateLayer(m_layers[iLayer], inputs, aBatchSize, outputs);
+    inputs = outputs;
+  }
+}
+
+void DenseNetwork::evaluateLayer(const Layer& aLayer, const float* aInputs, size_t aBatchSize, float* aOutputs) {
+  const size_t numInputs = aLayer.numInputs;
+  const size_t numOutputs = aLayer.numOutputs;
+  for (size_t iOut = 0; iOut < numOutputs; ++iOut) {
+    const float* weights = aLayer.weights.data() + iOut * numInputs;
+    for (size_t iEntry = 0; iEntry < aBatchSize; ++iEntry) {
+      const float* inputs = aInputs + iEntry * numInputs;
+      float sum = aLayer.biases[iOut];
+      for (size_t iIn = 0; iIn < numInputs; ++iIn) {
+        sum += weights[iIn] * inputs[iIn];
+      }
+      aOutputs[iEntry * numOutputs + iOut] = sum;
+    }
+  }
+  float* end = aOutputs + aBatchSize * numOutputs;
+  switch (aLayer.activation) {
+  case Activation::Linear:
+    break;
+  case Activation::ReLU:
+    std::for_each(aOutputs, end, [](float& x) { x = std::max(x, 0.f); });
+    break;
+  case Activation::Sigmoid:
+    std::for_each(aOutputs, end, [](float& x) { x = 1.f / (1.f + std::exp(-x)); });
+    break;
+  case Activation::Softplus:
+    std::for_each(aOutputs, end, [](float& x) { x = (x > 20.f) ? x : std::log1p(std::exp(x)); });
+    break;
+  case Activation::Softmax:
+    for (float* entry = aOutputs; entry != end; entry += numOutputs) {
+      float max = *std::max_element(entry, entry + numOutputs);
+      float sum = 0;
+      std::for_each(entry, entry + numOutputs, [max, &sum](float& x) {
+        x = std::exp(x - max);
+        sum += x;
+      });
+      std::for_each(entry, entry + numOutputs, [sum](float& x) { x /= sum; });
+    }
+    break;
+  }
+}
+} // namespace sim
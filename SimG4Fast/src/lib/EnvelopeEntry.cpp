@@ -0,0 +1,24 @@
+#include "SimG4Fast/EnvelopeEntry.h"
+
+// Geant4
+#include "G4FastTrack.hh"
+#include "G4VSolid.hh"
+
+// STL
+#include <algorithm>
+#include <cmath>
+
+namespace sim {
+bool isEnteringEnvelope(const G4FastTrack& aFastTrack) {
+  const G4VSolid* envelope = aFastTrack.GetEnvelopeSolid();
+  const G4ThreeVector& localPosition = aFastTrack.GetPrimaryTrackLocalPosition();
+  return envelope->Inside(localPosition) == kSurface &&
+         envelope->SurfaceNormal(localPosition).dot(aFastTrack.GetPrimaryTrackLocalDirection()) < 0;
+}
+
+double envelopeEntryAngle(const G4FastTrack& aFastTrack) {
+  const G4ThreeVector& localDirection = aFastTrack.GetPrimaryTrackLocalDirection();
+  G4ThreeVector normal = aFastTrack.GetEnvelopeSolid()->SurfaceNormal(aFastTrack.GetPrimaryTrackLocalPosition());
+  return std::acos(std::clamp(-normal.dot(localDirection), -1., 1.));
+}
+} // namespace sim
@@ -0,0 +1,63 @@
+#include "SimG4Fast/EtaMomentumGrid.h"
+
+// STL
+#include <algorithm>
+#include <cmath>
+
+namespace sim {
+bool EtaMomentumGrid::set(const std::vector<double>& aEtaEdges, const std::vector<double>& aMomentumValues) {
+  m_etaEdges.clear();
+  m_momentumValues.clear();
+  m_etaStep = 0;
+  m_momentumStep = 0;
+  if (aEtaEdges.empty() || aMomentumValues.empty() || !(aEtaEdges.front() > 0)) {
+    return false;
+  }
+  auto notIncreasing = [](double aLow, double aHigh) { return !(aLow < aHigh); };
+  if (std::adjacent_find(aEtaEdges.begin(), aEtaEdges.end(), notIncreasing) != aEtaEdges.end() ||
+      std::adjacent_find(aMomentumValues.begin(), aMomentumValues.end(), notIncreasing) != aMomentumValues.end()) {
+    return false;
+  }
+  m_etaEdges = aEtaEdges;
+  m_momentumValues = aMomentumValues;
+  m_etaStep = m_etaEdges.back() / m_etaEdges.size();
+  if (m_momentumValues.size() > 1) {
+    m_momentumStep = (m_momentumValues.back() - m_momentumValues.front()) / (m_momentumValues.size() - 1);
+  }
+  return true;
+}
+
+bool EtaMomentumGrid::find(double aEta, double aMomentum, Bin& aBin) const {
+  double absEta = std::abs(aEta);
+  // also rejects NaN
+  if (m_etaEdges.empty() || !(absEta < m_etaEdges.back()) || !std::isfinite(aMomentum)) {
+    return false;
+  }
+  // |eta| bin: first guess assuming equidistant bins, then correct for the actual edges
+  int binsEta = m_etaEdges.size();
+  int iEta = std::min(static_cast<int>(absEta / m_etaStep), binsEta - 1);
+  while (iEta > 0 && absEta < m_etaEdges[iEta - 1]) {
+    --iEta;
+  }
+  while (absEta >= m_etaEdges[iEta]) {
+    ++iEta;
+  }
+  // momentum segment, the guess is clamped before the conversion so that far out-of-range momenta do not overflow
+  int binsP = m_momentumValues.size();
+  int iP = 0;
+  if (binsP > 1) {
+    double guess = (aMomentum - m_momentumValues.front()) / m_momentumStep;
+    iP = static_cast<int>(std::clamp(guess, 0., static_cast<double>(binsP - 2)));
+    while (iP > 0 && aMomentum < m_momentumValues[iP]) {
+      --iP;
+    }
+    while (iP < binsP - 2 && aMomentum >= m_momentumValues[iP + 1]) {
+      ++iP;
+    }
+  }
+  aBin.eta = iEta;
+  aBin.momentum = iP;
+  aBin.deltaMomentum = (binsP > 1) ? aMomentum - m_momentumValues[iP] : 0;
+  return true;
+}
+} // namespace sim
@@ -9,19 +9,94 @@
 #include "GaudiKernel/SystemOfUnits.h"
 
 // Geant4
+#include "G4AffineTransform.hh"
+#include "G4Event.hh"
+#include "G4EventManager.hh"
+#include "G4FieldManager.hh"
 #include "G4FieldTrackUpdator.hh"
+#include "G4MagneticField.hh"
 #include "G4PathFinder.hh"
+#include "G4PhysicalConstants.hh"
 #include "G4PrimaryParticle.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4TransportationManager.hh"
+#include "G4Tubs.hh"
 #include "G4UnitsTable.hh"
+#include "G4VSolid.hh"
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+/// Minimal path length to the exit point, shorter intersections are the starting point on the surface
+constexpr double minimalStep = 1e-6 * mm;
+/// Relative tolerance of the field components for the field to be considered uniform and along the axis
+constexpr double fieldTolerance = 1e-6;
+/// Minimal step proposed to G4PathFinder, long enough for the curling paths of low transverse momentum tracks
+constexpr double minimalPathFinderStep = 10 * m;
+
+/// ID of the event being simulated (-1 if none)
+int currentEventId() {
+  const G4Event* event = G4EventManager::GetEventManager()->GetConstCurrentEvent();
+  return (event != nullptr) ? event->GetEventID() : -1;
+}
+
+/// Path length to the first crossing of the cylinder of radius aRadius by a straight line in the transverse plane
+double lineCylinderCrossing(double aX, double aY, double aUx, double aUy, double aRadius) {
+  double a = aUx * aUx + aUy * aUy;
+  double b = aX * aUx + aY * aUy;
+  double c = aX * aX + aY * aY - aRadius * aRadius;
+  double disc = b * b - a * c;
+  if (a == 0 || disc < 0) {
+    return std::numeric_limits<double>::infinity();
+  }
+  double sqrtDisc = std::sqrt(disc);
+  for (double s : {(-b - sqrtDisc) / a, (-b + sqrtDisc) / a}) {
+    if (s > minimalStep) {
+      return s;
+    }
+  }
+  return std::numeric_limits<double>::infinity();
+}
+
+/** Path length to the first crossing of the cylinder of radius aRadius by a helix around the z axis.
+ *  The transverse projection of the helix is x = aCx + aRho sin(phi), y = aCy - aRho cos(phi), with phi = aPhi0 + aK s.
+ */
+double helixCylinderCrossing(double aCx, double aCy, double aRho, double aPhi0, double aK, double aRadius) {
+  double centreDist = std::sqrt(aCx * aCx + aCy * aCy);
+  if (centreDist == 0) {
+    return std::numeric_limits<double>::infinity();
+  }
+  // r^2(phi) = D^2 + rho^2 + 2 rho D sin(phi - beta)
+  double sinArg = (aRadius * aRadius - centreDist * centreDist - aRho * aRho) / (2 * aRho * centreDist);
+  if (std::abs(sinArg) > 1) {
+    return std::numeric_limits<double>::infinity();
+  }
+  double beta = std::atan2(aCy, aCx);
+  double period = twopi / std::abs(aK);
+  double crossing = std::numeric_limits<double>::infinity();
+  for (double phi : {beta + std::asin(sinArg), beta + pi - std::asin(sinArg)}) {
+    double s = (phi - aPhi0) / aK;
+    s -= period * std::floor(s / period);
+    if (s <= minimalStep) {
+      s += period;
+    }
+    crossing = std::min(crossing, s);
+  }
+  return crossing;
+}
+} // namespace
 
 namespace sim {
 
 FastSimModelTracker::FastSimModelTracker(const std::string& aModelName, G4Region* aEnvelope,
                                          ToolHandle<ISimG4ParticleSmearTool>& aSmearTool, double aMinMomentum,
-                                         double aMaxMomentum, double aMaxEta)
-    : G4VFastSimulationModel(aModelName, aEnvelope), m_msgSvc("MessageSvc", "FastSimModelTracker"),
-      m_log(&(*m_msgSvc), "FastSimModelTracker"), m_smearTool(aSmearTool),
+                                         double aMaxMomentum, double aMaxEta, bool aAnalyticPropagation)
+    : G4VFastSimulationModel(aModelName, aEnvelope), m_analyticPropagation(aAnalyticPropagation),
+      m_msgSvc("MessageSvc", "FastSimModelTracker"), m_log(&(*m_msgSvc), "FastSimModelTracker"),
+      m_smearTool(aSmearTool),
       m_minTriggerMomentum(aMinMomentum / Gaudi::Units::MeV), m_maxTriggerMomentum(aMaxMomentum / Gaudi::Units::MeV),
       m_maxTriggerEta(aMaxEta) {
   m_log << MSG::INFO << "Tracker smearing configuration:\n"
@@ -29,6 +104,7 @@ FastSimModelTracker::FastSimModelTracker(const std::string& aModelName, G4Region
         << "\tMomentum range:\t" << G4BestUnit(m_minTriggerMomentum, "Energy") << " - "
         << G4BestUnit(m_maxTriggerMomentum, "Energy") << "\n"
         << "\tMaximum pseudorapidity:\t" << m_maxTriggerEta << "\n"
+        << "\tAnalytic propagation:\t" << (m_analyticPropagation ? "enabled" : "disabled") << "\n"
         << endmsg;
 }
 
@@ -43,6 +119,11 @@ G4bool FastSimModelTracker::IsApplicable(const G4ParticleDefinition& aParticleTy
 }
 
 G4bool FastSimModelTracker::ModelTrigger(const G4FastTrack& aFastTrack) {
+  // a track left in the envelope by the propagation must not be smeared again
+  if (m_smearedEventId == currentEventId() &&
+      m_smearedTracks.count(aFastTrack.GetPrimaryTrack()->GetTrackID()) > 0) {
+    return false;
+  }
   double momentum = aFastTrack.GetPrimaryTrackLocalMomentum().mag();
   double eta = aFastTrack.GetPrimaryTrackLocalDirection().eta();
   // first check pseudorapidity
@@ -67,21 +148,31 @@ G4bool FastSimModelTracker::ModelTrigger(const G4FastTrack& aFastTrack) {
 void FastSimModelTracker::DoIt(const G4FastTrack& aFastTrack, G4FastStep& aFastStep) {
   // Calculate the position of the particle at the end of volume
   const G4Track* track = aFastTrack.GetPrimaryTrack();
-  G4ThreeVector spin = track->GetPolarization();
-  G4FieldTrack aFieldTrack('t');
-  G4FieldTrackUpdator::Update(&aFieldTrack, track);
-  G4double retSafety = -1.0;
-  ELimited retStepLimited;
-  G4FieldTrack endTrack('a');
-  G4double currentMinimumStep = 10 * m; // TODO change that to sth connected to particle momentum and geometry
-  G4PathFinder* fPathFinder = G4PathFinder::GetInstance();
-  fPathFinder->ComputeStep(aFieldTrack, currentMinimumStep, 0, track->GetCurrentStepNumber(), retSafety, retStepLimited,
-                           endTrack, track->GetVolume());
-  aFastStep.ProposePrimaryTrackFinalPosition(endTrack.GetPosition());
-
-  // Smear particle's momentum according to the tracker resolution
+  G4ThreeVector exitPosition;
+  const EnvelopeInfo& envelope = envelopeInfo(aFastTrack);
+  bool exitFound = envelope.analytic && propagateHelix(aFastTrack, envelope, exitPosition);
+  if (!exitFound) {
+    G4FieldTrack aFieldTrack('t');
+    G4FieldTrackUpdator::Update(&aFieldTrack, track);
+    G4double retSafety = -1.0;
+    ELimited retStepLimited;
+    G4FieldTrack endTrack('a');
+    G4PathFinder* fPathFinder = G4PathFinder::GetInstance();
+    fPathFinder->ComputeStep(aFieldTrack, envelope.maxStep, 0, track->GetCurrentStepNumber(), retSafety,
+                             retStepLimited, endTrack, track->GetVolume());
+    exitPosition = endTrack.GetPosition();
+  }
+  aFastStep.ProposePrimaryTrackFinalPosition(exitPosition);
+  if (m_smearedEventId != currentEventId()) {
+    m_smearedTracks.clear();
+    m_smearedEventId = currentEventId();
+  }
+  m_smearedTracks.insert(track->GetTrackID());
+
+  // Smear particle's momentum (and vertex, if the tool provides it) according to the tracker resolution
   G4ThreeVector Psm = track->GetMomentum();
-  m_smearTool->smearMomentum(Psm).ignore();
+  G4ThreeVector vertexSm = track->GetVertexPosition();
+  m_smearTool->smearTrack(vertexSm, Psm, track->GetDefinition()->GetPDGEncoding()).ignore();
   G4ThreeVector DeltaP = track->GetMomentum() - Psm;
   G4double Ekinorg = track->GetKineticEnergy();
   aFastStep.ClearDebugFlag(); // to disable Geant checks on energy
@@ -93,7 +184,134 @@ void FastSimModelTracker::DoIt(const G4FastTrack& aFastTrack, G4FastStep& aFastS
     info->setSmeared(true);
     info->setEndStatus(1); // how it is defined ???? as in HepMC ?
     info->setEndMomentum(Psm);
-    info->setVertexPosition(track->GetVertexPosition());
+    info->setVertexPosition(vertexSm);
+  }
+}
+
+const FastSimModelTracker::EnvelopeInfo& FastSimModelTracker::envelopeInfo(const G4FastTrack& aFastTrack) {
+  const G4LogicalVolume* volume = aFastTrack.GetEnvelopeLogicalVolume();
+  for (const auto& envelope : m_envelopes) {
+    if (envelope.volume == volume) {
+      return envelope;
+    }
+  }
+  EnvelopeInfo& envelope = m_envelopes.emplace_back();
+  envelope.volume = volume;
+  G4ThreeVector extentMin, extentMax;
+  aFastTrack.GetEnvelopeSolid()->BoundingLimits(extentMin, extentMax);
+  envelope.maxStep = std::max((extentMax - extentMin).mag(), minimalPathFinderStep);
+  if (!m_analyticPropagation) {
+    return envelope;
+  }
+  // only full cylinders are handled analytically
+  const G4Tubs* tubs = dynamic_cast<const G4Tubs*>(aFastTrack.GetEnvelopeSolid());
+  if (tubs == nullptr || tubs->GetDeltaPhiAngle() < twopi - 1e-9) {
+    m_log << MSG::INFO << "Envelope " << volume->GetName() << " is not a full cylinder, using G4PathFinder" << endmsg;
+    return envelope;
+  }
+  envelope.rMin = tubs->GetInnerRadius();
+  envelope.rMax = tubs->GetOuterRadius();
+  envelope.dz = tubs->GetZHalfLength();
+  // sample the field within the envelope, it needs to be uniform and along the cylinder axis
+  const G4FieldManager* fieldManager = volume->GetFieldManager();
+  if (fieldManager == nullptr) {
+    fieldManager = G4TransportationManager::GetTransportationManager()->GetFieldManager();
+  }
+  const G4Field* field = (fieldManager != nullptr) ? fieldManager->GetDetectorField() : nullptr;
+  const G4AffineTransform* toGlobal = aFastTrack.GetInverseAffineTransformation();
+  bool uniform = true;
+  bool first = true;
+  if (field != nullptr) {
+    // points just inside the surfaces, as the field may be defined up to the envelope boundaries
+    double rIn = envelope.rMax * (1 - 1e-6);
+    double zIn = envelope.dz * (1 - 1e-6);
+    for (double r : {envelope.rMin, 0.5 * (envelope.rMin + envelope.rMax), rIn}) {
+      for (double phi : {0., 0.5 * pi, pi, 1.5 * pi}) {
+        for (double z : {-zIn, 0., zIn}) {
+          G4ThreeVector position = toGlobal->TransformPoint(G4ThreeVector(r * std::cos(phi), r * std::sin(phi), z));
+          G4double point[4] = {position.x(), position.y(), position.z(), 0};
+          G4double value[6] = {0, 0, 0, 0, 0, 0};
+          field->GetFieldValue(point, value);
+          G4ThreeVector fieldValue(value[0], value[1], value[2]);
+          if (first) {
+            envelope.field = fieldValue;
+            first = false;
+          } else if ((fieldValue - envelope.field).mag() > fieldTolerance * envelope.field.mag()) {
+            uniform = false;
+          }
+        }
+      }
+    }
+  }
+  G4ThreeVector localField = aFastTrack.GetAffineTransformation()->TransformAxis(envelope.field);
+  if (!uniform || localField.perp() > fieldTolerance * localField.mag()) {
+    m_log << MSG::INFO << "Field in envelope " << volume->GetName()
+          << " is not uniform along the cylinder axis, using G4PathFinder" << endmsg;
+    return envelope;
+  }
+  envelope.analytic = true;
+  m_log << MSG::INFO << "Envelope " << volume->GetName() << " is a cylinder (r: " << envelope.rMin / mm << " - "
+        << envelope.rMax / mm << " mm, half-length: " << envelope.dz / mm << " mm) in uniform field of "
+        << envelope.field.mag() / tesla << " T, using analytic propagation" << endmsg;
+  return envelope;
+}
+
+bool FastSimModelTracker::propagateHelix(const G4FastTrack& aFastTrack, const EnvelopeInfo& aEnvelope,
+                                         G4ThreeVector& aExitPosition) const {
+  G4ThreeVector position = aFastTrack.GetPrimaryTrackLocalPosition();
+  G4ThreeVector momentum = aFastTrack.GetPrimaryTrackLocalMomentum();
+  double mom = momentum.mag();
+  if (mom == 0) {
+    return false;
+  }
+  double charge = aFastTrack.GetPrimaryTrack()->GetDynamicParticle()->GetCharge();
+  double bZ = aFastTrack.GetAffineTransformation()->TransformAxis(aEnvelope.field).z();
+  double sinTheta = momentum.perp() / mom;
+  double cosTheta = momentum.z() / mom;
+  double phi0 = momentum.phi();
+  // signed curvature of the transverse projection per unit path length
+  double k = -charge * c_light * bZ / mom;
+  bool straight = std::abs(k) * 2 * aEnvelope.rMax < 1e-9;
+
+  // exit through the end planes
+  double exitStep = std::numeric_limits<double>::infinity();
+  if (cosTheta > 0) {
+    exitStep = (aEnvelope.dz - position.z()) / cosTheta;
+  } else if (cosTheta < 0) {
+    exitStep = (-aEnvelope.dz - position.z()) / cosTheta;
+  }
+  // exit through the outer or inner cylinder
+  if (sinTheta > 0) {
+    double ux = sinTheta * std::cos(phi0);
+    double uy = sinTheta * std::sin(phi0);
+    double rho = straight ? 0 : sinTheta / k;
+    for (double radius : {aEnvelope.rMax, aEnvelope.rMin}) {
+      if (radius <= 0) {
+        continue;
+      }
+      if (straight) {
+        exitStep = std::min(exitStep, lineCylinderCrossing(position.x(), position.y(), ux, uy, radius));
+      } else {
+        exitStep = std::min(exitStep, helixCylinderCrossing(position.x() - rho * std::sin(phi0),
+                                                            position.y() + rho * std::cos(phi0), rho, phi0, k, radius));
+      }
+    }
+  }
+  if (!std::isfinite(exitStep)) {
+    return false;
+  }
+  exitStep = std::max(exitStep, 0.);
+
+  G4ThreeVector exitLocal;
+  if (straight) {
+    exitLocal = position + exitStep * momentum / mom;
+  } else {
+    double rho = sinTheta / k;
+    double phi = phi0 + k * exitStep;
+    exitLocal.set(position.x() + rho * (std::sin(phi) - std::sin(phi0)),
+                  position.y() - rho * (std::cos(phi) - std::cos(phi0)), position.z() + cosTheta * exitStep);
   }
+  aExitPosition = aFastTrack.GetInverseAffineTransformation()->TransformPoint(exitLocal);
+  return true;
 }
 } // namespace sim
@@ -0,0 +1,83 @@
+#include "SimG4Fast/GFlashBatchShowerModel.h"
+
+// Geant4
+#include "G4PhysicalConstants.hh"
+#include "GVFlashShowerParameterisation.hh"
+#include "Randomize.hh"
+
+// STL
+#include <algorithm>
+#include <cmath>
+
+namespace sim {
+
+GFlashBatchShowerModel::GFlashBatchShowerModel(const std::string& aModelName, G4Region* aEnvelope,
+                                               GVFlashShowerParameterisation& aParametrisation,
+                                               const std::string& aReadoutName, dd4hep::Segmentation aSegmentation,
+                                               double aStepInX0)
+    : GFlashShowerModel(aModelName, aEnvelope), m_parametrisation(aParametrisation), m_stepInX0(aStepInX0),
+      m_depositor(aReadoutName, aSegmentation) {
+  SetParameterisation(aParametrisation);
+}
+
+GFlashBatchShowerModel::~GFlashBatchShowerModel() {}
+
+void GFlashBatchShowerModel::DoIt(const G4FastTrack& aFastTrack, G4FastStep& aFastStep) {
+  aFastStep.KillPrimaryTrack();
+  aFastStep.ProposePrimaryTrackPathLength(0.0);
+  aFastStep.ProposeTotalEnergyDeposited(aFastTrack.GetPrimaryTrack()->GetKineticEnergy());
+  generateSpots(aFastTrack);
+  const G4Track* track = aFastTrack.GetPrimaryTrack();
+  m_depositor.deposit(m_spotPositions, m_spotEnergies, track->GetTrackID(), track->GetDefinition()->GetPDGEncoding(),
+                      track->GetGlobalTime());
+}
+
+void GFlashBatchShowerModel::generateSpots(const G4FastTrack& aFastTrack) {
+  m_spotPositions.clear();
+  m_spotEnergies.clear();
+  const G4Track* track = aFastTrack.GetPrimaryTrack();
+  double energy = track->GetKineticEnergy();
+  double step = m_stepInX0 * m_parametrisation.GetX0();
+  if (energy <= 0 || step <= 0) {
+    return;
+  }
+  // shower axis and two directions orthogonal to it (global frame)
+  const G4ThreeVector& start = track->GetPosition();
+  G4ThreeVector direction = track->GetMomentumDirection();
+  G4ThreeVector ortho = direction.orthogonal().unit();
+  G4ThreeVector cross = direction.cross(ortho);
+  // depth available to the shower before it leaves the envelope
+  double bound = aFastTrack.GetEnvelopeSolid()->DistanceToOut(aFastTrack.GetPrimaryTrackLocalPosition(),
+                                                              aFastTrack.GetPrimaryTrackLocalDirection());
+  m_parametrisation.GenerateLongitudinalProfile(energy);
+
+  double energyLeft = energy;
+  double depthEnd = 0;
+  double lastEneIntegral = 0;
+  double lastNspIntegral = 0;
+  while (energyLeft > 0 && depthEnd < bound) {
+    double dz = std::min(step, bound - depthEnd);
+    depthEnd += dz;
+    double eneIntegral = m_parametrisation.IntegrateEneLongitudinal(depthEnd);
+    double stepEnergy = std::min(energyLeft, (eneIntegral - lastEneIntegral) * energy);
+    lastEneIntegral = eneIntegral;
+    double nspIntegral = m_parametrisation.IntegrateNspLongitudinal(depthEnd);
+    int numSpots =
+        std::max(1, static_cast<int>(std::floor((nspIntegral - lastNspIntegral) * m_parametrisation.GetNspot())));
+    lastNspIntegral = nspIntegral;
+    if (stepEnergy <= 0) {
+      continue;
+    }
+    energyLeft -= stepEnergy;
+    // spots are equally spaced along the step and randomly distributed in the transverse plane
+    double depthCentre = depthEnd - 0.5 * dz;
+    for (int iSpot = 0; iSpot < numSpots; ++iSpot) {
+      double radius = m_parametrisation.GenerateRadius(iSpot, energy, depthCentre);
+      double phi = twopi * G4UniformRand();
+      double depth = depthCentre + dz / numSpots * (iSpot + 0.5 - 0.5 * numSpots);
+      m_spotPositions.push_back(start + depth * direction + radius * (std::cos(phi) * ortho + std::sin(phi) * cross));
+      m_spotEnergies.push_back(stepEnergy / numSpots);
+    }
+  }
+}
+} // namespace sim
@@ -0,0 +1,107 @@
+#include "SimG4Fast/MLShowerModel.h"
+
+// FCCSW
+#include "SimG4Fast/EnvelopeEntry.h"
+
+// Geant4
+#include "G4FastStep.hh"
+#include "G4FastTrack.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+// STL
+#include <algorithm>
+#include <cmath>
+
+namespace sim {
+
+MLShowerModel::MLShowerModel(const std::string& aModelName, G4Region* aEnvelope, const DenseNetwork& aNetwork,
+                             size_t aLatentSize, const VoxelGrid& aGrid, const std::string& aReadoutName,
+                             dd4hep::Segmentation aSegmentation, const std::vector<int>& aParticles,
+                             double aMinEnergy, double aMaxEnergy, size_t aMaxBatchSize)
+    : G4VFastSimulationModel(aModelName, aEnvelope), m_network(aNetwork), m_latentSize(aLatentSize),
+      m_particles(aParticles), m_minEnergy(aMinEnergy), m_maxEnergy(aMaxEnergy),
+      m_maxBatchSize(std::max<size_t>(aMaxBatchSize, 1)), m_latent(aLatentSize),
+      m_depositor(aReadoutName, aSegmentation) {
+  // the voxel centres are the same for all the showers, only the frame changes
+  m_voxelCentres.reserve(aGrid.numR * aGrid.numPhi * aGrid.numZ);
+  for (size_t iR = 0; iR < aGrid.numR; ++iR) {
+    double r = (iR + 0.5) * aGrid.sizeR;
+    for (size_t iPhi = 0; iPhi < aGrid.numPhi; ++iPhi) {
+      double phi = (iPhi + 0.5) * twopi / aGrid.numPhi;
+      for (size_t iZ = 0; iZ < aGrid.numZ; ++iZ) {
+        m_voxelCentres.emplace_back(r * std::cos(phi), r * std::sin(phi), (iZ + 0.5) * aGrid.sizeZ);
+      }
+    }
+  }
+  m_queue.reserve(m_maxBatchSize);
+}
+
+MLShowerModel::~MLShowerModel() {}
+
+G4bool MLShowerModel::IsApplicable(const G4ParticleDefinition& aParticleType) {
+  return std::find(m_particles.begin(), m_particles.end(), aParticleType.GetPDGEncoding()) != m_particles.end();
+}
+
+G4bool MLShowerModel::ModelTrigger(const G4FastTrack& aFastTrack) {
+  double energy = aFastTrack.GetPrimaryTrack()->GetKineticEnergy();
+  // the network is conditioned on the entry point, the particles created inside the envelope are not showered
+  return energy >= m_minEnergy && energy <= m_maxEnergy && isEnteringEnvelope(aFastTrack);
+}
+
+void MLShowerModel::DoIt(const G4FastTrack& aFastTrack, G4FastStep& aFastStep) {
+  const G4Track* track = aFastTrack.GetPrimaryTrack();
+  aFastStep.KillPrimaryTrack();
+  aFastStep.ProposePrimaryTrackPathLength(0.0);
+  aFastStep.ProposeTotalEnergyDeposited(track->GetKineticEnergy());
+  m_queue.push_back({track->GetPosition(), track->GetMomentumDirection(), track->GetKineticEnergy(),
+                     track->GetGlobalTime(), track->GetTrackID(), track->GetDefinition()->GetPDGEncoding()});
+  if (m_queue.size() >= m_maxBatchSize) {
+    Flush();
+  }
+}
+
+void MLShowerModel::Flush() {
+  if (m_queue.empty()) {
+    return;
+  }
+  // inputs of all the queued particles, evaluated at once
+  const size_t numInputs = kNumConditions + m_latentSize;
+  m_inputs.resize(m_queue.size() * numInputs);
+  for (size_t iShower = 0; iShower < m_queue.size(); ++iShower) {
+    const QueuedShower& shower = m_queue[iShower];
+    float* inputs = m_inputs.data() + iShower * numInputs;
+    inputs[0] = std::log10(shower.energy / GeV);
+    inputs[1] = shower.direction.theta();
+    inputs[2] = shower.direction.phi();
+    inputs[3] = shower.position.x() / m;
+    inputs[4] = shower.position.y() / m;
+    inputs[5] = shower.position.z() / m;
+    if (m_latentSize > 0) {
+      G4RandGauss::shootArray(m_latentSize, m_latent.data());
+      std::copy(m_latent.begin(), m_latent.end(), inputs + kNumConditions);
+    }
+  }
+  m_network.evaluate(m_inputs.data(), m_queue.size(), m_outputs, m_networkBuffer);
+
+  // voxels placed along the particle direction, starting at the entry point
+  const size_t numVoxels = m_voxelCentres.size();
+  m_positions.resize(numVoxels);
+  m_energies.resize(numVoxels);
+  for (size_t iShower = 0; iShower < m_queue.size(); ++iShower) {
+    const QueuedShower& shower = m_queue[iShower];
+    G4ThreeVector ortho = shower.direction.orthogonal().unit();
+    G4ThreeVector cross = shower.direction.cross(ortho);
+    const float* outputs = m_outputs.data() + iShower * numVoxels;
+    for (size_t iVoxel = 0; iVoxel < numVoxels; ++iVoxel) {
+      const G4ThreeVector& centre = m_voxelCentres[iVoxel];
+      m_positions[iVoxel] =
+          shower.position + centre.x() * ortho + centre.y() * cross + centre.z() * shower.direction;
+      m_energies[iVoxel] = outputs[iVoxel] * shower.energy;
+    }
+    m_depositor.deposit(m_positions, m_energies, shower.trackId, shower.pdg, shower.time);
+  }
+  m_queue.clear();
+}
+} // namespace sim
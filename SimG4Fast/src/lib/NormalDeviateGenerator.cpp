@@ -0,0 +1,19 @@
+#include "SimG4Fast/NormalDeviateGenerator.h"
+
+// STL
+#include <algorithm>
+
+namespace sim {
+StatusCode NormalDeviateGenerator::initialize(const SmartIF<IRndmGenSvc>& aRandSvc) {
+  return m_gauss.initialize(aRandSvc, Rndm::Gauss(0, 1));
+}
+
+void NormalDeviateGenerator::fill(double* aDeviates, size_t aNum) {
+  if (aNum == 0) {
+    return;
+  }
+  // only the requested numbers are drawn, nothing is left over for the next call
+  m_gauss.shootArray(m_batch, aNum).ignore();
+  std::copy_n(m_batch.begin(), aNum, aDeviates);
+}
+} // namespace sim
@@ -0,0 +1,240 @@
+#include "SimG4Fast/ShowerLibrary.h"
+
+// STL
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+// POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+/// Size of the section rounded up to 8 bytes
+size_t alignedSize(size_t aSize) { return (aSize + 7) / 8 * 8; }
+
+/// Find the bin of the value in the sorted edges (-1 outside the edges)
+long findBin(const double* aEdges, size_t aNumBins, double aValue) {
+  if (aNumBins == 0 || aValue < aEdges[0] || aValue >= aEdges[aNumBins]) {
+    return -1;
+  }
+  return std::upper_bound(aEdges, aEdges + aNumBins + 1, aValue) - aEdges - 1;
+}
+
+/// Find the index of the particle type (-1 if not present)
+long findParticle(const int32_t* aPdgs, size_t aNumParticles, int aPdg) {
+  auto pdg = std::find(aPdgs, aPdgs + aNumParticles, aPdg);
+  return (pdg == aPdgs + aNumParticles) ? -1 : pdg - aPdgs;
+}
+} // namespace
+
+namespace sim {
+
+ShowerLibrary::~ShowerLibrary() { close(); }
+
+void ShowerLibrary::close() {
+  if (m_data != nullptr) {
+    munmap(m_data, m_size);
+  }
+  m_data = nullptr;
+  m_size = 0;
+  m_header = nullptr;
+}
+
+bool ShowerLibrary::open(const std::string& aFileName, std::string& aError) {
+  close();
+  int fd = ::open(aFileName.c_str(), O_RDONLY);
+  if (fd < 0) {
+    aError = "cannot open file " + aFileName;
+    return false;
+  }
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 || static_cast<size_t>(fileStat.st_size) < sizeof(FileHeader)) {
+    ::close(fd);
+    aError = "file " + aFileName + " is too short";
+    return false;
+  }
+  m_size = fileStat.st_size;
+  m_data = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+  // the mapping stays valid after the file is closed
+  ::close(fd);
+  if (m_data == MAP_FAILED) {
+    m_data = nullptr;
+    aError = "cannot map file " + aFileName;
+    return false;
+  }
+  const char* data = static_cast<const char*>(m_data);
+  m_header = reinterpret_cast<const FileHeader*>(data);
+  if (std::memcmp(m_header->magic, kMagic, sizeof(kMagic)) != 0 || m_header->version != kVersion) {
+    close();
+    aError = "file " + aFileName + " is not a shower library of version " + std::to_string(kVersion);
+    return false;
+  }
+  const size_t numBins = static_cast<size_t>(m_header->numParticles) * m_header->numEnergyBins * m_header->numAngleBins;
+  size_t offset = sizeof(FileHeader);
+  size_t pdgOffset = offset;
+  offset += alignedSize(m_header->numParticles * sizeof(int32_t));
+  size_t energyOffset = offset;
+  offset += (m_header->numEnergyBins + 1) * sizeof(double);
+  size_t angleOffset = offset;
+  offset += (m_header->numAngleBins + 1) * sizeof(double);
+  size_t binOffset = offset;
+  offset += numBins * sizeof(BinEntry);
+  size_t showerOffset = offset;
+  offset += m_header->numShowers * sizeof(ShowerEntry);
+  size_t spotOffset = offset;
+  offset += m_header->numSpots * sizeof(Spot);
+  if (offset != m_size) {
+    close();
+    aError = "size of file " + aFileName + " does not match its header";
+    return false;
+  }
+  m_pdgs = reinterpret_cast<const int32_t*>(data + pdgOffset);
+  m_energyEdges = reinterpret_cast<const double*>(data + energyOffset);
+  m_angleEdges = reinterpret_cast<const double*>(data + angleOffset);
+  m_bins = reinterpret_cast<const BinEntry*>(data + binOffset);
+  m_showers = reinterpret_cast<const ShowerEntry*>(data + showerOffset);
+  m_spots = reinterpret_cast<const Spot*>(data + spotOffset);
+  // the indices are checked once, so the showers can be used without further checks
+  for (size_t iBin = 0; iBin < numBins; ++iBin) {
+    if (m_bins[iBin].firstShower + m_bins[iBin].numShowers > m_header->numShowers) {
+      close();
+      aError = "bin " + std::to_string(iBin) + " of file " + aFileName + " points outside of the showers";
+      return false;
+    }
+  }
+  for (uint64_t iShower = 0; iShower < m_header->numShowers; ++iShower) {
+    if (m_showers[iShower].firstSpot + m_showers[iShower].numSpots > m_header->numSpots) {
+      close();
+      aError = "shower " + std::to_string(iShower) + " of file " + aFileName + " points outside of the spots";
+      return false;
+    }
+  }
+  return true;
+}
+
+const ShowerLibrary::BinEntry* ShowerLibrary::bin(int aPdg, double aEnergy, double aAngle) const {
+  if (m_header == nullptr) {
+    return nullptr;
+  }
+  long particle = findParticle(m_pdgs, m_header->numParticles, aPdg);
+  long energyBin = findBin(m_energyEdges, m_header->numEnergyBins, aEnergy);
+  long angleBin = findBin(m_angleEdges, m_header->numAngleBins, aAngle);
+  if (particle < 0 || energyBin < 0 || angleBin < 0) {
+    return nullptr;
+  }
+  return m_bins + (particle * m_header->numEnergyBins + energyBin) * m_header->numAngleBins + angleBin;
+}
+
+ShowerLibraryWriter::ShowerLibraryWriter(const std::vector<int>& aPdgs, const std::vector<double>& aEnergyEdges,
+                                         const std::vector<double>& aAngleEdges, size_t aMaxShowersPerBin)
+    : m_pdgs(aPdgs.begin(), aPdgs.end()), m_energyEdges(aEnergyEdges), m_angleEdges(aAngleEdges),
+      m_maxShowersPerBin(aMaxShowersPerBin) {
+  size_t numBins = m_pdgs.size() * (m_energyEdges.size() > 1 ? m_energyEdges.size() - 1 : 0) *
+                   (m_angleEdges.size() > 1 ? m_angleEdges.size() - 1 : 0);
+  m_binShowers.resize(numBins);
+  m_binSpots.resize(numBins);
+}
+
+long ShowerLibraryWriter::binIndex(int aPdg, double aEnergy, double aAngle) const {
+  if (m_binShowers.empty()) {
+    return -1;
+  }
+  long particle = findParticle(m_pdgs.data(), m_pdgs.size(), aPdg);
+  long energyBin = findBin(m_energyEdges.data(), m_energyEdges.size() - 1, aEnergy);
+  long angleBin = findBin(m_angleEdges.data(), m_angleEdges.size() - 1, aAngle);
+  if (particle < 0 || energyBin < 0 || angleBin < 0) {
+    return -1;
+  }
+  return (particle * (m_energyEdges.size() - 1) + energyBin) * (m_angleEdges.size() - 1) + angleBin;
+}
+
+bool ShowerLibraryWriter::accepts(int aPdg, double aEnergy, double aAngle) const {
+  long index = binIndex(aPdg, aEnergy, aAngle);
+  return index >= 0 && m_binShowers[index].size() < m_maxShowersPerBin;
+}
+
+bool ShowerLibraryWriter::add(int aPdg, double aEnergy, double aAngle,
+                              const std::vector<ShowerLibrary::Spot>& aSpots) {
+  if (!accepts(aPdg, aEnergy, aAngle)) {
+    return false;
+  }
+  long index = binIndex(aPdg, aEnergy, aAngle);
+  auto& spots = m_binSpots[index];
+  m_binShowers[index].push_back({spots.size(), static_cast<uint32_t>(aSpots.size()), static_cast<float>(aEnergy)});
+  spots.insert(spots.end(), aSpots.begin(), aSpots.end());
+  ++m_numShowers;
+  return true;
+}
+
+bool ShowerLibraryWriter::write(const std::string& aFileName, std::string& aError) const {
+  // the library is written to a temporary file renamed at the end, so that jobs mapping the library (or a failed
+  // write) never see a partially written file
+  const std::string tmpFileName = aFileName + ".tmp." + std::to_string(::getpid());
+  std::ofstream file(tmpFileName, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    aError = "cannot open file " + tmpFileName;
+    return false;
+  }
+  ShowerLibrary::FileHeader header;
+  std::memcpy(header.magic, ShowerLibrary::kMagic, sizeof(header.magic));
+  header.version = ShowerLibrary::kVersion;
+  header.numParticles = m_pdgs.size();
+  header.numEnergyBins = m_energyEdges.size() > 1 ? m_energyEdges.size() - 1 : 0;
+  header.numAngleBins = m_angleEdges.size() > 1 ? m_angleEdges.size() - 1 : 0;
+  header.numShowers = m_numShowers;
+  header.numSpots = 0;
+  for (const auto& spots : m_binSpots) {
+    header.numSpots += spots.size();
+  }
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  std::vector<int32_t> pdgs(m_pdgs);
+  pdgs.resize(alignedSize(pdgs.size() * sizeof(int32_t)) / sizeof(int32_t), 0);
+  file.write(reinterpret_cast<const char*>(pdgs.data()), pdgs.size() * sizeof(int32_t));
+  if (header.numEnergyBins > 0) {
+    file.write(reinterpret_cast<const char*>(m_energyEdges.data()), m_energyEdges.size() * sizeof(double));
+  } else {
+    double edge = 0;
+    file.write(reinterpret_cast<const char*>(&edge), sizeof(edge));
+  }
+  if (header.numAngleBins > 0) {
+    file.write(reinterpret_cast<const char*>(m_angleEdges.data()), m_angleEdges.size() * sizeof(double));
+  } else {
+    double edge = 0;
+    file.write(reinterpret_cast<const char*>(&edge), sizeof(edge));
+  }
+  // showers and spots of the bins are concatenated, their indices become global
+  uint64_t firstShower = 0;
+  for (const auto& showers : m_binShowers) {
+    ShowerLibrary::BinEntry bin{firstShower, showers.size()};
+    file.write(reinterpret_cast<const char*>(&bin), sizeof(bin));
+    firstShower += showers.size();
+  }
+  uint64_t firstSpot = 0;
+  for (size_t iBin = 0; iBin < m_binShowers.size(); ++iBin) {
+    for (auto shower : m_binShowers[iBin]) {
+      shower.firstSpot += firstSpot;
+      file.write(reinterpret_cast<const char*>(&shower), sizeof(shower));
+    }
+    firstSpot += m_binSpots[iBin].size();
+  }
+  for (const auto& spots : m_binSpots) {
+    file.write(reinterpret_cast<const char*>(spots.data()), spots.size() * sizeof(ShowerLibrary::Spot));
+  }
+  file.close();
+  if (!file) {
+    std::remove(tmpFileName.c_str());
+    aError = "cannot write file " + tmpFileName;
+    return false;
+  }
+  if (std::rename(tmpFileName.c_str(), aFileName.c_str()) != 0) {
+    std::remove(tmpFileName.c_str());
+    aError = "cannot rename " + tmpFileName + " to " + aFileName;
+    return false;
+  }
+  return true;
+}
+} // namespace sim
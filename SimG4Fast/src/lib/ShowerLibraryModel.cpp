@@ -0,0 +1,142 @@
+#include "SimG4Fast/ShowerLibraryModel.h"
+
+// FCCSW
+#include "SimG4Common/Geant4CaloHit.h"
+#include "SimG4Fast/EnvelopeEntry.h"
+
+// Geant4
+#include "G4Event.hh"
+#include "G4EventManager.hh"
+#include "G4FastStep.hh"
+#include "G4FastTrack.hh"
+#include "G4HCofThisEvent.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SDManager.hh"
+#include "Randomize.hh"
+
+// STL
+#include <algorithm>
+
+namespace sim {
+
+ShowerLibraryModel::ShowerLibraryModel(const std::string& aModelName, G4Region* aEnvelope,
+                                       const ShowerLibrary& aLibrary, const std::string& aReadoutName,
+                                       dd4hep::Segmentation aSegmentation, double aMinEnergy, double aMaxEnergy)
+    : G4VFastSimulationModel(aModelName, aEnvelope), m_library(&aLibrary), m_readoutName(aReadoutName),
+      m_minEnergy(aMinEnergy), m_maxEnergy(aMaxEnergy),
+      m_depositor(std::make_unique<CalorimeterHitDepositor>(aReadoutName, aSegmentation)) {}
+
+ShowerLibraryModel::ShowerLibraryModel(const std::string& aModelName, G4Region* aEnvelope,
+                                       ShowerLibraryWriter& aWriter, const std::string& aReadoutName,
+                                       double aMinEnergy, double aMaxEnergy)
+    : G4VFastSimulationModel(aModelName, aEnvelope), m_writer(&aWriter), m_readoutName(aReadoutName),
+      m_minEnergy(aMinEnergy), m_maxEnergy(aMaxEnergy) {}
+
+ShowerLibraryModel::~ShowerLibraryModel() {}
+
+G4bool ShowerLibraryModel::ModelTrigger(const G4FastTrack& aFastTrack) {
+  const G4Track* track = aFastTrack.GetPrimaryTrack();
+  double energy = track->GetKineticEnergy();
+  if (energy < m_minEnergy || energy > m_maxEnergy) {
+    return false;
+  }
+  // the library only holds the showers of the particles entering the envelope, not of the ones created inside
+  if (!isEnteringEnvelope(aFastTrack)) {
+    return false;
+  }
+  if (m_writer != nullptr) {
+    recordHarvestedParticle(aFastTrack);
+    return false;
+  }
+  const ShowerLibrary::BinEntry* bin =
+      m_library->bin(track->GetDefinition()->GetPDGEncoding(), energy, envelopeEntryAngle(aFastTrack));
+  return bin != nullptr && bin->numShowers > 0;
+}
+
+void ShowerLibraryModel::DoIt(const G4FastTrack& aFastTrack, G4FastStep& aFastStep) {
+  const G4Track* track = aFastTrack.GetPrimaryTrack();
+  double energy = track->GetKineticEnergy();
+  aFastStep.KillPrimaryTrack();
+  aFastStep.ProposePrimaryTrackPathLength(0.0);
+  aFastStep.ProposeTotalEnergyDeposited(energy);
+  const ShowerLibrary::BinEntry* bin =
+      m_library->bin(track->GetDefinition()->GetPDGEncoding(), energy, envelopeEntryAngle(aFastTrack));
+  if (bin == nullptr || bin->numShowers == 0) {
+    return;
+  }
+  uint64_t index = std::min<uint64_t>(G4UniformRand() * bin->numShowers, bin->numShowers - 1);
+  const ShowerLibrary::ShowerEntry& shower = m_library->shower(bin->firstShower + index);
+  const ShowerLibrary::Spot* spots = m_library->spots(shower);
+
+  // shower frame: z along the particle direction, randomly rotated around it
+  const G4ThreeVector& start = track->GetPosition();
+  const G4ThreeVector& direction = track->GetMomentumDirection();
+  G4ThreeVector ortho = direction.orthogonal().unit();
+  ortho.rotate(twopi * G4UniformRand(), direction);
+  G4ThreeVector cross = direction.cross(ortho);
+  m_positions.resize(shower.numSpots);
+  m_energies.resize(shower.numSpots);
+  for (uint32_t iSpot = 0; iSpot < shower.numSpots; ++iSpot) {
+    const ShowerLibrary::Spot& spot = spots[iSpot];
+    m_positions[iSpot] = start + spot.x * ortho + spot.y * cross + spot.z * direction;
+    m_energies[iSpot] = spot.energy * energy;
+  }
+  m_depositor->deposit(m_positions, m_energies, track->GetTrackID(), track->GetDefinition()->GetPDGEncoding(),
+                       track->GetGlobalTime());
+}
+
+void ShowerLibraryModel::recordHarvestedParticle(const G4FastTrack& aFastTrack) {
+  const G4Event* event = G4EventManager::GetEventManager()->GetConstCurrentEvent();
+  if (event == nullptr) {
+    return;
+  }
+  if (event->GetEventID() != m_harvestEventId) {
+    m_harvested.clear();
+    m_harvestEventId = event->GetEventID();
+  }
+  const G4Track* track = aFastTrack.GetPrimaryTrack();
+  m_harvested.push_back({track->GetPosition(), track->GetMomentumDirection(), track->GetKineticEnergy(),
+                         envelopeEntryAngle(aFastTrack), track->GetDefinition()->GetPDGEncoding()});
+}
+
+void ShowerLibraryModel::Flush() {
+  if (m_writer == nullptr) {
+    return;
+  }
+  const G4Event* event = G4EventManager::GetEventManager()->GetConstCurrentEvent();
+  if (event == nullptr || event->GetEventID() == m_lastHarvestedEventId) {
+    return;
+  }
+  m_lastHarvestedEventId = event->GetEventID();
+  // the hits can only be attributed to the shower if one particle entered the envelope
+  if (m_harvestEventId != event->GetEventID() || m_harvested.size() != 1) {
+    m_harvested.clear();
+    return;
+  }
+  const HarvestedParticle particle = m_harvested.front();
+  m_harvested.clear();
+  if (!m_writer->accepts(particle.pdg, particle.energy, particle.angle)) {
+    return;
+  }
+  int collectionId = G4SDManager::GetSDMpointer()->GetCollectionID(m_readoutName);
+  if (collectionId < 0 || event->GetHCofThisEvent() == nullptr) {
+    return;
+  }
+  auto collection =
+      dynamic_cast<G4THitsCollection<k4::Geant4CaloHit>*>(event->GetHCofThisEvent()->GetHC(collectionId));
+  if (collection == nullptr) {
+    return;
+  }
+  G4ThreeVector ortho = particle.direction.orthogonal().unit();
+  G4ThreeVector cross = particle.direction.cross(ortho);
+  m_spots.clear();
+  for (size_t iHit = 0; iHit < collection->entries(); ++iHit) {
+    const k4::Geant4CaloHit* hit = (*collection)[iHit];
+    G4ThreeVector distance = hit->position - particle.position;
+    m_spots.push_back({static_cast<float>(distance.dot(ortho)), static_cast<float>(distance.dot(cross)),
+                       static_cast<float>(distance.dot(particle.direction)),
+                       static_cast<float>(hit->energyDeposit / particle.energy)});
+  }
+  m_writer->add(particle.pdg, particle.energy, particle.angle, m_spots);
+}
+} // namespace sim
@@ -3,6 +3,17 @@
 
 #include "G4VUserActionInitialization.hh"
 
+// FCCSW
+#include "SimG4Full/RussianRoulettePolicy.h"
+#include "SimG4Full/TruthPruningPolicy.h"
+
+// STL
+#include <memory>
+
+namespace sim {
+class RussianRouletteSummary;
+}
+
 /** @class FullSimActions SimG4Full/SimG4Full/FullSimActions.h FullSimActions.h
  *
  *  User action initialization for full simulation.
@@ -14,16 +25,36 @@
 namespace sim {
 class FullSimActions : public G4VUserActionInitialization {
 public:
-  FullSimActions(bool enableHistory, double aEnergyCut);
+  /** Constructor.
+   *  @param enableHistory Flag whether or not to store particle history.
+   *  @param aPolicy Policy deciding which tracks are kept in the history.
+   *  @param aKeepAncestors Flag to keep all the ancestors of the particles kept in the history.
+   */
+  FullSimActions(bool enableHistory, const TruthPruningPolicy& aPolicy, bool aKeepAncestors);
   virtual ~FullSimActions();
+  /** Enable the kill and Russian roulette of secondary tracks.
+   *  @param aPolicy Policy deciding which tracks are killed or played in the roulette.
+   *  @param aValidation Flag to only measure the effect of the roulette, without killing any track.
+   *  @param aSummary Counters of the roulette, shared by the actions of all the threads.
+   */
+  void setRussianRoulette(const RussianRoulettePolicy& aPolicy, bool aValidation,
+                          std::shared_ptr<RussianRouletteSummary> aSummary);
   /// Create all user actions.
   virtual void Build() const final;
 
 private:
   /// Flag whether or not to store particle history
   bool m_enableHistory;
-  /// energy threshold for secondaries to be saved
-  double m_energyCut;
+  /// policy deciding which tracks are kept in the history
+  TruthPruningPolicy m_policy;
+  /// Flag to keep all the ancestors of the particles kept in the history
+  bool m_keepAncestors;
+  /// Policy deciding which tracks are killed or played in the roulette
+  RussianRoulettePolicy m_roulettePolicy;
+  /// Flag to only measure the effect of the roulette
+  bool m_rouletteValidation = false;
+  /// Counters of the roulette (nullptr: roulette disabled)
+  std::shared_ptr<RussianRouletteSummary> m_rouletteSummary;
 };
 } // namespace sim
 
@@ -13,13 +13,20 @@
 namespace sim {
 class ParticleHistoryEventAction : public G4UserEventAction {
 public:
-  ParticleHistoryEventAction();
+  /** Constructor.
+   *  @param aKeepAncestors Flag to keep all the ancestors of the particles kept in the history.
+   */
+  explicit ParticleHistoryEventAction(bool aKeepAncestors = true);
   virtual ~ParticleHistoryEventAction() = default;
 
   /// EventInformation data structure is created here
   virtual void BeginOfEventAction(const G4Event* anEvent);
   /// empty action
   virtual void EndOfEventAction(const G4Event* anEvent);
+
+private:
+  /// Flag to keep all the ancestors of the particles kept in the history
+  bool m_keepAncestors;
 };
 } // namespace sim
 
@@ -0,0 +1,53 @@
+#ifndef SIMG4FULL_REGIONSECONDARYCOUNTER_H
+#define SIMG4FULL_REGIONSECONDARYCOUNTER_H
+
+// Geant4
+#include "G4UserSteppingAction.hh"
+
+// STL
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Gaudi
+class MsgStream;
+
+/** @class sim::RegionSecondaryCounter SimG4Full/SimG4Full/RegionSecondaryCounter.h RegionSecondaryCounter.h
+ *
+ *  Regional stepping action counting the steps taken in a region and the secondaries produced by these steps,
+ *  separately for the particles with production cuts (gamma, e-, e+, proton) and for all the other particles.
+ *  It is attached to the region with G4Region::SetRegionalSteppingAction, so it is only called for the steps which
+ *  start in the region, after the global user stepping action.
+ */
+
+namespace sim {
+class RegionSecondaryCounter : public G4UserSteppingAction {
+public:
+  /// Species of the counted secondaries
+  enum Species { kGamma = 0, kElectron, kPositron, kProton, kOther, kNumSpecies };
+  /** Constructor.
+   *  @param[in] aRegionName Name of the region, used in the printout.
+   */
+  explicit RegionSecondaryCounter(const std::string& aRegionName);
+  virtual ~RegionSecondaryCounter() = default;
+  /** Count the step and its secondaries.
+   *  @param[in] aStep Step taken in the region.
+   */
+  virtual void UserSteppingAction(const G4Step* aStep) final;
+  /** Print the counts.
+   *  @param[in] aLog message stream to print to
+   */
+  void print(MsgStream& aLog) const;
+
+private:
+  /// Name of the region
+  std::string m_regionName;
+  /// Number of steps taken in the region
+  std::atomic<uint64_t> m_numSteps{0};
+  /// Number of secondaries produced in the region, per species
+  std::array<std::atomic<uint64_t>, kNumSpecies> m_numSecondaries{};
+};
+} // namespace sim
+
+#endif /* SIMG4FULL_REGIONSECONDARYCOUNTER_H */
@@ -0,0 +1,96 @@
+#ifndef SIMG4FULL_RULEPARSER_H
+#define SIMG4FULL_RULEPARSER_H
+
+// STL
+#include <string>
+#include <utility>
+#include <vector>
+
+class G4Region;
+
+/** @class sim::RuleParser SimG4Full/SimG4Full/RuleParser.h RuleParser.h
+ *
+ *  Parser of the rules of the track policies (sim::TruthPruningPolicy, sim::RussianRoulettePolicy).
+ *  A rule is a string made of an action followed by any number of conditions 'key=value'. Lists of values are comma
+ *  separated. The parser checks the syntax and converts the values, the policies interpret the keys.
+ */
+
+namespace sim {
+class RuleParser {
+public:
+  /// Condition of a rule, as key and value
+  using Condition = std::pair<std::string, std::string>;
+  /** Split the rule into its action and its conditions.
+   *  @param[in] aRule Definition of the rule.
+   *  @param[in] aActions Allowed actions.
+   *  @param[out] aError Description of the syntax error, if any.
+   *  @return false if the rule cannot be parsed
+   */
+  bool parse(const std::string& aRule, const std::vector<std::string>& aActions, std::string& aError);
+  /// Action of the parsed rule
+  const std::string& action() const { return m_action; }
+  /// Conditions of the parsed rule, in their order in the rule
+  const std::vector<Condition>& conditions() const { return m_conditions; }
+  /** Convert the value of a condition to a number.
+   *  @param[in] aCondition Condition.
+   *  @param[in] aUnit Unit of the value.
+   *  @param[out] aNumber Value multiplied by the unit.
+   *  @param[out] aError Description of the error, if any.
+   *  @return false if the value is not a number
+   */
+  bool toNumber(const Condition& aCondition, double aUnit, double& aNumber, std::string& aError) const;
+  /** Convert the list of values of a condition to integers.
+   *  @param[in] aCondition Condition.
+   *  @param[out] aIntegers Values, appended.
+   *  @param[out] aError Description of the error, if any.
+   *  @return false if a value is not an integer
+   */
+  bool toIntegers(const Condition& aCondition, std::vector<int>& aIntegers, std::string& aError) const;
+  /// Description of the error of a condition whose key is not known by the policy
+  std::string unknownCondition(const Condition& aCondition) const;
+  /// Split the comma separated list of values
+  static std::vector<std::string> splitValues(const std::string& aValues);
+
+private:
+  /// Description of the error of a value which is not a number
+  std::string notNumber(const Condition& aCondition, const std::string& aValue) const;
+  /// Definition of the parsed rule
+  std::string m_rule;
+  /// Action of the parsed rule
+  std::string m_action;
+  /// Conditions of the parsed rule
+  std::vector<Condition> m_conditions;
+};
+
+/** @class sim::RegionCondition SimG4Full/SimG4Full/RuleParser.h RuleParser.h
+ *
+ *  Region condition of a rule: the track must be in one of the regions.
+ *  The regions are given by name when the rule is parsed, before they are created. They are found by name at the
+ *  first evaluation, check() reports the names which match no region.
+ */
+class RegionCondition {
+public:
+  /// Set the names of the regions from the comma separated list
+  void setNames(const std::string& aNames) { m_names = RuleParser::splitValues(aNames); }
+  /// Check if the condition is set
+  bool empty() const { return m_names.empty(); }
+  /** Check that the regions exist, to be called once all the regions are created.
+   *  @param[out] aMissing Name of the first missing region, if any.
+   *  @return false if a region does not exist
+   */
+  bool check(std::string& aMissing) const;
+  /** Check if the region is one of the regions of the condition.
+   *  @param[in] aRegion Region (may be nullptr).
+   *  @return true if the region matches
+   */
+  bool contains(const G4Region* aRegion) const;
+
+private:
+  /// Names of the regions
+  std::vector<std::string> m_names;
+  /// Regions, found by name at the first evaluation
+  mutable std::vector<const G4Region*> m_regions;
+};
+} // namespace sim
+
+#endif /* SIMG4FULL_RULEPARSER_H */
@@ -0,0 +1,69 @@
+#ifndef SIMG4FULL_RUSSIANROULETTEPOLICY_H
+#define SIMG4FULL_RUSSIANROULETTEPOLICY_H
+
+// FCCSW
+#include "SimG4Full/RuleParser.h"
+
+// STL
+#include <string>
+#include <vector>
+
+class G4Track;
+
+/** @class sim::RussianRoulettePolicy SimG4Full/SimG4Full/RussianRoulettePolicy.h RussianRoulettePolicy.h
+ *
+ *  Decides which new secondary tracks are killed or played in a Russian roulette.
+ *  The policy is an ordered list of rules, the first rule matching the track decides. Primary particles are never
+ *  affected. A rule is defined by a string made of the action followed by any number of conditions 'key=value'
+ *  (see sim::RuleParser), all of which must be fulfilled.
+ *  Actions: 'kill' (the track is not simulated) and 'roulette' (the track survives with the probability given by the
+ *  mandatory 'probability=p' condition, and its weight is then divided by p).
+ *  Conditions:
+ *   - region: name of the region where the track is created,
+ *   - pdg: PDG code,
+ *   - minEnergy, maxEnergy: kinetic energy (GeV).
+ *  E.g. "kill pdg=2112 maxEnergy=1e-6" or "roulette pdg=22 maxEnergy=1e-3 region=HCalRegion probability=0.1".
+ */
+
+namespace sim {
+class RussianRoulettePolicy {
+public:
+  /** Add a rule, evaluated after the rules added before.
+   *  @param[in] aRule Definition of the rule.
+   *  @param[out] aError Description of the syntax error, if any.
+   *  @return false if the rule cannot be parsed
+   */
+  bool addRule(const std::string& aRule, std::string& aError);
+  /** Check that the regions of the rules exist, to be called once all the regions are created.
+   *  @param[out] aError Description of the first missing region, if any.
+   *  @return false if a region of a rule does not exist
+   */
+  bool checkRegions(std::string& aError) const;
+  /** Get the survival probability of a new track.
+   *  @param[in] aTrack New track.
+   *  @return 1 if the track is not affected, 0 if it is killed, the survival probability of the roulette otherwise
+   */
+  double survivalProbability(const G4Track& aTrack) const;
+  /// Number of rules
+  size_t numRules() const { return m_rules.size(); }
+
+private:
+  /// Single rule, empty lists and non-positive limits are not checked
+  struct Rule {
+    /// Survival probability (0 for the kill rules)
+    double probability = 0;
+    /// Regions where the track is created
+    RegionCondition regions;
+    /// PDG codes
+    std::vector<int> pdgs;
+    /// Minimum kinetic energy
+    double minEnergy = 0;
+    /// Maximum kinetic energy
+    double maxEnergy = 0;
+  };
+  /// Rules, in the order of evaluation
+  std::vector<Rule> m_rules;
+};
+} // namespace sim
+
+#endif /* SIMG4FULL_RUSSIANROULETTEPOLICY_H */
@@ -0,0 +1,140 @@
+#ifndef SIMG4FULL_RUSSIANROULETTESTACKINGACTION_H
+#define SIMG4FULL_RUSSIANROULETTESTACKINGACTION_H
+
+// Geant4
+#include "G4UserStackingAction.hh"
+#include "G4UserSteppingAction.hh"
+
+// FCCSW
+#include "SimG4Full/RussianRoulettePolicy.h"
+
+// STL
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Gaudi
+class MsgStream;
+
+/** @class sim::RussianRouletteSummary SimG4Full/SimG4Full/RussianRouletteStackingAction.h
+ *  RussianRouletteStackingAction.h
+ *
+ *  Counters of the Russian roulette, shared by the actions and printed by the Gaudi tool.
+ *  The counters are updated for every new track, they are not guarded as the run manager is sequential.
+ *  In the validation mode, the energy deposited in the sensitive volumes is summed per event both as simulated and
+ *  weighted by the weights the tracks would have had, to measure the bias and the fluctuations of the roulette.
+ */
+
+namespace sim {
+class RussianRouletteSummary {
+public:
+  /** Count the outcome of the policy for a new track.
+   *  @param[in] aProbability Survival probability given by the policy.
+   *  @param[in] aSurvived Flag set if the track survived.
+   */
+  void countTrack(double aProbability, bool aSurvived);
+  /** Add an energy deposit of the current event (validation mode).
+   *  @param[in] aEnergy Deposited energy.
+   *  @param[in] aWeight Weight of the track which deposited the energy.
+   */
+  void addDeposit(double aEnergy, double aWeight);
+  /// Close the current event (validation mode)
+  void closeEvent();
+  /** Print the summary.
+   *  @param[in] aLog message stream to print to
+   */
+  void print(MsgStream& aLog);
+
+private:
+  /// Number of new secondary tracks matched by a rule
+  uint64_t m_numMatched = 0;
+  /// Number of tracks killed by a kill rule
+  uint64_t m_numKilled = 0;
+  /// Number of tracks killed by the roulette
+  uint64_t m_numRouletteKilled = 0;
+  /// Number of tracks which survived the roulette
+  uint64_t m_numRouletteSurvived = 0;
+  /// Deposited energy of the current event
+  double m_eventEnergy = 0;
+  /// Weighted deposited energy of the current event
+  double m_eventWeightedEnergy = 0;
+  /// Number of closed events with deposited energy
+  uint64_t m_numEvents = 0;
+  /// Sum of the relative differences between weighted and deposited energy per event
+  double m_sumDifference = 0;
+  /// Sum of the squared relative differences between weighted and deposited energy per event
+  double m_sumDifference2 = 0;
+};
+
+/** @class sim::RussianRouletteStackingAction SimG4Full/SimG4Full/RussianRouletteStackingAction.h
+ *  RussianRouletteStackingAction.h
+ *
+ *  User stacking action which applies the kill and Russian roulette policy to the new secondary tracks.
+ *  The survivors of the roulette have their weight divided by the survival probability. Geant4 passes the weight of a
+ *  track to its secondaries. The weights of the tracks differing from 1 are recorded in sim::EventInformation, so that
+ *  the saving tools can weight the deposited energy.
+ *  In the validation mode no track is killed: the weights the tracks would have had are only kept by the action and
+ *  used by sim::RussianRouletteSteppingAction to compare the weighted and the simulated deposited energy.
+ */
+
+class RussianRouletteStackingAction : public G4UserStackingAction {
+public:
+  /** Constructor.
+   *  @param aPolicy Policy deciding which tracks are killed or played in the roulette.
+   *  @param aValidation Flag to run in the validation mode.
+   *  @param aSummary Counters of the roulette.
+   */
+  RussianRouletteStackingAction(const RussianRoulettePolicy& aPolicy, bool aValidation,
+                                std::shared_ptr<RussianRouletteSummary> aSummary);
+  virtual ~RussianRouletteStackingAction() = default;
+  /// Apply the policy to the new track
+  virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* aTrack) final;
+  /// Reset the weights of the validation mode and close the previous event
+  virtual void PrepareNewEvent() final;
+  /** Weight the track would have had (validation mode).
+   *  @param[in] aTrackId Geant4 track ID.
+   *  @return weight
+   */
+  double validationWeight(size_t aTrackId) const {
+    return (aTrackId < m_validationWeights.size()) ? m_validationWeights[aTrackId] : 1.;
+  }
+
+private:
+  /// Policy deciding which tracks are killed or played in the roulette
+  RussianRoulettePolicy m_policy;
+  /// Flag to run in the validation mode
+  bool m_validation;
+  /// Counters of the roulette
+  std::shared_ptr<RussianRouletteSummary> m_summary;
+  /// Weights the tracks would have had in the validation mode, indexed by Geant4 track ID
+  std::vector<double> m_validationWeights;
+};
+
+/** @class sim::RussianRouletteSteppingAction SimG4Full/SimG4Full/RussianRouletteStackingAction.h
+ *  RussianRouletteStackingAction.h
+ *
+ *  User stepping action of the validation mode of the Russian roulette, sums the energy deposited in the sensitive
+ *  volumes, as simulated and weighted by the weights the tracks would have had.
+ */
+
+class RussianRouletteSteppingAction : public G4UserSteppingAction {
+public:
+  /** Constructor.
+   *  @param aStackingAction Stacking action holding the weights of the tracks (not owned).
+   *  @param aSummary Counters of the roulette.
+   */
+  RussianRouletteSteppingAction(const RussianRouletteStackingAction& aStackingAction,
+                                std::shared_ptr<RussianRouletteSummary> aSummary);
+  virtual ~RussianRouletteSteppingAction() = default;
+  /// Add the energy deposited in the step
+  virtual void UserSteppingAction(const G4Step* aStep) final;
+
+private:
+  /// Stacking action holding the weights of the tracks
+  const RussianRouletteStackingAction& m_stackingAction;
+  /// Counters of the roulette
+  std::shared_ptr<RussianRouletteSummary> m_summary;
+};
+} // namespace sim
+
+#endif /* SIMG4FULL_RUSSIANROULETTESTACKINGACTION_H */
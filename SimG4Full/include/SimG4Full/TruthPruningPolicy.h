@@ -0,0 +1,93 @@
+#ifndef SIMG4FULL_TRUTHPRUNINGPOLICY_H
+#define SIMG4FULL_TRUTHPRUNINGPOLICY_H
+
+// FCCSW
+#include "SimG4Full/RuleParser.h"
+
+// STL
+#include <string>
+#include <vector>
+
+class G4Track;
+
+/** @class sim::TruthPruningPolicy SimG4Full/SimG4Full/TruthPruningPolicy.h TruthPruningPolicy.h
+ *
+ *  Decides which tracks are stored in the particle history.
+ *  The policy is an ordered list of rules, the first rule matching the track decides if it is kept or dropped.
+ *  Tracks matching no rule are kept if their total energy at the production vertex is above the energy cut.
+ *  A rule is defined by a string made of the action ('keep' or 'drop') followed by any number of conditions
+ *  'key=value' (see sim::RuleParser), all of which must be fulfilled. Available conditions:
+ *   - region: name of the region of the production vertex,
+ *   - creator: name of the creator process ('primary' for the primary particles),
+ *   - pdg: PDG code,
+ *   - minEnergy, maxEnergy: total energy at the production vertex (GeV),
+ *   - maxR, maxZ: maximum radius and |z| of the production vertex (mm),
+ *   - decayed: true if the track ended with a decay, false otherwise.
+ *  E.g. "keep region=TrackerRegion creator=conv,compt pdg=11,-11" or "drop pdg=12,-12,14,-14,16,-16".
+ *  Tracks are evaluated at the end of their tracking, when their end process is known.
+ *  The regions are found by name at the first evaluation, checkRegions() reports the names which match no region.
+ */
+
+namespace sim {
+class TruthPruningPolicy {
+public:
+  /** Constructor.
+   *  @param aEnergyCut Minimum total energy of the tracks which are not matched by any rule.
+   */
+  explicit TruthPruningPolicy(double aEnergyCut = 0);
+  /** Add a rule, evaluated after the rules added before.
+   *  @param[in] aRule Definition of the rule.
+   *  @param[out] aError Description of the syntax error, if any.
+   *  @return false if the rule cannot be parsed
+   */
+  bool addRule(const std::string& aRule, std::string& aError);
+  /** Check that the regions of the rules exist, to be called once all the regions are created.
+   *  @param[out] aError Description of the first missing region, if any.
+   *  @return false if a region of a rule does not exist
+   */
+  bool checkRegions(std::string& aError) const;
+  /** Decide if the track is kept in the particle history.
+   *  @param[in] aTrack Track at the end of its tracking.
+   *  @return true if the track is kept
+   */
+  bool keep(const G4Track& aTrack) const;
+  /// Number of rules
+  size_t numRules() const { return m_rules.size(); }
+
+private:
+  /// Single rule, empty lists and non-positive limits are not checked
+  struct Rule {
+    /// Action of the rule
+    bool keep = true;
+    /// Regions of the production vertex
+    RegionCondition regions;
+    /// Names of the creator processes
+    std::vector<std::string> creators;
+    /// PDG codes
+    std::vector<int> pdgs;
+    /// Minimum total energy at the production vertex
+    double minEnergy = 0;
+    /// Maximum total energy at the production vertex
+    double maxEnergy = 0;
+    /// Maximum radius of the production vertex
+    double maxR = 0;
+    /// Maximum |z| of the production vertex
+    double maxZ = 0;
+    /// Required end of the track: -1 any, 0 not decayed, 1 decayed
+    int decayed = -1;
+  };
+  /** Check if the track fulfills all the conditions of the rule.
+   *  @param[in] aRule Rule.
+   *  @param[in] aTrack Track at the end of its tracking.
+   *  @param[in] aEnergy Total energy of the track at the production vertex.
+   *  @return true if the rule matches
+   */
+  bool matches(const Rule& aRule, const G4Track& aTrack, double aEnergy) const;
+  /// Rules, in the order of evaluation
+  std::vector<Rule> m_rules;
+  /// Minimum total energy of the tracks not matched by any rule
+  double m_energyCut;
+};
+} // namespace sim
+
+#endif /* SIMG4FULL_TRUTHPRUNINGPOLICY_H */
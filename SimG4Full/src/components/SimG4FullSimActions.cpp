@@ -2,6 +2,13 @@
 
 // FCCSW
 #include "SimG4Full/FullSimActions.h"
+#include "SimG4Full/RussianRouletteStackingAction.h"
+
+// Gaudi
+#include "GaudiKernel/IProperty.h"
+
+// STL
+#include <map>
 
 DECLARE_COMPONENT(SimG4FullSimActions)
 
@@ -16,11 +23,67 @@ StatusCode SimG4FullSimActions::initialize() {
   if (AlgTool::initialize().isFailure()) {
     return StatusCode::FAILURE;
   }
+  m_policy = sim::TruthPruningPolicy(m_energyCut);
+  for (const auto& rule : m_truthRules) {
+    std::string err;
+    if (!m_policy.addRule(rule, err)) {
+      error() << "Invalid particle history rule: " << err << endmsg;
+      return StatusCode::FAILURE;
+    }
+  }
+  m_roulettePolicy = sim::RussianRoulettePolicy();
+  for (const auto& rule : m_rouletteRules) {
+    std::string err;
+    if (!m_roulettePolicy.addRule(rule, err)) {
+      error() << "Invalid Russian roulette rule: " << err << endmsg;
+      return StatusCode::FAILURE;
+    }
+  }
+  if (m_roulettePolicy.numRules() > 0) {
+    m_rouletteSummary = std::make_shared<sim::RussianRouletteSummary>();
+    // the weight of a Geant4 hit is the one of the track which created it, wrong if the hit aggregates several tracks
+    Gaudi::Property<std::map<std::string, std::string>> sensitiveTypes{"sensitiveTypes", {}};
+    auto geoSvc = service<IProperty>("GeoSvc", false);
+    if (!m_rouletteValidation && geoSvc && geoSvc->getProperty(&sensitiveTypes).isSuccess()) {
+      auto calorimeterType = sensitiveTypes.value().find("calorimeter");
+      if (calorimeterType != sensitiveTypes.value().end() &&
+          calorimeterType->second.find("Aggregate") != std::string::npos) {
+        error() << "Russian roulette weights cannot be applied to the calorimeter hits of " << calorimeterType->second
+                << ", which aggregate the deposits of several tracks. Use a sensitive detector creating one hit per "
+                << "step, e.g. SimpleCalorimeterSD." << endmsg;
+        return StatusCode::FAILURE;
+      }
+    }
+  }
   return StatusCode::SUCCESS;
 }
 
-StatusCode SimG4FullSimActions::finalize() { return AlgTool::finalize(); }
+StatusCode SimG4FullSimActions::finalize() {
+  if (m_rouletteSummary) {
+    // events are closed when the next one starts, the last one is closed here
+    m_rouletteSummary->closeEvent();
+    m_rouletteSummary->print(info());
+  }
+  return AlgTool::finalize();
+}
+
+StatusCode SimG4FullSimActions::checkRegions() {
+  std::string err;
+  if (!m_policy.checkRegions(err)) {
+    error() << "Invalid particle history rule: " << err << endmsg;
+    return StatusCode::FAILURE;
+  }
+  if (!m_roulettePolicy.checkRegions(err)) {
+    error() << "Invalid Russian roulette rule: " << err << endmsg;
+    return StatusCode::FAILURE;
+  }
+  return StatusCode::SUCCESS;
+}
 
 G4VUserActionInitialization* SimG4FullSimActions::userActionInitialization() {
-  return new sim::FullSimActions(m_enableHistory, m_energyCut);
+  auto actions = new sim::FullSimActions(m_enableHistory, m_policy, m_keepAncestors);
+  if (m_rouletteSummary) {
+    actions->setRussianRoulette(m_roulettePolicy, m_rouletteValidation, m_rouletteSummary);
+  }
+  return actions;
 }
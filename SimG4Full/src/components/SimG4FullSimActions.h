@@ -5,16 +5,34 @@
 #include "GaudiKernel/AlgTool.h"
 #include "GaudiKernel/SystemOfUnits.h"
 
+// STL
+#include <memory>
+
 // FCCSW
+#include "SimG4Full/RussianRoulettePolicy.h"
+#include "SimG4Full/TruthPruningPolicy.h"
 #include "SimG4Interface/ISimG4ActionTool.h"
 
 /** @class SimG4FullSimActions SimG4Full/src/components/SimG4FullSimActions.h SimG4FullSimActions.h
  *
  *  Tool for loading full simulation user action initialization (list of user actions)
+ *  If the particle history is enabled, the tracks kept in the history are chosen by the rules of '\b truthRules'
+ *  (see sim::TruthPruningPolicy), tracks matching no rule are kept if their energy is above '\b energyCut'.
+ *  By default all the ancestors of the kept particles are kept too ('\b keepAncestors').
+ *  New secondary tracks can be killed or played in a Russian roulette following the rules of '\b rouletteRules'
+ *  (see sim::RussianRoulettePolicy). The survivors of the roulette are weighted, and the weights are applied to the
+ *  energy saved in the calorimeter and tracker hits. The weights are applied per Geant4 hit, hence the roulette is
+ *  rejected if the calorimeter sensitive detectors of GeoSvc aggregate the deposits of several tracks per cell.
+ *  The regions of the rules must exist. With '\b rouletteValidation' no track is killed and the difference between
+ *  the weighted and the simulated energy deposited in the sensitive volumes is printed at finalize.
  *
  *  @author Anna Zaborowska
  */
 
+namespace sim {
+class RussianRouletteSummary;
+}
+
 class SimG4FullSimActions : public AlgTool, virtual public ISimG4ActionTool {
 public:
   explicit SimG4FullSimActions(const std::string& type, const std::string& name, const IInterface* parent);
@@ -32,12 +50,38 @@ public:
    *  @return pointer to G4VUserActionInitialization (ownership is transferred to the caller)
    */
   virtual G4VUserActionInitialization* userActionInitialization() final;
+  /** Check that the regions of the particle history and of the Russian roulette rules exist.
+   *  @return status code
+   */
+  virtual StatusCode checkRegions() final;
 
 private:
   /// Set to true to save secondary particle info
   Gaudi::Property<bool> m_enableHistory{this, "enableHistory", false, "Set to true to save secondary particle info"};
   Gaudi::Property<double> m_energyCut{this, "energyCut", 0.0 * Gaudi::Units::GeV,
                                       "minimum energy for secondaries to be saved"};
+  /// Rules of the particle history pruning, the first matching rule decides
+  Gaudi::Property<std::vector<std::string>> m_truthRules{
+      this, "truthRules", {}, "Rules of the particle history pruning, e.g. 'keep region=TrackerRegion pdg=11,-11'"};
+  /// Flag to keep all the ancestors of the kept particles
+  Gaudi::Property<bool> m_keepAncestors{this, "keepAncestors", true,
+                                        "Keep all the ancestors of the particles saved in the history"};
+  /// Policy deciding which tracks are kept in the history, built from the rules at initialization
+  sim::TruthPruningPolicy m_policy;
+  /// Rules of the kill and Russian roulette of the secondary tracks, the first matching rule decides
+  Gaudi::Property<std::vector<std::string>> m_rouletteRules{
+      this,
+      "rouletteRules",
+      {},
+      "Rules of the kill and Russian roulette, e.g. 'roulette pdg=2112 maxEnergy=1e-3 probability=0.1'"};
+  /// Flag to measure the effect of the roulette without killing any track
+  Gaudi::Property<bool> m_rouletteValidation{
+      this, "rouletteValidation", false,
+      "Measure the effect of the roulette on the deposited energy, without killing any track"};
+  /// Policy deciding which tracks are killed or played in the roulette, built from the rules at initialization
+  sim::RussianRoulettePolicy m_roulettePolicy;
+  /// Counters of the roulette, shared with the actions
+  std::shared_ptr<sim::RussianRouletteSummary> m_rouletteSummary;
 };
 
 #endif /* SIMG4FULL_G4FULLSIMACTIONS_H */
@@ -2,10 +2,11 @@
 
 // FCCSW
 // #include "SimG4Fast/FastSimModelTracker.h"
+#include "SimG4Common/VolumeSelector.h"
 
 // Geant4
+#include "G4LogicalVolume.hh"
 #include "G4RegionStore.hh"
-#include "G4TransportationManager.hh"
 
 // #include "G4VFastSimulationModel.hh"
 
@@ -42,41 +43,22 @@ StatusCode SimG4FullSimDCHRegion::finalize() {
 StatusCode SimG4FullSimDCHRegion::create() {
   std::cout << "nalipourTest: SimG4FullSimDCHRegion ---> create" << std::endl;
 
-  G4LogicalVolume* world =
-      (*G4TransportationManager::GetTransportationManager()->GetWorldsIterator())->GetLogicalVolume();
   for (const auto& trackerName : m_volumeNames) {
-    for (size_t iter_region = 0; iter_region < world->GetNoDaughters(); ++iter_region) {
-      if (world->GetDaughter(iter_region)->GetName().find(trackerName) != std::string::npos) {
-
-        /// all G4Region objects are deleted by the G4RegionStore
-
-        // std::cout << "NoDaughters=" << world->GetDaughter(iter_region)->GetLogicalVolume()->GetNoDaughters() <<
-        // std::endl; // ok
-        m_g4regions.emplace_back(
-            new G4Region(world->GetDaughter(iter_region)->GetLogicalVolume()->GetName() + "_fullsim"));
-        m_g4regions.back()->AddRootLogicalVolume(world->GetDaughter(iter_region)->GetLogicalVolume());
-        std::cout << "m_maxStepLength=" << m_maxStepLength << std::endl;
-        // auto fStepLimit = new G4UserLimits();
-
-        m_g4regions.back()->SetUserLimits(fStepLimit);
-
-        info() << "Attaching a Tracker fast simulation model to the region " << m_g4regions.back()->GetName() << endmsg;
-        /*
-        int numDaughters=world->GetDaughter(iter_region)->GetLogicalVolume()->GetNoDaughters();
-        for (auto i = 0; i<numDaughters; ++i)
-          {
-            auto
-        daug=world->GetDaughter(iter_region)->GetLogicalVolume()->GetDaughter(i)->GetLogicalVolume()->IsRegion(); auto
-        namedaugRegion =
-        world->GetDaughter(iter_region)->GetLogicalVolume()->GetDaughter(i)->GetLogicalVolume()->GetRegion()->GetName();
-            auto daughterName = world->GetDaughter(iter_region)->GetLogicalVolume()->GetDaughter(i)->GetName();
-            auto d_region=
-        world->GetDaughter(iter_region)->GetLogicalVolume()->GetDaughter(i)->GetLogicalVolume()->GetRegion(); auto d_cut
-        = d_region->GetUserLimits(); std::cout << i << "------------- daug=" << daug << ", regionName=" <<
-        namedaugRegion << ", daughterName=" << daughterName<< std::endl; std::cout << "cut=" << d_cut << std::endl;
-          }
-        */
-      }
+    std::vector<G4LogicalVolume*> volumes;
+    std::string selectionError;
+    if (!sim::VolumeSelector::geometry().select(trackerName, volumes, selectionError)) {
+      error() << selectionError << endmsg;
+      return StatusCode::FAILURE;
+    }
+    for (auto* volume : volumes) {
+      /// all G4Region objects are deleted by the G4RegionStore
+      m_g4regions.emplace_back(new G4Region(volume->GetName() + "_fullsim"));
+      m_g4regions.back()->AddRootLogicalVolume(volume);
+      debug() << "Maximum step length in the region " << m_g4regions.back()->GetName() << ": " << m_maxStepLength
+              << endmsg;
+      m_g4regions.back()->SetUserLimits(fStepLimit);
+
+      info() << "Attaching a Tracker fast simulation model to the region " << m_g4regions.back()->GetName() << endmsg;
     }
   }
 
@@ -0,0 +1,125 @@
+#include "SimG4ProductionCutsRegion.h"
+
+// FCCSW
+#include "SimG4Common/VolumeSelector.h"
+
+// Geant4
+#include "G4LogicalVolume.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4TransportationManager.hh"
+
+#include "GaudiKernel/SystemOfUnits.h"
+
+// STL
+#include <algorithm>
+
+DECLARE_COMPONENT(SimG4ProductionCutsRegion)
+
+SimG4ProductionCutsRegion::SimG4ProductionCutsRegion(const std::string& type, const std::string& name,
+                                                     const IInterface* parent)
+    : AlgTool(type, name, parent) {
+  declareInterface<ISimG4RegionTool>(this);
+}
+
+SimG4ProductionCutsRegion::~SimG4ProductionCutsRegion() {}
+
+StatusCode SimG4ProductionCutsRegion::initialize() {
+  if (AlgTool::initialize().isFailure()) {
+    return StatusCode::FAILURE;
+  }
+  if (m_volumeNames.size() == 0) {
+    error() << "No detector name is specified for the production cuts" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  if (m_gammaCut < 0 || m_electronCut < 0 || m_positronCut < 0 || m_protonCut < 0) {
+    error() << "Production cuts cannot be negative" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  return StatusCode::SUCCESS;
+}
+
+StatusCode SimG4ProductionCutsRegion::finalize() {
+  if (!m_counters.empty()) {
+    info() << "Secondaries produced in the regions with production cuts:" << endmsg;
+    for (const auto& counter : m_counters) {
+      counter->print(info());
+    }
+  }
+  return AlgTool::finalize();
+}
+
+StatusCode SimG4ProductionCutsRegion::create() {
+  G4LogicalVolume* world =
+      (*G4TransportationManager::GetTransportationManager()->GetWorldsIterator())->GetLogicalVolume();
+  // (a) if user specifies world, set the cuts of the default region
+  if (std::find(m_volumeNames.begin(), m_volumeNames.end(), "world") != m_volumeNames.end()) {
+    G4Region* region = world->GetRegion();
+    if (region == nullptr) {
+      error() << "World volume does not belong to any region" << endmsg;
+      return StatusCode::FAILURE;
+    }
+    m_g4regions.push_back(region);
+    return setCuts(*region);
+  }
+  // (b) if individual volumes are selected, set the cuts for them
+  for (const auto& volumeName : m_volumeNames) {
+    std::vector<G4LogicalVolume*> volumes;
+    std::string selectionError;
+    if (!sim::VolumeSelector::geometry().select(volumeName, volumes, selectionError)) {
+      error() << selectionError << endmsg;
+      return StatusCode::FAILURE;
+    }
+    if (volumes.empty()) {
+      error() << "No volume was found for " << volumeName << endmsg;
+      return StatusCode::FAILURE;
+    }
+    for (auto* volume : volumes) {
+      G4Region* region = nullptr;
+      if (volume->IsRootRegion() && volume->GetRegion() != nullptr) {
+        // a logical volume can be the root of only one region
+        region = volume->GetRegion();
+        info() << "Setting production cuts in the existing region " << region->GetName() << endmsg;
+      } else {
+        /// all G4Region objects are deleted by the G4RegionStore
+        region = new G4Region(volume->GetName() + "_productionCuts");
+        region->AddRootLogicalVolume(volume);
+        info() << "Creating production cuts in the region " << region->GetName() << endmsg;
+      }
+      if (std::find(m_g4regions.begin(), m_g4regions.end(), region) != m_g4regions.end()) {
+        continue;
+      }
+      m_g4regions.push_back(region);
+      if (setCuts(*region).isFailure()) {
+        return StatusCode::FAILURE;
+      }
+    }
+  }
+  return StatusCode::SUCCESS;
+}
+
+StatusCode SimG4ProductionCutsRegion::setCuts(G4Region& aRegion) {
+  G4ProductionCuts* cuts = aRegion.GetProductionCuts();
+  if (cuts == nullptr) {
+    m_productionCuts.emplace_back(new G4ProductionCuts());
+    cuts = m_productionCuts.back().get();
+    aRegion.SetProductionCuts(cuts);
+  }
+  cuts->SetProductionCut(m_gammaCut / Gaudi::Units::mm * CLHEP::mm, "gamma");
+  cuts->SetProductionCut(m_electronCut / Gaudi::Units::mm * CLHEP::mm, "e-");
+  cuts->SetProductionCut(m_positronCut / Gaudi::Units::mm * CLHEP::mm, "e+");
+  cuts->SetProductionCut(m_protonCut / Gaudi::Units::mm * CLHEP::mm, "proton");
+  debug() << "Production cuts in the region " << aRegion.GetName() << ": gamma " << m_gammaCut << " mm, e- "
+          << m_electronCut << " mm, e+ " << m_positronCut << " mm, proton " << m_protonCut << " mm" << endmsg;
+  if (!m_countSecondaries) {
+    return StatusCode::SUCCESS;
+  }
+  if (aRegion.GetRegionalSteppingAction() != nullptr) {
+    warning() << "Region " << aRegion.GetName()
+              << " already has a regional stepping action, secondaries are not counted" << endmsg;
+    return StatusCode::SUCCESS;
+  }
+  m_counters.emplace_back(new sim::RegionSecondaryCounter(aRegion.GetName()));
+  aRegion.SetRegionalSteppingAction(m_counters.back().get());
+  return StatusCode::SUCCESS;
+}
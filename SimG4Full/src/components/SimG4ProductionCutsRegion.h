@@ -0,0 +1,74 @@
+#ifndef SIMG4FULL_SIMG4PRODUCTIONCUTSREGION_H
+#define SIMG4FULL_SIMG4PRODUCTIONCUTSREGION_H
+
+// Gaudi
+#include "GaudiKernel/AlgTool.h"
+
+// FCCSW
+#include "SimG4Full/RegionSecondaryCounter.h"
+#include "SimG4Interface/ISimG4RegionTool.h"
+
+// Geant
+#include "G4ProductionCuts.hh"
+class G4Region;
+
+// STL
+#include <memory>
+#include <vector>
+
+/** @class SimG4ProductionCutsRegion SimG4Full/src/components/SimG4ProductionCutsRegion.h SimG4ProductionCutsRegion.h
+ *
+ *  Tool for creating regions with their own production cuts of gamma, e-, e+ and proton.
+ *  A region is created for each volume selected by the volume names (see sim::VolumeSelector).
+ *  If the volume is already the root of a region (e.g. created by another region tool listed before), the cuts are
+ *  set in that region. If the world is specified, the cuts of the default region are changed.
+ *  Optionally the steps and the secondaries produced in each region are counted and printed at the end of the job,
+ *  so that coarse cuts can be set in the passive material and fine cuts in the sensitive layers.
+ */
+
+class SimG4ProductionCutsRegion : public AlgTool, virtual public ISimG4RegionTool {
+public:
+  explicit SimG4ProductionCutsRegion(const std::string& type, const std::string& name, const IInterface* parent);
+  virtual ~SimG4ProductionCutsRegion();
+  /**  Initialize.
+   *   @return status code
+   */
+  virtual StatusCode initialize() final;
+  /**  Finalize, printing the secondaries produced in the regions.
+   *   @return status code
+   */
+  virtual StatusCode finalize() final;
+  /**  Create regions and set their production cuts
+   *   @return status code
+   */
+  virtual StatusCode create() final;
+
+private:
+  /**  Set the production cuts of the region and attach the secondary counter.
+   *   @param[in] aRegion Region.
+   *   @return status code
+   */
+  StatusCode setCuts(G4Region& aRegion);
+  /// Regions with production cuts
+  /// deleted by the G4RegionStore
+  std::vector<G4Region*> m_g4regions;
+  /// Production cuts, not owned by the regions
+  std::vector<std::unique_ptr<G4ProductionCuts>> m_productionCuts;
+  /// Counters of the secondaries produced in the regions, not owned by the regions
+  std::vector<std::unique_ptr<sim::RegionSecondaryCounter>> m_counters;
+  /// Names of the volumes where production cuts should be set (set by job options)
+  Gaudi::Property<std::vector<std::string>> m_volumeNames{this, "volumeNames", {}, "Names of the volumes"};
+  /// Production cut (range) of gamma (set by job options)
+  Gaudi::Property<double> m_gammaCut{this, "gammaCut", 0.7, "Production cut of gamma [mm]"};
+  /// Production cut (range) of e- (set by job options)
+  Gaudi::Property<double> m_electronCut{this, "electronCut", 0.7, "Production cut of e- [mm]"};
+  /// Production cut (range) of e+ (set by job options)
+  Gaudi::Property<double> m_positronCut{this, "positronCut", 0.7, "Production cut of e+ [mm]"};
+  /// Production cut (range) of proton (set by job options)
+  Gaudi::Property<double> m_protonCut{this, "protonCut", 0.7, "Production cut of proton [mm]"};
+  /// Flag to count the steps and secondaries produced in the regions (set by job options)
+  Gaudi::Property<bool> m_countSecondaries{this, "countSecondaries", true,
+                                           "Count the secondaries produced in the regions and print them at the end"};
+};
+
+#endif /* SIMG4FULL_SIMG4PRODUCTIONCUTSREGION_H */
@@ -1,5 +1,8 @@
 #include "SimG4UserLimitRegion.h"
 
+// FCCSW
+#include "SimG4Common/VolumeSelector.h"
+
 // Geant4
 #include "G4LogicalVolume.hh"
 #include "G4RegionStore.hh"
@@ -41,27 +44,32 @@ StatusCode SimG4UserLimitRegion::create() {
                          m_minRange / Gaudi::Units::mm * CLHEP::mm));
     world->SetUserLimits(m_userLimits.back().get());
     info() << "Creating user limits for world" << endmsg;
-    // (b) if individiual volumenames are specified, try to find them and set limits for them.
+    // (b) if individiual volumes are selected, set limits for them.
   } else {
+    // volumes selected by several names get only one region
+    std::vector<G4LogicalVolume*> volumes;
     for (const auto& volumeName : m_volumeNames) {
-      for (size_t iter_region = 0; iter_region < world->GetNoDaughters(); ++iter_region) {
-        if (world->GetDaughter(iter_region)->GetName().find(volumeName) != std::string::npos) {
-          /// all G4Region objects are deleted by the G4RegionStore
-          m_g4regions.emplace_back(
-              new G4Region(world->GetDaughter(iter_region)->GetLogicalVolume()->GetName() + "_userLimits"));
-          m_g4regions.back()->AddRootLogicalVolume(world->GetDaughter(iter_region)->GetLogicalVolume());
-          m_userLimits.emplace_back(new G4UserLimits(
-              m_maxStep / Gaudi::Units::mm * CLHEP::mm, m_maxTrack / Gaudi::Units::mm * CLHEP::mm,
-              m_maxTime / Gaudi::Units::s * CLHEP::s, m_minKineticEnergy / Gaudi::Units::MeV * CLHEP::MeV,
-              m_minRange / Gaudi::Units::mm * CLHEP::mm));
-          m_g4regions.back()->SetUserLimits(m_userLimits.back().get());
-          info() << "Creating user limits in the region " << m_g4regions.back()->GetName() << endmsg;
-        }
+      size_t numSelected = volumes.size();
+      std::string selectionError;
+      if (!sim::VolumeSelector::geometry().select(volumeName, volumes, selectionError)) {
+        error() << selectionError << endmsg;
+        return StatusCode::FAILURE;
+      }
+      if (volumes.size() == numSelected) {
+        error() << "No new volume was found for " << volumeName << endmsg;
+        return StatusCode::FAILURE;
       }
     }
-    if (m_g4regions.size() != m_volumeNames.size()) {
-      error() << "Regions  were not created for all the volumes" << endmsg;
-      return StatusCode::FAILURE;
+    for (auto* volume : volumes) {
+      /// all G4Region objects are deleted by the G4RegionStore
+      m_g4regions.emplace_back(new G4Region(volume->GetName() + "_userLimits"));
+      m_g4regions.back()->AddRootLogicalVolume(volume);
+      m_userLimits.emplace_back(
+          new G4UserLimits(m_maxStep / Gaudi::Units::mm * CLHEP::mm, m_maxTrack / Gaudi::Units::mm * CLHEP::mm,
+                           m_maxTime / Gaudi::Units::s * CLHEP::s, m_minKineticEnergy / Gaudi::Units::MeV * CLHEP::MeV,
+                           m_minRange / Gaudi::Units::mm * CLHEP::mm));
+      m_g4regions.back()->SetUserLimits(m_userLimits.back().get());
+      info() << "Creating user limits in the region " << m_g4regions.back()->GetName() << endmsg;
     }
   }
   return StatusCode::SUCCESS;
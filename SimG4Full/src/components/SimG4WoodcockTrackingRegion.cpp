@@ -0,0 +1,84 @@
+#include "SimG4WoodcockTrackingRegion.h"
+
+// FCCSW
+#include "SimG4Common/VolumeSelector.h"
+
+// Geant4
+#include "G4EmParameters.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4Version.hh"
+
+DECLARE_COMPONENT(SimG4WoodcockTrackingRegion)
+
+SimG4WoodcockTrackingRegion::SimG4WoodcockTrackingRegion(const std::string& type, const std::string& name,
+                                                         const IInterface* parent)
+    : AlgTool(type, name, parent) {
+  declareInterface<ISimG4RegionTool>(this);
+}
+
+SimG4WoodcockTrackingRegion::~SimG4WoodcockTrackingRegion() {}
+
+StatusCode SimG4WoodcockTrackingRegion::initialize() {
+  if (AlgTool::initialize().isFailure()) {
+    return StatusCode::FAILURE;
+  }
+  if (m_volumeNames.size() == 0) {
+    error() << "No detector name is specified for the Woodcock tracking" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  if (m_regionName.value().empty()) {
+    error() << "No name is specified for the Woodcock tracking region" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  return StatusCode::SUCCESS;
+}
+
+StatusCode SimG4WoodcockTrackingRegion::finalize() { return AlgTool::finalize(); }
+
+StatusCode SimG4WoodcockTrackingRegion::create() {
+#if G4VERSION_NUMBER < 1110
+  error() << "Woodcock tracking of the photons requires Geant4 11.1 or newer" << endmsg;
+  return StatusCode::FAILURE;
+#else
+  G4EmParameters* emParameters = G4EmParameters::Instance();
+  if (!emParameters->GeneralProcessActive()) {
+    error() << "Woodcock tracking of the photons requires the gamma general process, add "
+            << "'/process/em/UseGeneralProcess true' to the g4PreInitCommands of SimG4Svc" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  if (G4RegionStore::GetInstance()->GetRegion(m_regionName, false) != nullptr) {
+    error() << "Region " << m_regionName << " already exists" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  std::vector<G4LogicalVolume*> volumes;
+  for (const auto& volumeName : m_volumeNames) {
+    std::string selectionError;
+    if (!sim::VolumeSelector::geometry().select(volumeName, volumes, selectionError)) {
+      error() << selectionError << endmsg;
+      return StatusCode::FAILURE;
+    }
+  }
+  if (volumes.empty()) {
+    error() << "No volume was found for the Woodcock tracking" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  /// all G4Region objects are deleted by the G4RegionStore
+  m_g4region = new G4Region(m_regionName);
+  for (auto* volume : volumes) {
+    if (volume->IsRootRegion()) {
+      error() << "Volume " << volume->GetName() << " is already the root of the region "
+              << volume->GetRegion()->GetName() << endmsg;
+      return StatusCode::FAILURE;
+    }
+    m_g4region->AddRootLogicalVolume(volume);
+    debug() << "Adding volume " << volume->GetName() << " to the region " << m_regionName << endmsg;
+  }
+  // read by the gamma general process when the physics tables are built, at the start of the run
+  emParameters->SetWoodcockActiveRegion(m_regionName);
+  info() << "Photons are tracked with Woodcock tracking in the region " << m_regionName << " ("
+         << volumes.size() << " root volumes)" << endmsg;
+  return StatusCode::SUCCESS;
+#endif
+}
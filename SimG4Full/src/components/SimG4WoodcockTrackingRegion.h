@@ -0,0 +1,55 @@
+#ifndef SIMG4FULL_SIMG4WOODCOCKTRACKINGREGION_H
+#define SIMG4FULL_SIMG4WOODCOCKTRACKINGREGION_H
+
+// Gaudi
+#include "GaudiKernel/AlgTool.h"
+
+// FCCSW
+#include "SimG4Interface/ISimG4RegionTool.h"
+
+// Geant
+class G4Region;
+
+/** @class SimG4WoodcockTrackingRegion SimG4Full/src/components/SimG4WoodcockTrackingRegion.h
+ *  SimG4WoodcockTrackingRegion.h
+ *
+ *  Tool for creating a region where the photons are transported with Woodcock (delta) tracking.
+ *  Inside the region the photons are not stopped at the volume boundaries: their steps are sampled from the cross
+ *  section of the densest material of the region, and the interaction is accepted with the ratio of the cross section
+ *  of the actual material to that maximal one. This saves the boundary navigation of the photons in calorimeters made
+ *  of many thin layers.
+ *  The region is one G4Region, with all the selected volumes (see sim::VolumeSelector) as root volumes, given to the
+ *  Geant4 gamma general process (G4EmParameters::SetWoodcockActiveRegion, Geant4 11.1 or newer). The general process
+ *  must be active, e.g. with '/process/em/UseGeneralProcess true' in the pre-initialisation commands of SimG4Svc.
+ *  The selected volumes should be calorimeter envelopes: the method is efficient if the densest material dominates.
+ */
+
+class SimG4WoodcockTrackingRegion : public AlgTool, virtual public ISimG4RegionTool {
+public:
+  explicit SimG4WoodcockTrackingRegion(const std::string& type, const std::string& name, const IInterface* parent);
+  virtual ~SimG4WoodcockTrackingRegion();
+  /**  Initialize.
+   *   @return status code
+   */
+  virtual StatusCode initialize() final;
+  /**  Finalize.
+   *   @return status code
+   */
+  virtual StatusCode finalize() final;
+  /**  Create the region and enable Woodcock tracking of the photons in it
+   *   @return status code
+   */
+  virtual StatusCode create() final;
+
+private:
+  /// Region with Woodcock tracking
+  /// deleted by the G4RegionStore
+  G4Region* m_g4region = nullptr;
+  /// Names of the calorimeter envelopes (set by job options)
+  Gaudi::Property<std::vector<std::string>> m_volumeNames{this, "volumeNames", {}, "Names of the volumes"};
+  /// Name of the created region (set by job options)
+  Gaudi::Property<std::string> m_regionName{this, "regionName", "WoodcockTracking",
+                                            "Name of the region with Woodcock tracking of the photons"};
+};
+
+#endif /* SIMG4FULL_SIMG4WOODCOCKTRACKINGREGION_H */
@@ -1,18 +1,37 @@
 #include "SimG4Full/FullSimActions.h"
 #include "SimG4Full/ParticleHistoryAction.h"
 #include "SimG4Full/ParticleHistoryEventAction.h"
+#include "SimG4Full/RussianRouletteStackingAction.h"
 #include <iostream>
 
 namespace sim {
-FullSimActions::FullSimActions(bool enableHistory, double aEnergyCut)
-    : G4VUserActionInitialization(), m_enableHistory(enableHistory), m_energyCut(aEnergyCut) {}
+FullSimActions::FullSimActions(bool enableHistory, const TruthPruningPolicy& aPolicy, bool aKeepAncestors)
+    : G4VUserActionInitialization(), m_enableHistory(enableHistory), m_policy(aPolicy),
+      m_keepAncestors(aKeepAncestors) {}
 
 FullSimActions::~FullSimActions() {}
 
+void FullSimActions::setRussianRoulette(const RussianRoulettePolicy& aPolicy, bool aValidation,
+                                        std::shared_ptr<RussianRouletteSummary> aSummary) {
+  m_roulettePolicy = aPolicy;
+  m_rouletteValidation = aValidation;
+  m_rouletteSummary = aSummary;
+}
+
 void FullSimActions::Build() const {
+  // the event information also holds the weights of the tracks surviving the roulette
+  if (m_enableHistory || m_rouletteSummary) {
+    SetUserAction(new ParticleHistoryEventAction(m_keepAncestors));
+  }
   if (m_enableHistory) {
-    SetUserAction(new ParticleHistoryEventAction());
-    SetUserAction(new ParticleHistoryAction(m_energyCut));
+    SetUserAction(new ParticleHistoryAction(m_policy));
+  }
+  if (m_rouletteSummary) {
+    auto stackingAction = new RussianRouletteStackingAction(m_roulettePolicy, m_rouletteValidation, m_rouletteSummary);
+    SetUserAction(stackingAction);
+    if (m_rouletteValidation) {
+      SetUserAction(new RussianRouletteSteppingAction(*stackingAction, m_rouletteSummary));
+    }
   }
 }
 } // namespace sim
@@ -3,29 +3,17 @@
 #include "SimG4Common/EventInformation.h"
 
 #include "G4EventManager.hh"
-#include "G4LorentzVector.hh"
 
 namespace sim {
 
-ParticleHistoryAction::ParticleHistoryAction(double aEnergyCut) : m_energyCut(aEnergyCut) {}
+ParticleHistoryAction::ParticleHistoryAction(const TruthPruningPolicy& aPolicy) : m_policy(aPolicy) {}
 
-void ParticleHistoryAction::PreUserTrackingAction(const G4Track* aTrack) {
+void ParticleHistoryAction::PreUserTrackingAction(const G4Track* /*aTrack*/) {}
+
+void ParticleHistoryAction::PostUserTrackingAction(const G4Track* aTrack) {
   auto g4EvtMgr = G4EventManager::GetEventManager();
   auto evtinfo = dynamic_cast<sim::EventInformation*>(g4EvtMgr->GetUserInformation());
-  G4LorentzVector prodPos(aTrack->GetGlobalTime() - aTrack->GetLocalTime(), aTrack->GetVertexPosition());
-  G4LorentzVector endPos(aTrack->GetGlobalTime(), aTrack->GetPosition());
-  if (selectSecondary(*aTrack, m_energyCut)) {
-    evtinfo->addParticle(aTrack);
-  }
-}
-
-void ParticleHistoryAction::PostUserTrackingAction(const G4Track* /*aTrack*/) {}
-
-bool ParticleHistoryAction::selectSecondary(const G4Track& aTrack, double aEnergyCut) {
-  G4LorentzVector p4(aTrack.GetMomentum(), aTrack.GetTotalEnergy());
-  if (p4.e() < aEnergyCut) {
-    return false;
-  }
-  return true;
+  // all tracks are recorded, so that the rejected ones can still be kept as ancestors of the kept particles
+  evtinfo->addTrack(aTrack, m_policy.keep(*aTrack));
 }
 } // namespace sim
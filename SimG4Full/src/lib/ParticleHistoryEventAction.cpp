@@ -8,11 +8,11 @@
 
 namespace sim {
 
-ParticleHistoryEventAction::ParticleHistoryEventAction() {}
+ParticleHistoryEventAction::ParticleHistoryEventAction(bool aKeepAncestors) : m_keepAncestors(aKeepAncestors) {}
 
 void ParticleHistoryEventAction::BeginOfEventAction(const G4Event* /*anEvent*/) {
 
-  auto eventInfo = new sim::EventInformation();
+  auto eventInfo = new sim::EventInformation(m_keepAncestors);
   G4EventManager::GetEventManager()->SetUserInformation(eventInfo);
 }
 
@@ -0,0 +1,54 @@
+#include "SimG4Full/RegionSecondaryCounter.h"
+
+// Gaudi
+#include "GaudiKernel/MsgStream.h"
+
+// Geant4
+#include "G4Electron.hh"
+#include "G4Gamma.hh"
+#include "G4Positron.hh"
+#include "G4Proton.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+
+namespace sim {
+RegionSecondaryCounter::RegionSecondaryCounter(const std::string& aRegionName) : m_regionName(aRegionName) {}
+
+void RegionSecondaryCounter::UserSteppingAction(const G4Step* aStep) {
+  m_numSteps.fetch_add(1, std::memory_order_relaxed);
+  const auto* secondaries = aStep->GetSecondaryInCurrentStep();
+  if (secondaries == nullptr) {
+    return;
+  }
+  static const G4ParticleDefinition* gamma = G4Gamma::Definition();
+  static const G4ParticleDefinition* electron = G4Electron::Definition();
+  static const G4ParticleDefinition* positron = G4Positron::Definition();
+  static const G4ParticleDefinition* proton = G4Proton::Definition();
+  for (const auto* track : *secondaries) {
+    const G4ParticleDefinition* particle = track->GetDefinition();
+    Species species = kOther;
+    if (particle == gamma) {
+      species = kGamma;
+    } else if (particle == electron) {
+      species = kElectron;
+    } else if (particle == positron) {
+      species = kPositron;
+    } else if (particle == proton) {
+      species = kProton;
+    }
+    m_numSecondaries[species].fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void RegionSecondaryCounter::print(MsgStream& aLog) const {
+  uint64_t total = 0;
+  for (const auto& count : m_numSecondaries) {
+    total += count.load();
+  }
+  aLog << MSG::INFO << "Region " << m_regionName << ": " << m_numSteps.load() << " steps, " << total
+       << " secondaries (gamma: " << m_numSecondaries[kGamma].load()
+       << ", e-: " << m_numSecondaries[kElectron].load() << ", e+: " << m_numSecondaries[kPositron].load()
+       << ", proton: " << m_numSecondaries[kProton].load() << ", other: " << m_numSecondaries[kOther].load() << ")"
+       << endmsg;
+}
+} // namespace sim
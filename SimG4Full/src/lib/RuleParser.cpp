@@ -0,0 +1,105 @@
+#include "SimG4Full/RuleParser.h"
+
+// Geant4
+#include "G4RegionStore.hh"
+
+// STL
+#include <algorithm>
+#include <sstream>
+
+namespace sim {
+bool RuleParser::parse(const std::string& aRule, const std::vector<std::string>& aActions, std::string& aError) {
+  m_rule = aRule;
+  m_action.clear();
+  m_conditions.clear();
+  std::stringstream stream(aRule);
+  std::string token;
+  if (!(stream >> token) || std::find(aActions.begin(), aActions.end(), token) == aActions.end()) {
+    std::string actions;
+    for (size_t iAction = 0; iAction < aActions.size(); ++iAction) {
+      actions += (iAction == 0 ? "'" : (iAction + 1 == aActions.size() ? " or '" : ", '")) + aActions[iAction] + "'";
+    }
+    aError = "rule '" + aRule + "' does not start with " + actions;
+    return false;
+  }
+  m_action = token;
+  while (stream >> token) {
+    auto separator = token.find('=');
+    if (separator == 0 || separator == std::string::npos || separator + 1 == token.size()) {
+      aError = "condition '" + token + "' of rule '" + aRule + "' is not of the form key=value";
+      return false;
+    }
+    m_conditions.emplace_back(token.substr(0, separator), token.substr(separator + 1));
+  }
+  return true;
+}
+
+bool RuleParser::toNumber(const Condition& aCondition, double aUnit, double& aNumber, std::string& aError) const {
+  size_t length = 0;
+  try {
+    aNumber = std::stod(aCondition.second, &length) * aUnit;
+  } catch (const std::exception&) {
+    length = 0;
+  }
+  if (length != aCondition.second.size()) {
+    aError = notNumber(aCondition, aCondition.second);
+    return false;
+  }
+  return true;
+}
+
+bool RuleParser::toIntegers(const Condition& aCondition, std::vector<int>& aIntegers, std::string& aError) const {
+  for (const auto& value : splitValues(aCondition.second)) {
+    size_t length = 0;
+    try {
+      aIntegers.push_back(std::stoi(value, &length));
+    } catch (const std::exception&) {
+      length = 0;
+    }
+    if (length != value.size()) {
+      aError = notNumber(aCondition, value);
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string RuleParser::unknownCondition(const Condition& aCondition) const {
+  return "unknown condition '" + aCondition.first + "' in rule '" + m_rule + "'";
+}
+
+std::string RuleParser::notNumber(const Condition& aCondition, const std::string& aValue) const {
+  return "value '" + aValue + "' of condition '" + aCondition.first + "' in rule '" + m_rule + "' is not a number";
+}
+
+std::vector<std::string> RuleParser::splitValues(const std::string& aValues) {
+  std::vector<std::string> values;
+  std::stringstream stream(aValues);
+  std::string value;
+  while (std::getline(stream, value, ',')) {
+    if (!value.empty()) {
+      values.push_back(value);
+    }
+  }
+  return values;
+}
+
+bool RegionCondition::check(std::string& aMissing) const {
+  for (const auto& name : m_names) {
+    if (G4RegionStore::GetInstance()->GetRegion(name, false) == nullptr) {
+      aMissing = name;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool RegionCondition::contains(const G4Region* aRegion) const {
+  if (m_regions.empty()) {
+    for (const auto& name : m_names) {
+      m_regions.push_back(G4RegionStore::GetInstance()->GetRegion(name, false));
+    }
+  }
+  return aRegion != nullptr && std::find(m_regions.begin(), m_regions.end(), aRegion) != m_regions.end();
+}
+} // namespace sim
@@ -0,0 +1,85 @@
+#include "SimG4Full/RussianRoulettePolicy.h"
+
+// Geant4
+#include "G4LogicalVolume.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Track.hh"
+#include "G4VPhysicalVolume.hh"
+
+// STL
+#include <algorithm>
+
+namespace sim {
+bool RussianRoulettePolicy::addRule(const std::string& aRule, std::string& aError) {
+  RuleParser parser;
+  if (!parser.parse(aRule, {"kill", "roulette"}, aError)) {
+    return false;
+  }
+  Rule rule;
+  const bool roulette = (parser.action() == "roulette");
+  rule.probability = roulette ? -1 : 0;
+  for (const auto& condition : parser.conditions()) {
+    const auto& [key, value] = condition;
+    bool valid = true;
+    if (key == "region") {
+      rule.regions.setNames(value);
+    } else if (key == "pdg") {
+      valid = parser.toIntegers(condition, rule.pdgs, aError);
+    } else if (key == "minEnergy") {
+      valid = parser.toNumber(condition, GeV, rule.minEnergy, aError);
+    } else if (key == "maxEnergy") {
+      valid = parser.toNumber(condition, GeV, rule.maxEnergy, aError);
+    } else if (key == "probability" && roulette) {
+      valid = parser.toNumber(condition, 1, rule.probability, aError);
+    } else {
+      aError = parser.unknownCondition(condition);
+      return false;
+    }
+    if (!valid) {
+      return false;
+    }
+  }
+  if (roulette && (rule.probability <= 0 || rule.probability > 1)) {
+    aError = "roulette rule '" + aRule + "' needs a survival probability in (0, 1]";
+    return false;
+  }
+  m_rules.push_back(std::move(rule));
+  return true;
+}
+
+bool RussianRoulettePolicy::checkRegions(std::string& aError) const {
+  for (const auto& rule : m_rules) {
+    std::string missing;
+    if (!rule.regions.check(missing)) {
+      aError = "region '" + missing + "' of a " + (rule.probability > 0 ? "roulette" : "kill") + " rule does not exist";
+      return false;
+    }
+  }
+  return true;
+}
+
+double RussianRoulettePolicy::survivalProbability(const G4Track& aTrack) const {
+  if (aTrack.GetParentID() == 0) {
+    return 1;
+  }
+  const double energy = aTrack.GetKineticEnergy();
+  const int pdg = aTrack.GetDefinition()->GetPDGEncoding();
+  for (const auto& rule : m_rules) {
+    if (!rule.pdgs.empty() && std::find(rule.pdgs.begin(), rule.pdgs.end(), pdg) == rule.pdgs.end()) {
+      continue;
+    }
+    if (energy < rule.minEnergy || (rule.maxEnergy > 0 && energy > rule.maxEnergy)) {
+      continue;
+    }
+    if (!rule.regions.empty()) {
+      // new secondaries are located in the volume of the step which created them
+      const G4VPhysicalVolume* volume = aTrack.GetVolume();
+      if (!rule.regions.contains((volume != nullptr) ? volume->GetLogicalVolume()->GetRegion() : nullptr)) {
+        continue;
+      }
+    }
+    return rule.probability;
+  }
+  return 1;
+}
+} // namespace sim
@@ -0,0 +1,117 @@
+#include "SimG4Full/RussianRouletteStackingAction.h"
+
+// FCCSW
+#include "SimG4Common/EventInformation.h"
+
+// Gaudi
+#include "GaudiKernel/MsgStream.h"
+
+// Geant4
+#include "G4EventManager.hh"
+#include "G4Step.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Track.hh"
+#include "Randomize.hh"
+
+// STL
+#include <algorithm>
+#include <cmath>
+
+namespace sim {
+void RussianRouletteSummary::countTrack(double aProbability, bool aSurvived) {
+  ++m_numMatched;
+  if (aProbability <= 0) {
+    ++m_numKilled;
+  } else if (aSurvived) {
+    ++m_numRouletteSurvived;
+  } else {
+    ++m_numRouletteKilled;
+  }
+}
+
+void RussianRouletteSummary::addDeposit(double aEnergy, double aWeight) {
+  m_eventEnergy += aEnergy;
+  m_eventWeightedEnergy += aEnergy * aWeight;
+}
+
+void RussianRouletteSummary::closeEvent() {
+  if (m_eventEnergy > 0) {
+    double difference = (m_eventWeightedEnergy - m_eventEnergy) / m_eventEnergy;
+    ++m_numEvents;
+    m_sumDifference += difference;
+    m_sumDifference2 += difference * difference;
+  }
+  m_eventEnergy = 0;
+  m_eventWeightedEnergy = 0;
+}
+
+void RussianRouletteSummary::print(MsgStream& aLog) {
+  aLog << MSG::INFO << "Russian roulette summary:" << endmsg;
+  aLog << MSG::INFO << "  Secondary tracks matched by the rules: " << m_numMatched << endmsg;
+  aLog << MSG::INFO << "  Killed: " << m_numKilled << ", killed by the roulette: " << m_numRouletteKilled
+       << ", survived the roulette: " << m_numRouletteSurvived << endmsg;
+  if (m_numEvents > 0) {
+    double mean = m_sumDifference / m_numEvents;
+    double rms = std::sqrt(std::max(m_sumDifference2 / m_numEvents - mean * mean, 0.));
+    aLog << MSG::INFO << "  Validation over " << m_numEvents
+         << " events, relative difference of the weighted to the deposited energy in sensitive volumes: mean "
+         << mean << ", RMS " << rms << endmsg;
+  }
+}
+
+RussianRouletteStackingAction::RussianRouletteStackingAction(const RussianRoulettePolicy& aPolicy, bool aValidation,
+                                                             std::shared_ptr<RussianRouletteSummary> aSummary)
+    : m_policy(aPolicy), m_validation(aValidation), m_summary(aSummary) {}
+
+G4ClassificationOfNewTrack RussianRouletteStackingAction::ClassifyNewTrack(const G4Track* aTrack) {
+  const size_t trackId = aTrack->GetTrackID();
+  const double probability = m_policy.survivalProbability(*aTrack);
+  bool survived = true;
+  if (probability < 1) {
+    survived = probability > 0 && G4UniformRand() < probability;
+    m_summary->countTrack(probability, survived);
+  }
+  if (m_validation) {
+    // the track is simulated anyway, only the weight it would have had is kept
+    if (trackId >= m_validationWeights.size()) {
+      m_validationWeights.resize(std::max(trackId + 1, 2 * m_validationWeights.size()), 1.);
+    }
+    double weight = validationWeight(aTrack->GetParentID());
+    m_validationWeights[trackId] = survived ? weight / probability : 0;
+    return fUrgent;
+  }
+  if (!survived) {
+    return fKill;
+  }
+  if (probability < 1) {
+    // the track is not modified by Geant4 before it is stacked, the weight is set here
+    const_cast<G4Track*>(aTrack)->SetWeight(aTrack->GetWeight() / probability);
+  }
+  if (aTrack->GetWeight() != 1) {
+    auto evtinfo = dynamic_cast<sim::EventInformation*>(G4EventManager::GetEventManager()->GetUserInformation());
+    if (evtinfo != nullptr) {
+      evtinfo->setTrackWeight(trackId, aTrack->GetWeight());
+    }
+  }
+  return fUrgent;
+}
+
+void RussianRouletteStackingAction::PrepareNewEvent() {
+  if (m_validation) {
+    m_summary->closeEvent();
+    m_validationWeights.clear();
+  }
+}
+
+RussianRouletteSteppingAction::RussianRouletteSteppingAction(const RussianRouletteStackingAction& aStackingAction,
+                                                             std::shared_ptr<RussianRouletteSummary> aSummary)
+    : m_stackingAction(aStackingAction), m_summary(aSummary) {}
+
+void RussianRouletteSteppingAction::UserSteppingAction(const G4Step* aStep) {
+  const double energy = aStep->GetTotalEnergyDeposit();
+  if (energy <= 0 || aStep->GetPreStepPoint()->GetSensitiveDetector() == nullptr) {
+    return;
+  }
+  m_summary->addDeposit(energy, m_stackingAction.validationWeight(aStep->GetTrack()->GetTrackID()));
+}
+} // namespace sim
@@ -0,0 +1,116 @@
+#include "SimG4Full/TruthPruningPolicy.h"
+
+// Geant4
+#include "G4LogicalVolume.hh"
+#include "G4Step.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Track.hh"
+#include "G4VProcess.hh"
+
+// STL
+#include <algorithm>
+#include <cmath>
+
+namespace sim {
+TruthPruningPolicy::TruthPruningPolicy(double aEnergyCut) : m_energyCut(aEnergyCut) {}
+
+bool TruthPruningPolicy::addRule(const std::string& aRule, std::string& aError) {
+  RuleParser parser;
+  if (!parser.parse(aRule, {"keep", "drop"}, aError)) {
+    return false;
+  }
+  Rule rule;
+  rule.keep = (parser.action() == "keep");
+  for (const auto& condition : parser.conditions()) {
+    const auto& [key, value] = condition;
+    bool valid = true;
+    if (key == "region") {
+      rule.regions.setNames(value);
+    } else if (key == "creator") {
+      rule.creators = RuleParser::splitValues(value);
+    } else if (key == "pdg") {
+      valid = parser.toIntegers(condition, rule.pdgs, aError);
+    } else if (key == "minEnergy") {
+      valid = parser.toNumber(condition, GeV, rule.minEnergy, aError);
+    } else if (key == "maxEnergy") {
+      valid = parser.toNumber(condition, GeV, rule.maxEnergy, aError);
+    } else if (key == "maxR") {
+      valid = parser.toNumber(condition, mm, rule.maxR, aError);
+    } else if (key == "maxZ") {
+      valid = parser.toNumber(condition, mm, rule.maxZ, aError);
+    } else if (key == "decayed") {
+      if (value != "true" && value != "false") {
+        aError = "value of 'decayed' in rule '" + aRule + "' must be 'true' or 'false'";
+        return false;
+      }
+      rule.decayed = (value == "true");
+    } else {
+      aError = parser.unknownCondition(condition);
+      return false;
+    }
+    if (!valid) {
+      return false;
+    }
+  }
+  m_rules.push_back(std::move(rule));
+  return true;
+}
+
+bool TruthPruningPolicy::checkRegions(std::string& aError) const {
+  for (const auto& rule : m_rules) {
+    std::string missing;
+    if (!rule.regions.check(missing)) {
+      aError = "region '" + missing + "' of a " + (rule.keep ? "keep" : "drop") + " rule does not exist";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TruthPruningPolicy::matches(const Rule& aRule, const G4Track& aTrack, double aEnergy) const {
+  // cheapest conditions first
+  if (!aRule.pdgs.empty() && std::find(aRule.pdgs.begin(), aRule.pdgs.end(),
+                                       aTrack.GetDefinition()->GetPDGEncoding()) == aRule.pdgs.end()) {
+    return false;
+  }
+  if (aEnergy < aRule.minEnergy || (aRule.maxEnergy > 0 && aEnergy > aRule.maxEnergy)) {
+    return false;
+  }
+  const G4ThreeVector& vertex = aTrack.GetVertexPosition();
+  if ((aRule.maxR > 0 && vertex.perp() > aRule.maxR) || (aRule.maxZ > 0 && std::abs(vertex.z()) > aRule.maxZ)) {
+    return false;
+  }
+  if (aRule.decayed >= 0) {
+    const G4Step* step = aTrack.GetStep();
+    const G4VProcess* endProcess = (step != nullptr) ? step->GetPostStepPoint()->GetProcessDefinedStep() : nullptr;
+    bool decayed = endProcess != nullptr && endProcess->GetProcessType() == fDecay;
+    if (decayed != (aRule.decayed == 1)) {
+      return false;
+    }
+  }
+  if (!aRule.regions.empty()) {
+    const G4LogicalVolume* volume = aTrack.GetLogicalVolumeAtVertex();
+    if (!aRule.regions.contains((volume != nullptr) ? volume->GetRegion() : nullptr)) {
+      return false;
+    }
+  }
+  if (!aRule.creators.empty()) {
+    const G4VProcess* creator = aTrack.GetCreatorProcess();
+    const std::string& creatorName = (creator != nullptr) ? creator->GetProcessName() : "primary";
+    if (std::find(aRule.creators.begin(), aRule.creators.end(), creatorName) == aRule.creators.end()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TruthPruningPolicy::keep(const G4Track& aTrack) const {
+  const double energy = aTrack.GetVertexKineticEnergy() + aTrack.GetDefinition()->GetPDGMass();
+  for (const auto& rule : m_rules) {
+    if (matches(rule, aTrack, energy)) {
+      return rule.keep;
+    }
+  }
+  return energy >= m_energyCut;
+}
+} // namespace sim
@@ -17,12 +17,17 @@ class G4VUserActionInitialization;
 class ISimG4ActionTool : virtual public IAlgTool {
 public:
   /// Retrieve interface ID
-  DeclareInterfaceID(ISimG4ActionTool, 1, 0);
+  DeclareInterfaceID(ISimG4ActionTool, 1, 1);
 
   /** get initialization hook for the user action
    *  @return  pointer to G4VUserActionInitialization
    */
   virtual G4VUserActionInitialization* userActionInitialization() = 0;
+
+  /** Check the regions used by the actions, called once all the regions are created.
+   *  @return status code
+   */
+  virtual StatusCode checkRegions() { return StatusCode::SUCCESS; }
 };
 
 #endif /* SIMG4INTERFACE_ISIMG4ACTIONTOOL_H */
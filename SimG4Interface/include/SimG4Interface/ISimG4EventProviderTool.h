@@ -4,6 +4,9 @@
 // from Gaudi
 #include "GaudiKernel/IAlgTool.h"
 
+// STL
+#include <vector>
+
 class G4Event;
 
 /** @class ISimG4EventProviderTool SimG4Interface/ISimG4EventProviderTool.h ISimG4EventProviderTool.h
@@ -16,12 +19,19 @@ class G4Event;
 
 class ISimG4EventProviderTool : virtual public IAlgTool {
 public:
-  DeclareInterfaceID(ISimG4EventProviderTool, 1, 0);
+  DeclareInterfaceID(ISimG4EventProviderTool, 1, 1);
 
   /** get initialization hook for the geometry
    *  @return pointer to the G4Event containing primary particles
    */
   virtual G4Event* g4Event() = 0;
+
+  /** Split the primaries of the event into sub-events simulated separately (e.g. for very high multiplicity events).
+   *  By default the event is not split.
+   *  @param[in] aMaxSubEvents Maximum number of sub-events.
+   *  @return pointers to the G4Events containing the primary particles (ownership is transferred to the caller)
+   */
+  virtual std::vector<G4Event*> g4SubEvents(size_t /*aMaxSubEvents*/) { return {g4Event()}; }
 };
 
 #endif /* SIMG4INTERFACE_ISIMG4EVENTPROVIDERTOOL_H */
@@ -1,6 +1,9 @@
 #ifndef SIMG4INTERFACE_ISIMG4PARTICLESMEARTOOL_H
 #define SIMG4INTERFACE_ISIMG4PARTICLESMEARTOOL_H
 
+// STL
+#include <span>
+
 // Gaudi
 #include "GaudiKernel/IAlgTool.h"
 
@@ -19,7 +22,7 @@ class Hep3Vector;
 
 class ISimG4ParticleSmearTool : virtual public IAlgTool {
 public:
-  DeclareInterfaceID(ISimG4ParticleSmearTool, 1, 0);
+  DeclareInterfaceID(ISimG4ParticleSmearTool, 1, 2);
 
   /**  Smear the momentum of the particle
    *   @param aMom Particle momentum to be smeared.
@@ -28,6 +31,24 @@ public:
    */
   virtual StatusCode smearMomentum(CLHEP::Hep3Vector& aMom, int aPdg = 0) = 0;
 
+  /**  Smear the momenta of many particles at once, in place
+   *   @param aMom Particle momenta to be smeared.
+   *   @param[in] aPdg Particle PDG codes, either empty or of the same size as aMom.
+   *   @return status code
+   */
+  virtual StatusCode smearMomenta(std::span<CLHEP::Hep3Vector> aMom, std::span<const int> aPdg = {}) = 0;
+
+  /**  Smear the track parameters of the particle: momentum and, if the tool provides it, the production vertex
+   *   (impact parameters). By default only the momentum is smeared.
+   *   @param aVertex Particle production vertex to be smeared.
+   *   @param aMom Particle momentum to be smeared.
+   *   @param[in] aPdg Particle PDG code.
+   *   @return status code
+   */
+  virtual StatusCode smearTrack(CLHEP::Hep3Vector& /*aVertex*/, CLHEP::Hep3Vector& aMom, int aPdg = 0) {
+    return smearMomentum(aMom, aPdg);
+  }
+
   /**  Check conditions of the smearing model, especially if the given parameters do not exceed the parameters of the
    * model.
    *   @param[in] aMinMomentum Minimum momentum.
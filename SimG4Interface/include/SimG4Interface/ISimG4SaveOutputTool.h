@@ -16,12 +16,29 @@ class G4Event;
 
 class ISimG4SaveOutputTool : virtual public IAlgTool {
 public:
-  DeclareInterfaceID(ISimG4SaveOutputTool, 1, 0);
+  DeclareInterfaceID(ISimG4SaveOutputTool, 1, 1);
 
   /**  Save the data output.
    *   @param[in] aEvent Event with data to save.
    *   @return status code
    */
   virtual StatusCode saveOutput(const G4Event& aEvent) = 0;
+
+  /**  Check if the tool can merge the output of the sub-events of a split event.
+   *   @return true if saveSubEventOutput is implemented
+   */
+  virtual bool mergesSubEvents() const { return false; }
+
+  /**  Save the data output of a sub-event, when the event is split into sub-events simulated separately.
+   *   The first sub-event creates the output, the next ones are merged into it.
+   *   @param[in] aEvent Sub-event with data to save.
+   *   @param[in] aSubEvent Index of the sub-event.
+   *   @param[in] aTrackIdOffset Offset added to the Geant4 track IDs of the sub-event,
+   *                             to keep them unique in the event.
+   *   @return status code
+   */
+  virtual StatusCode saveSubEventOutput(const G4Event& aEvent, size_t aSubEvent, int aTrackIdOffset) {
+    return (aSubEvent == 0 && aTrackIdOffset == 0) ? saveOutput(aEvent) : StatusCode::FAILURE;
+  }
 };
 #endif /* SIMG4INTERFACE_ISIMG4SAVEOUTPUTTOOL_H */
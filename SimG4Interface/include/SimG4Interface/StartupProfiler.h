@@ -0,0 +1,215 @@
+#ifndef SIMG4INTERFACE_STARTUPPROFILER_H
+#define SIMG4INTERFACE_STARTUPPROFILER_H
+
+// Gaudi
+#include "GaudiKernel/Kernel.h"
+
+// STL
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+/** @class sim::StartupProfiler SimG4Interface/SimG4Interface/StartupProfiler.h StartupProfiler.h
+ *
+ *  Process-wide record of the initialisation phases of the geometry and simulation services.
+ *  Each phase is measured by a sim::StartupProfiler::Phase object, from its construction to its destruction:
+ *  wall-clock time, CPU time of the process, and resident memory (RSS) before and after the phase together with the
+ *  peak RSS of the process. Phases may be nested (e.g. the geometry conversion within the run manager
+ *  initialisation), their depth is recorded. The phases are written as a JSON document.
+ *  The memory is read from /proc/self (0 where not available).
+ *  Header-only, so that the geometry service can use it without depending on the simulation libraries. The
+ *  instance is exported, so that all the libraries of the process share it.
+ */
+
+namespace sim {
+class GAUDI_API StartupProfiler {
+public:
+  /// Measurement of one phase
+  struct Record {
+    /// Component (service or class) running the phase
+    std::string component;
+    /// Name of the phase
+    std::string phase;
+    /// Nesting depth, 0 for the top-level phases
+    unsigned int depth = 0;
+    /// Wall-clock time (s)
+    double wallTime = 0;
+    /// CPU time of the process (s)
+    double cpuTime = 0;
+    /// Resident memory at the start of the phase (MB)
+    double rssBefore = 0;
+    /// Resident memory at the end of the phase (MB)
+    double rssAfter = 0;
+    /// Peak resident memory of the process at the end of the phase (MB)
+    double peakRss = 0;
+  };
+
+  /** @class sim::StartupProfiler::Phase
+   *  Measures a phase from its construction to its destruction (or to the call of stop()).
+   */
+  class Phase {
+  public:
+    /** Start measuring the phase.
+     *  @param[in] aComponent Component running the phase.
+     *  @param[in] aPhase Name of the phase.
+     */
+    Phase(const std::string& aComponent, const std::string& aPhase) {
+      StartupProfiler& profiler = StartupProfiler::instance();
+      Record record;
+      record.component = aComponent;
+      record.phase = aPhase;
+      record.rssBefore = residentMemory();
+      {
+        std::lock_guard<std::mutex> lock(profiler.m_mutex);
+        record.depth = profiler.m_openPhases++;
+        m_index = profiler.m_records.size();
+        profiler.m_records.push_back(record);
+      }
+      m_startCpu = std::clock();
+      m_startWall = std::chrono::steady_clock::now();
+    }
+    /// Stop measuring, if not already stopped
+    ~Phase() { stop(); }
+    Phase(const Phase&) = delete;
+    Phase& operator=(const Phase&) = delete;
+    /// Stop measuring and record the phase
+    void stop() {
+      if (m_stopped) {
+        return;
+      }
+      m_stopped = true;
+      double wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_startWall).count();
+      double cpuTime = static_cast<double>(std::clock() - m_startCpu) / CLOCKS_PER_SEC;
+      double rss = residentMemory();
+      double peakRss = peakResidentMemory();
+      StartupProfiler& profiler = StartupProfiler::instance();
+      std::lock_guard<std::mutex> lock(profiler.m_mutex);
+      Record& record = profiler.m_records[m_index];
+      record.wallTime = wallTime;
+      record.cpuTime = cpuTime;
+      record.rssAfter = rss;
+      record.peakRss = peakRss;
+      --profiler.m_openPhases;
+    }
+
+  private:
+    /// Index of the record of the phase
+    size_t m_index;
+    /// Wall-clock time at the start
+    std::chrono::steady_clock::time_point m_startWall;
+    /// CPU time at the start
+    std::clock_t m_startCpu;
+    /// Flag set once the phase is recorded
+    bool m_stopped = false;
+  };
+
+  /// Get the profiler of the process
+  static StartupProfiler& instance() {
+    static StartupProfiler profiler;
+    return profiler;
+  }
+  /** Write the recorded phases as a JSON document (on a single line).
+   *  @param[in] aComponent Only the phases of this component are written (all if empty).
+   *  @return JSON document
+   */
+  std::string json(const std::string& aComponent = "") const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3);
+    out << "{\"phases\": [";
+    double totalWallTime = 0;
+    double totalCpuTime = 0;
+    double peakRss = 0;
+    // phases nested in the outermost selected ones are already included in them
+    unsigned int topDepth = ~0u;
+    for (const auto& record : m_records) {
+      if (aComponent.empty() || record.component == aComponent) {
+        topDepth = std::min(topDepth, record.depth);
+      }
+    }
+    bool first = true;
+    for (const auto& record : m_records) {
+      if (!aComponent.empty() && record.component != aComponent) {
+        continue;
+      }
+      out << (first ? "" : ", ") << "{\"component\": \"" << escape(record.component) << "\", \"phase\": \""
+          << escape(record.phase) << "\", \"depth\": " << record.depth << ", \"wallTime\": " << record.wallTime
+          << ", \"cpuTime\": " << record.cpuTime << ", \"rssBefore\": " << record.rssBefore
+          << ", \"rssAfter\": " << record.rssAfter << ", \"rssDelta\": " << record.rssAfter - record.rssBefore
+          << ", \"peakRss\": " << record.peakRss << "}";
+      first = false;
+      if (record.depth == topDepth) {
+        totalWallTime += record.wallTime;
+        totalCpuTime += record.cpuTime;
+      }
+      peakRss = std::max(peakRss, record.peakRss);
+    }
+    out << "], \"totalWallTime\": " << totalWallTime << ", \"totalCpuTime\": " << totalCpuTime
+        << ", \"peakRss\": " << peakRss << ", \"units\": {\"time\": \"s\", \"memory\": \"MB\"}}";
+    return out.str();
+  }
+  /** Write the recorded phases as a JSON document to a file.
+   *  @param[in] aFileName Name of the file.
+   *  @return false if the file could not be written
+   */
+  bool writeJson(const std::string& aFileName) const {
+    std::ofstream out(aFileName);
+    out << json() << std::endl;
+    return static_cast<bool>(out);
+  }
+  /// Current resident memory of the process (MB)
+  static double residentMemory() {
+    // second field of statm: resident pages
+    std::ifstream statm("/proc/self/statm");
+    long pages = 0, residentPages = 0;
+    if (!(statm >> pages >> residentPages)) {
+      return 0;
+    }
+    return static_cast<double>(residentPages) * ::sysconf(_SC_PAGESIZE) / (1024. * 1024.);
+  }
+  /// Peak resident memory of the process (MB)
+  static double peakResidentMemory() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+      if (line.compare(0, 6, "VmHWM:") == 0) {
+        // value in kB
+        return std::stod(line.substr(6)) / 1024.;
+      }
+    }
+    return 0;
+  }
+
+private:
+  StartupProfiler() = default;
+  /// Escape the string for JSON
+  static std::string escape(const std::string& aText) {
+    std::ostringstream out;
+    for (char c : aText) {
+      if (c == '"' || c == '\\') {
+        out << '\\' << c;
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+      } else {
+        out << c;
+      }
+    }
+    return out.str();
+  }
+  /// Guards the records
+  mutable std::mutex m_mutex;
+  /// Recorded phases, in the order of their start
+  std::vector<Record> m_records;
+  /// Number of phases currently measured, the depth of a new phase
+  unsigned int m_openPhases = 0;
+};
+} // namespace sim
+
+#endif /* SIMG4INTERFACE_STARTUPPROFILER_H */